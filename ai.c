@@ -0,0 +1,635 @@
+/******************************************************************************
+ * File:---- ai.c                                                             *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the "ai" move source: a negamax search with           *
+ *           alpha-beta pruning and iterative deepening, which keeps going    *
+ *           one ply deeper until its time budget for the move runs out.      *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai.h"
+#include "timer.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * The parts of the search, only used by aiMove                               *
+ ******************************************************************************/
+static void _set_up( AiState*, Settings* );
+static long _full_eval( AiState*, GameBoard* );
+static long _window_value( AiState*, unsigned char* );
+static int  _search_root( AiState*, GameBoard*, TicTacTile, int, long* );
+static long _negamax( AiState*, GameBoard*, TicTacTile, int, long, long, int,
+    int );
+static long _search_move( AiState*, GameBoard*, TicTacTile, int, int, long,
+    long, int, int );
+static BOOL _probe( AiState*, GameBoard*, int, long, long, int, long*,
+    int* );
+static void _store( AiState*, GameBoard*, int, long, TableBound, int );
+static long _to_table( long, int );
+static long _from_table( long, int );
+static void _move_first( AiState*, int, int, int );
+static int  _candidates( AiState*, GameBoard*, int );
+
+
+/******************************************************************************
+ * Function: createAi                                                         *
+ * Imports: budget - the time allowed for each move, in milliseconds          *
+ * Returns: pointer to a new AiState                                          *
+ * Purpose: allocates the state of an "ai" move source. The move stack, the   *
+ *          weights and the transposition table are set up on the first move, *
+ *          once the settings are known.                                      *
+ ******************************************************************************/
+AiState *createAi( int budget )
+{
+    AiState *ai;
+
+    ai = (AiState*) calloc( sizeof(AiState), 1 );
+    ai->budget = budget;
+
+    return ai;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteAi                                                         *
+ * Imports: pointer to an AiState                                             *
+ * Exports: none                                                              *
+ * Purpose: frees the AiState, its move stack and its transposition table     *
+ ******************************************************************************/
+void deleteAi( void *state )
+{
+    AiState *ai;
+
+    ai = (AiState*) state;
+    if ( ai->table != NULL )
+    {
+        deleteTable( ai->table );
+    }
+    free( ai->moves );
+    free( ai );
+}
+
+
+
+/******************************************************************************
+ * Function: aiMove                                                           *
+ * Imports: pointer to the game board, player to move, AiState                *
+ * Returns: the coordinates of the chosen cell                                *
+ * Purpose: searches 1, 2, 3... plies ahead until the budget is used up, the  *
+ *          result of the game is proven or every remaining move is searched. *
+ *          A search that runs out of time keeps its best move, as the best   *
+ *          move of the previous depth is always searched first.              *
+ *          An empty board has no tiles to search near, so the centre cell is *
+ *          played straight away.                                             *
+ ******************************************************************************/
+Coordinates aiMove( GameBoard *board, TicTacTile player, void *state )
+{
+    AiState *ai;
+    Coordinates move;
+    double start;
+    long score;
+    int depth, cell, best, area;
+    BOOL finished;
+
+    ai = (AiState*) state;
+    start = wallTime( );
+    ai->deadline = start + ai->budget / 1000.0;
+    ai->stopped = FALSE;
+    ai->nodes = 0;
+    ai->depth = 0;
+    ai->score = 0;
+
+    area = board->settings->width * board->settings->height;
+    _set_up( ai, board->settings );
+    ai->eval = _full_eval( ai, board );
+
+    best = ( board->settings->height / 2 ) * board->settings->width +
+        board->settings->width / 2;
+    finished = board->emptyCount == area;
+    depth = 1;
+    while ( !finished )
+    {
+        cell = _search_root( ai, board, player, depth, &score );
+
+        /* -1 means time ran out before a single move was searched */
+        if ( cell >= 0 )
+        {
+            best = cell;
+            ai->score = score;
+        }
+        if ( !ai->stopped )
+        {
+            ai->depth = depth;
+        }
+
+        /* the next depth takes several times longer than this one did */
+        finished = ai->stopped || depth >= board->emptyCount ||
+            score >= AI_WIN - area || score <= -AI_WIN + area ||
+            wallTime( ) - start > ai->budget / 2000.0;
+        depth++;
+    }
+
+    move.x = best % board->settings->width;
+    move.y = best / board->settings->width;
+
+    ai->seconds = wallTime( ) - start;
+    ai->totalNodes += ai->nodes;
+    ai->totalSeconds += ai->seconds;
+    ai->table->age++;
+
+    return move;
+}
+
+
+
+/******************************************************************************
+ * Function: printAiStats                                                     *
+ * Imports: output stream, AiState                                            *
+ * Exports: none                                                              *
+ * Purpose: prints how deep the last search went and how fast it ran, along   *
+ *          with the throughput over every move made so far.                  *
+ ******************************************************************************/
+void printAiStats( FILE *stream, void *state )
+{
+    AiState *ai;
+
+    ai = (AiState*) state;
+    fprintf( stream, "Searched %d plies, %ld nodes in %.1f ms "
+        "(%.0f nodes/sec, %.0f over the game)\n",
+        ai->depth, ai->nodes, ai->seconds * 1000.0,
+        ai->seconds > 0.0 ? ai->nodes / ai->seconds : 0.0,
+        ai->totalSeconds > 0.0 ? ai->totalNodes / ai->totalSeconds : 0.0 );
+    printTableStats( stream, ai->table );
+}
+
+
+
+/******************************************************************************
+ * Function: _set_up                                                          *
+ * Imports: AiState, the settings of the board about to be searched           *
+ * Exports: the weights and transposition table of the AiState                *
+ * Purpose: works out the window weights for K and creates the table at the   *
+ *          size in the settings. Stored results only hold for one board      *
+ *          size and K, so the table is emptied when either changes.          *
+ *          A window one tile short of a win is worth 2^40, and every missing *
+ *          tile after that divides its worth by 16. Empty windows and        *
+ *          windows with tiles of both players are worth nothing.             *
+ ******************************************************************************/
+static void _set_up( AiState *ai, Settings *settings )
+{
+    int count, shift, matches;
+
+    if ( ai->table != NULL && ai->settings.tableSize != settings->tableSize )
+    {
+        deleteTable( ai->table );
+        ai->table = NULL;
+    }
+
+    if ( ai->table == NULL )
+    {
+        ai->table = createTable( settings->tableSize );
+    }
+    else if ( ai->settings.width != settings->width ||
+        ai->settings.height != settings->height ||
+        ai->settings.matches != settings->matches )
+    {
+        clearTable( ai->table );
+    }
+
+    matches = settings->matches;
+    ai->weights[0] = 0;
+    ai->weights[matches] = 0;
+    for ( count = 1; count < matches; count++ )
+    {
+        shift = 40 - 4 * ( matches - 1 - count );
+        ai->weights[count] = 1L << ( shift > 0 ? shift : 0 );
+    }
+
+    ai->settings = *settings;
+}
+
+
+
+/******************************************************************************
+ * Function: _full_eval                                                       *
+ * Imports: AiState, pointer to the game board                                *
+ * Returns: the sum of the scores of every window on the board                *
+ * Purpose: works out the evaluation from scratch at the start of a move,     *
+ *          scanning the whole lineCounts array.                              *
+ ******************************************************************************/
+static long _full_eval( AiState *ai, GameBoard *board )
+{
+    long eval;
+    int i;
+
+    eval = 0;
+    for ( i = 0; i < board->numWindows; i++ )
+    {
+        eval += _window_value( ai, board->lineCounts + i * WINDOW_PLAYERS );
+    }
+
+    return eval;
+}
+
+
+
+/******************************************************************************
+ * Function: _window_value                                                    *
+ * Imports: AiState, the lineCounts entries of a window                       *
+ * Returns: the score of the window, positive if it favours X                 *
+ ******************************************************************************/
+static long _window_value( AiState *ai, unsigned char *counts )
+{
+    long value;
+
+    value = 0;
+    if ( counts[TicTacO - 1] == 0 )
+    {
+        value = ai->weights[counts[TicTacX - 1]];
+    }
+    else if ( counts[TicTacX - 1] == 0 )
+    {
+        value = -ai->weights[counts[TicTacO - 1]];
+    }
+
+    return value;
+}
+
+
+
+/******************************************************************************
+ * Function: _search_root                                                     *
+ * Imports: AiState, pointer to the game board, player to move,               *
+ *          depth of the search in plies                                      *
+ * Returns: the best cell found, -1 if time ran out before any was searched   *
+ * Exports: score - the score of the best cell                                *
+ * Purpose: searches every candidate move to the given depth. The best move   *
+ *          of the previous depth is kept at the front of the move stack      *
+ *          between calls, so it is searched first.                           *
+ ******************************************************************************/
+static int _search_root( AiState *ai, GameBoard *board, TicTacTile player,
+    int depth, long *score )
+{
+    long alpha, value;
+    int count, i, best, previous;
+
+    previous = ai->depth > 0 ? ai->moves[0] : -1;
+    count = _candidates( ai, board, 0 );
+    _move_first( ai, 0, count, previous );
+
+    best = -1;
+    alpha = -AI_WIN - 1;
+    i = 0;
+    while ( !ai->stopped && i < count )
+    {
+        value = _search_move( ai, board, player, ai->moves[i], depth,
+            alpha, AI_WIN + 1, 1, count );
+        if ( !ai->stopped && value > alpha )
+        {
+            alpha = value;
+            best = i;
+        }
+        i++;
+    }
+
+    /* keep the best move at the front for the next depth */
+    if ( best > 0 )
+    {
+        _move_first( ai, 0, count, ai->moves[best] );
+    }
+    *score = alpha;
+
+    return best >= 0 ? ai->moves[0] : -1;
+}
+
+
+
+/******************************************************************************
+ * Function: _negamax                                                         *
+ * Imports: AiState, pointer to the game board, player to move,               *
+ *          remaining depth, alpha and beta bounds, ply from the root,        *
+ *          top of the move stack                                             *
+ * Returns: the score of the position for the player to move                  *
+ * Purpose: the alpha-beta search. Positions at depth 0 are scored from the   *
+ *          windows on the board. The clock is read every AI_CHECK_NODES + 1  *
+ *          nodes; once time runs out every search returns straight away and  *
+ *          its result is thrown away.                                        *
+ *          Every finished search is stored in the transposition table, with  *
+ *          its best move unless no move reached alpha.                       *
+ ******************************************************************************/
+static long _negamax( AiState *ai, GameBoard *board, TicTacTile player,
+    int depth, long alpha, long beta, int ply, int top )
+{
+    TableBound bound;
+    long best, value, start;
+    int count, i, move;
+
+    ai->nodes++;
+    if ( ( ai->nodes & AI_CHECK_NODES ) == 0 && wallTime( ) > ai->deadline )
+    {
+        ai->stopped = TRUE;
+    }
+
+    move = -1;
+    if ( depth == 0 || ai->stopped )
+    {
+        best = player == TicTacX ? ai->eval : -ai->eval;
+    }
+    else if ( !_probe( ai, board, depth, alpha, beta, ply, &best, &move ) )
+    {
+        count = _candidates( ai, board, top );
+        _move_first( ai, top, count, move );
+
+        start = alpha;
+        best = -AI_WIN;
+        i = 0;
+        while ( !ai->stopped && i < count && alpha < beta )
+        {
+            value = _search_move( ai, board, player, ai->moves[top + i],
+                depth, alpha, beta, ply, top + count );
+            if ( value > best )
+            {
+                best = value;
+                move = ai->moves[top + i];
+            }
+            if ( value > alpha )
+            {
+                alpha = value;
+            }
+            i++;
+        }
+
+        if ( !ai->stopped )
+        {
+            bound = best <= start ? TableUpper :
+                best >= beta ? TableLower : TableExact;
+            _store( ai, board, depth, _to_table( best, ply ), bound,
+                bound == TableUpper ? -1 : move );
+        }
+    }
+
+    return best;
+}
+
+
+
+/******************************************************************************
+ * Function: _probe                                                           *
+ * Imports: AiState, pointer to the game board, remaining depth, alpha and    *
+ *          beta bounds, ply from the root                                    *
+ * Returns: TRUE if the stored result settles the position, FALSE otherwise   *
+ * Exports: score - the stored score, if the position is settled              *
+ *          move - the stored best move, -1 if there is none                  *
+ * Purpose: looks the position up in the transposition table. A result that   *
+ *          was searched at least as deep settles the position if its score   *
+ *          is exact or its bound falls outside the alpha-beta window.        *
+ *          Otherwise its best move is still worth trying first.              *
+ *          Positions are keyed on their canonical hash, so a result stored   *
+ *          for any reflection or turn of the board is found as well. Its     *
+ *          move is turned back to fit this board.                            *
+ ******************************************************************************/
+static BOOL _probe( AiState *ai, GameBoard *board, int depth, long alpha,
+    long beta, int ply, long *score, int *move )
+{
+    TableEntry *entry;
+    unsigned long key;
+    int symmetry;
+    BOOL settled;
+
+    settled = FALSE;
+    symmetry = canonicalHash( board, &key );
+    entry = tableProbe( ai->table, key );
+    if ( entry != NULL )
+    {
+        if ( entry->move >= 0 )
+        {
+            *move = board->inverse[symmetry * board->settings->width *
+                board->settings->height + entry->move];
+        }
+        if ( entry->depth >= depth )
+        {
+            *score = _from_table( entry->score, ply );
+            settled = entry->bound == TableExact ||
+                ( entry->bound == TableLower && *score >= beta ) ||
+                ( entry->bound == TableUpper && *score <= alpha );
+        }
+    }
+
+    return settled;
+}
+
+
+
+/******************************************************************************
+ * Function: _store                                                           *
+ * Imports: AiState, pointer to the game board, depth searched, score as it   *
+ *          is stored, bound of the score, best move or -1                    *
+ * Exports: stores the result in the transposition table                      *
+ * Purpose: the counterpart of _probe, which stores the result under the      *
+ *          canonical hash with the move turned to fit the canonical board.   *
+ ******************************************************************************/
+static void _store( AiState *ai, GameBoard *board, int depth, long score,
+    TableBound bound, int move )
+{
+    unsigned long key;
+    int symmetry;
+
+    symmetry = canonicalHash( board, &key );
+    if ( move >= 0 )
+    {
+        move = board->symmetry[symmetry * board->settings->width *
+            board->settings->height + move];
+    }
+    tableStore( ai->table, key, depth, score, bound, move );
+}
+
+
+
+/******************************************************************************
+ * Function: _to_table                                                        *
+ * Imports: a score, the ply of the position it belongs to                    *
+ * Returns: the score as it is stored in the transposition table              *
+ * Purpose: win scores count down from the root, but a position can be        *
+ *          reached at different plies, so stored win scores count from the   *
+ *          position itself instead.                                          *
+ ******************************************************************************/
+static long _to_table( long score, int ply )
+{
+    if ( score > AI_WIN / 2 )
+    {
+        score += ply;
+    }
+    else if ( score < -AI_WIN / 2 )
+    {
+        score -= ply;
+    }
+
+    return score;
+}
+
+
+
+/******************************************************************************
+ * Function: _from_table                                                      *
+ * Imports: a stored score, the ply of the position it is read at             *
+ * Returns: the score counted from the root again, see _to_table              *
+ ******************************************************************************/
+static long _from_table( long score, int ply )
+{
+    if ( score > AI_WIN / 2 )
+    {
+        score -= ply;
+    }
+    else if ( score < -AI_WIN / 2 )
+    {
+        score += ply;
+    }
+
+    return score;
+}
+
+
+
+/******************************************************************************
+ * Function: _move_first                                                      *
+ * Imports: AiState, the start and length of a list on the move stack, a cell *
+ * Exports: swaps the cell to the front of the list if it is in the list      *
+ ******************************************************************************/
+static void _move_first( AiState *ai, int top, int count, int cell )
+{
+    int i;
+
+    for ( i = 1; i < count; i++ )
+    {
+        if ( ai->moves[top + i] == cell )
+        {
+            ai->moves[top + i] = ai->moves[top];
+            ai->moves[top] = cell;
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _search_move                                                     *
+ * Imports: AiState, pointer to the game board, player to move, cell to play, *
+ *          remaining depth, alpha and beta bounds, ply of the move,          *
+ *          top of the move stack                                             *
+ * Returns: the score of the move for the player making it                    *
+ * Purpose: plays the move, scores it as a win or a draw if it ends the game  *
+ *          or searches the reply otherwise, then takes the move back.        *
+ *          The windows through the cell are rescored before and after the    *
+ *          tile is placed to keep eval up to date.                           *
+ ******************************************************************************/
+static long _search_move( AiState *ai, GameBoard *board, TicTacTile player,
+    int cell, int depth, long alpha, long beta, int ply, int top )
+{
+    unsigned char *windows[NUM_DIRECTIONS * DENSE_DIMENSION];
+    Coordinates last;
+    TicTacTile opponent;
+    long value, eval;
+    int x, y, count, i;
+
+    x = cell % board->settings->width;
+    y = cell / board->settings->width;
+    last = board->lastMove;
+    eval = ai->eval;
+
+    count = cellWindows( board, x, y, windows );
+    for ( i = 0; i < count; i++ )
+    {
+        ai->eval -= _window_value( ai, windows[i] );
+    }
+    placeTile( board, player, x, y );
+    for ( i = 0; i < count; i++ )
+    {
+        ai->eval += _window_value( ai, windows[i] );
+    }
+
+    if ( checkWin( board, player, x, y ) )
+    {
+        value = AI_WIN - ply;
+    }
+    else if ( checkDraw( board ) )
+    {
+        value = 0;
+    }
+    else
+    {
+        opponent = player;
+        changePlayer( &opponent );
+        value = -_negamax( ai, board, opponent, depth - 1, -beta, -alpha,
+            ply + 1, top );
+    }
+
+    removeTile( board, x, y );
+    board->lastMove = last;
+    ai->eval = eval;
+
+    return value;
+}
+
+
+
+/******************************************************************************
+ * Function: _candidates                                                      *
+ * Imports: AiState, pointer to the game board, top of the move stack         *
+ * Returns: the number of candidate moves                                     *
+ * Exports: the candidate cells, pushed onto the move stack at top            *
+ * Purpose: lists the empty cells within AI_REACH of a tile, nearest to the   *
+ *          last move first. Moves next to the last tile are the most likely  *
+ *          to block a threat or extend a line, so they cause early cutoffs.  *
+ *          The cells come from nearCells, in row order, and are sorted by    *
+ *          distance with a counting sort through the space above them on     *
+ *          the move stack.                                                   *
+ ******************************************************************************/
+static int _candidates( AiState *ai, GameBoard *board, int top )
+{
+    int buckets[DENSE_DIMENSION + 1];
+    int *found;
+    int width, height, count, x, dx, dy, i;
+
+    width = board->settings->width;
+    height = board->settings->height;
+
+    /* every ply takes at most area cells, plus area for sorting */
+    if ( ai->capacity < top + 2 * width * height )
+    {
+        ai->capacity = 2 * ( top + 2 * width * height );
+        ai->moves = (int*) realloc( ai->moves, ai->capacity * sizeof(int) );
+    }
+
+    found = ai->moves + top + width * height;
+    count = nearCells( board, AI_REACH, found );
+
+    memset( buckets, 0, sizeof(buckets) );
+    for ( i = 0; i < count; i++ )
+    {
+        dx = abs( found[i] % width - board->lastMove.x );
+        dy = abs( found[i] / width - board->lastMove.y );
+        buckets[dx > dy ? dx : dy]++;
+    }
+
+    /* turn the bucket sizes into start positions, then place each cell */
+    for ( i = 1; i <= DENSE_DIMENSION; i++ )
+    {
+        buckets[i] += buckets[i - 1];
+    }
+    for ( i = count - 1; i >= 0; i-- )
+    {
+        x = found[i];
+        dx = abs( x % width - board->lastMove.x );
+        dy = abs( x / width - board->lastMove.y );
+        buckets[dx > dy ? dx : dy]--;
+        ai->moves[top + buckets[dx > dy ? dx : dy]] = x;
+    }
+
+    return count;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * File:---- ai.h                                                             *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the state of the "ai" move source, a game tree search    *
+ *           that plays against the user or other move sources.               *
+ *           Declares the functions that create, run and report on it.        *
+ ******************************************************************************/
+
+#ifndef AI_H
+#define AI_H
+
+#include <stdio.h>
+#include "game.h"
+#include "table.h"
+
+
+/******************************************************************************
+ * AI_WIN: the score of a won position. Wins found closer to the root score   *
+ *         higher, so the search prefers the fastest win and slowest loss.    *
+ *         Window scores add up to less than 2^56, far below this value.      *
+ * AI_REACH: empty cells further than this from every tile are not searched   *
+ * AI_CHECK_NODES: the clock is read once every AI_CHECK_NODES + 1 nodes      *
+ ******************************************************************************/
+#define AI_WIN ( 1L << 62 )
+#define AI_REACH 2
+#define AI_CHECK_NODES 1023
+
+
+
+/******************************************************************************
+ * AiState: the state of an "ai" move source.                                 *
+ * Consists of:                                                               *
+ *     budget - the time allowed for each move, in milliseconds               *
+ *     deadline - the wall time at which the current search has to stop       *
+ *     stopped - TRUE once the deadline has passed during a search            *
+ *     nodes - the number of positions visited for the last move              *
+ *     depth - the deepest search completed for the last move, in plies       *
+ *     seconds - the time taken to choose the last move                       *
+ *     score - the score of the last move, from the source's point of view    *
+ *     totalNodes, totalSeconds - the same over all moves made so far         *
+ *     settings - a copy of the settings the weights and table were set up    *
+ *                for, so that both can be redone if the settings change      *
+ *     weights - the score of a window with that many tiles of one player     *
+ *               and none of the other, indexed by tile count                 *
+ *     eval - the sum of all window scores, positive when X is ahead          *
+ *     moves - a stack of candidate cells (y * width + x), one list per ply   *
+ *     capacity - the number of cells the move stack has room for             *
+ *     table - the transposition table, kept from move to move so that later  *
+ *             searches reuse the results of earlier ones                     *
+ * Notes: the search plays moves on the board it is given and takes them back *
+ *        afterwards, so no board is ever copied. eval is kept up to date     *
+ *        from the windows that pass through each played cell.                *
+ ******************************************************************************/
+typedef struct
+{
+    int budget;
+    double deadline;
+    BOOL stopped;
+    long nodes;
+    int depth;
+    double seconds;
+    long score;
+    long totalNodes;
+    double totalSeconds;
+    Settings settings;
+    long weights[DENSE_DIMENSION + 1];
+    long eval;
+    int *moves;
+    int capacity;
+    TransTable *table;
+} AiState;
+
+
+
+/* Function Prototypes */
+AiState *createAi( int );
+void deleteAi( void* );
+Coordinates aiMove( GameBoard*, TicTacTile, void* );
+void printAiStats( FILE*, void* );
+
+#endif
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * File:---- arena.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the arena allocator declared in arena.h               *
+ ******************************************************************************/
+#include <stdlib.h>
+
+#include "arena.h"
+
+
+/******************************************************************************
+ * ARENA_HEADER: the size of a block header, rounded up to ARENA_ALIGN so     *
+ *               that the memory after it is aligned                          *
+ * ARENA_ROUND: rounds a size up to a multiple of ARENA_ALIGN                 *
+ ******************************************************************************/
+#define ARENA_ROUND( size ) \
+    ( ( (size) + ARENA_ALIGN - 1 ) / ARENA_ALIGN * ARENA_ALIGN )
+#define ARENA_HEADER ARENA_ROUND( sizeof(ArenaBlock) )
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Block allocation, only used by the arena functions                         *
+ ******************************************************************************/
+static ArenaBlock *_new_block( size_t );
+
+
+/******************************************************************************
+ * Function: createArena                                                      *
+ * Imports: blockSize - the size of each block in bytes                       *
+ * Returns: pointer to a new, empty arena                                     *
+ * Purpose: allocates the arena along with its first block.                   *
+ ******************************************************************************/
+Arena *createArena( size_t blockSize )
+{
+    Arena *arena;
+
+    arena = (Arena*) malloc( sizeof(Arena) );
+    arena->blockSize = ARENA_ROUND( blockSize );
+    arena->first = _new_block( arena->blockSize );
+    arena->current = arena->first;
+
+    return arena;
+}
+
+
+
+/******************************************************************************
+ * Function: arenaAlloc                                                       *
+ * Imports: pointer to an arena, number of bytes needed                       *
+ * Returns: pointer to the memory, aligned to ARENA_ALIGN                     *
+ * Purpose: bumps the offset of the current block. Once it is full, moves on  *
+ *          to the next block left over from before the last reset, or adds   *
+ *          a new block after the current one if that is too small.           *
+ *          The memory is not cleared.                                        *
+ ******************************************************************************/
+void *arenaAlloc( Arena *arena, size_t size )
+{
+    ArenaBlock *block;
+    void *memory;
+
+    size = ARENA_ROUND( size );
+    block = arena->current;
+    if ( block->used + size > block->size )
+    {
+        if ( block->next != NULL && block->next->size >= size )
+        {
+            block = block->next;
+        }
+        else
+        {
+            block = _new_block( size > arena->blockSize ?
+                size : arena->blockSize );
+            block->next = arena->current->next;
+            arena->current->next = block;
+        }
+
+        /* a block reached again after a reset still has its old offset */
+        block->used = 0;
+        arena->current = block;
+    }
+
+    memory = (char*) block + ARENA_HEADER + block->used;
+    block->used += size;
+
+    return memory;
+}
+
+
+
+/******************************************************************************
+ * Function: arenaReset                                                       *
+ * Imports: pointer to an arena                                               *
+ * Exports: every allocation made from the arena is given back                *
+ * Purpose: frees everything in constant time by moving back to the start of  *
+ *          the first block. Later blocks are reset as they are reached.      *
+ ******************************************************************************/
+void arenaReset( Arena *arena )
+{
+    arena->first->used = 0;
+    arena->current = arena->first;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteArena                                                      *
+ * Imports: pointer to an arena                                               *
+ * Exports: none                                                              *
+ * Purpose: frees every block of the arena and the arena itself               *
+ ******************************************************************************/
+void deleteArena( Arena *arena )
+{
+    ArenaBlock *block, *next;
+
+    block = arena->first;
+    while ( block != NULL )
+    {
+        next = block->next;
+        free( block );
+        block = next;
+    }
+    free( arena );
+}
+
+
+
+/******************************************************************************
+ * Function: _new_block                                                       *
+ * Imports: size - the number of bytes the block has to hold                  *
+ * Returns: pointer to a new, empty block                                     *
+ ******************************************************************************/
+static ArenaBlock *_new_block( size_t size )
+{
+    ArenaBlock *block;
+
+    block = (ArenaBlock*) malloc( ARENA_HEADER + size );
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    return block;
+}
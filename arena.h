@@ -0,0 +1,73 @@
+/******************************************************************************
+ * File:---- arena.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines an arena, a bump allocator that hands out memory from a  *
+ *           few large blocks and gives it all back at once.                  *
+ *           Declares functions for creating, allocating from, resetting and  *
+ *           deleting arenas.                                                 *
+ ******************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+
+/******************************************************************************
+ * ARENA_BLOCK_SIZE: the usual size of a block, in bytes. Larger requests get *
+ *                   a block of their own size                                *
+ * ARENA_ALIGN: every allocation starts on a multiple of this many bytes,     *
+ *              enough for any of the types the program stores                *
+ ******************************************************************************/
+#define ARENA_BLOCK_SIZE 65536
+#define ARENA_ALIGN 16
+
+
+
+/******************************************************************************
+ * Struct: ArenaBlock                                                         *
+ * Purpose: the header of one block of an arena. The memory handed out from   *
+ *          the block follows the header, rounded up to ARENA_ALIGN.          *
+ * Consists of:                                                               *
+ *     next - the next block of the arena, NULL for the last one              *
+ *     size - the number of bytes after the header                            *
+ *     used - the number of those bytes handed out since the last reset       *
+ ******************************************************************************/
+typedef struct BLOCK
+{
+    struct BLOCK *next;
+    size_t size;
+    size_t used;
+} ArenaBlock;
+
+
+
+/******************************************************************************
+ * Struct: Arena                                                              *
+ * Purpose: holds the blocks of an arena in the order they are used.          *
+ * Consists of:                                                               *
+ *     first - the first block, never NULL                                    *
+ *     current - the block that allocations are taken from                    *
+ *     blockSize - the size of each new block                                 *
+ * Notes: a reset only moves back to the first block. The blocks are kept and *
+ *        filled again in order, so an arena that is reset between games      *
+ *        stops calling malloc once it has grown to the size of one game.     *
+ ******************************************************************************/
+typedef struct
+{
+    ArenaBlock *first;
+    ArenaBlock *current;
+    size_t blockSize;
+} Arena;
+
+
+
+/* Function Prototypes */
+Arena *createArena( size_t );
+void *arenaAlloc( Arena*, size_t );
+void arenaReset( Arena* );
+void deleteArena( Arena* );
+
+#endif
@@ -0,0 +1,348 @@
+/******************************************************************************
+ * File:---- asyncLog.c                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the background log writer declared in asyncLog.h      *
+ * Notes:--- the queue is a ring of slots, each with a sequence number that   *
+ *           says whether it is free or full for a given lap of the ring.     *
+ *           Game threads claim a position with a compare and swap on head,   *
+ *           fill the slot and then publish it by moving its sequence on, so  *
+ *           neither side ever takes a lock.                                  *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+
+#include "asyncLog.h"
+#include "interface.h"
+#include "timer.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Move games through the queue, and the body of the writer thread            *
+ ******************************************************************************/
+static BOOL _enqueue( AsyncLog*, GameLog* );
+static GameLog *_dequeue( AsyncLog* );
+static void *_writer( void* );
+static void _write_game( AsyncLog*, GameLog* );
+static void _sync( AsyncLog* );
+
+
+/******************************************************************************
+ * Function: createAsyncLog                                                   *
+ * Imports: settings - the settings of the session                            *
+ *          logOptions - the format to write the games in, and the size the   *
+ *                       log file is rotated at                               *
+ *          freeLog - frees a game once it is written, NULL to leave it alone *
+ * Returns: pointer to the running writer                                     *
+ * Purpose: sets up a rolling log for the games and starts the writer thread. *
+ *          The log file is created along with the first game. If the thread  *
+ *          cannot be started, asyncLogGame writes each game itself.          *
+ ******************************************************************************/
+AsyncLog *createAsyncLog( Settings *settings, LogOptions *logOptions,
+    FreeFunc freeLog )
+{
+    AsyncLog *log;
+    long i;
+
+    log = (AsyncLog*) malloc( sizeof(AsyncLog) );
+    memset( log, 0, sizeof(AsyncLog) );
+
+    log->slots = (QueueSlot*) malloc( ASYNC_QUEUE_SIZE * sizeof(QueueSlot) );
+    for ( i = 0; i < ASYNC_QUEUE_SIZE; i++ )
+    {
+        log->slots[i].sequence = i;
+    }
+
+    log->output = createRollingLog( settings, logOptions->format,
+        logOptions->maxBytes );
+    log->freeLog = freeLog;
+    log->lastSync = wallTime( );
+
+    pthread_mutex_init( &log->lock, NULL );
+    log->started = pthread_create( &log->thread, NULL, &_writer, log ) == 0;
+    if ( !log->started )
+    {
+        printErr( "Could not start the log writer, "
+            "games will be saved as they finish" );
+    }
+
+    return log;
+}
+
+
+
+/******************************************************************************
+ * Function: asyncLogGame                                                     *
+ * Imports: log - the background writer                                       *
+ *          gameLog - a finished game, which must not change from now on      *
+ * Exports: none                                                              *
+ * Purpose: queues a game for the writer thread. Safe to call from any number *
+ *          of threads at once. If the queue is full the caller yields until  *
+ *          the writer has made room, which only happens when games finish    *
+ *          faster than the disk can take them.                               *
+ *          Without a writer thread the game is written straight away.        *
+ ******************************************************************************/
+void asyncLogGame( AsyncLog *log, GameLog *gameLog )
+{
+    long depth, highWater;
+
+    if ( !log->started )
+    {
+        pthread_mutex_lock( &log->lock );
+        _write_game( log, gameLog );
+        pthread_mutex_unlock( &log->lock );
+    }
+    else
+    {
+        while ( !_enqueue( log, gameLog ) )
+        {
+            __sync_fetch_and_add( &log->waits, 1 );
+            sched_yield( );
+        }
+
+        /* keep the largest depth seen, the depth itself is only a snapshot */
+        depth = log->head - log->tail;
+        highWater = log->highWater;
+        while ( depth > highWater &&
+                !__sync_bool_compare_and_swap( &log->highWater, highWater,
+                    depth ) )
+        {
+            highWater = log->highWater;
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: closeAsyncLog                                                    *
+ * Imports: pointer to a background writer                                    *
+ * Returns: TRUE if writing any game failed, FALSE otherwise                  *
+ * Purpose: lets the writer finish every game still in the queue, stops the   *
+ *          thread, then syncs and closes the log and frees the writer.       *
+ *          Prints where the games went and how full the queue got.           *
+ *          No game may be queued once this has been called.                  *
+ ******************************************************************************/
+BOOL closeAsyncLog( AsyncLog *log )
+{
+    RollingLog *output;
+    BOOL error;
+
+    __sync_synchronize( );
+    log->closing = TRUE;
+    if ( log->started )
+    {
+        pthread_join( log->thread, NULL );
+    }
+    pthread_mutex_destroy( &log->lock );
+
+    output = log->output;
+    if ( output->files > 1 )
+    {
+        printf( "\n%ld games have been saved to %d files, the last is %s\n",
+            output->games, output->files, output->fileName );
+    }
+    else if ( output->files == 1 )
+    {
+        printf( "\n%ld games have been saved to %s\n", output->games,
+            output->fileName );
+    }
+    printf( "  Queue high-water mark: %ld of %d\n"
+            "  Waits on a full queue: %ld\n\n",
+            log->highWater, ASYNC_QUEUE_SIZE, log->waits );
+
+    error = closeRollingLog( output );
+    if ( error )
+    {
+        printErr( "Failed to write the logs to the output file" );
+    }
+
+    free( log->slots );
+    free( log );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _enqueue                                                         *
+ * Imports: log - the background writer, gameLog - the game to queue          *
+ * Returns: TRUE if the game was queued, FALSE if the queue is full           *
+ * Purpose: claims the position at head once its slot is free for this lap    *
+ *          of the ring, fills the slot and hands it to the writer            *
+ ******************************************************************************/
+static BOOL _enqueue( AsyncLog *log, GameLog *gameLog )
+{
+    QueueSlot *slot;
+    long position, difference;
+    BOOL claimed, full;
+
+    claimed = FALSE;
+    full = FALSE;
+    slot = NULL;
+    position = log->head;
+    while ( !claimed && !full )
+    {
+        slot = &log->slots[position & ( ASYNC_QUEUE_SIZE - 1 )];
+        difference = slot->sequence - position;
+        if ( difference == 0 )
+        {
+            /* the slot is free, unless another thread claims it first */
+            claimed = __sync_bool_compare_and_swap( &log->head, position,
+                position + 1 );
+        }
+        else
+        {
+            /* the writer has not emptied the slot since the last lap */
+            full = difference < 0;
+        }
+
+        if ( !claimed )
+        {
+            position = log->head;
+        }
+    }
+
+    if ( claimed )
+    {
+        slot->gameLog = gameLog;
+        __sync_synchronize( );
+        slot->sequence = position + 1;
+    }
+
+    return claimed;
+}
+
+
+
+/******************************************************************************
+ * Function: _dequeue                                                         *
+ * Imports: pointer to a background writer                                    *
+ * Returns: the oldest queued game, NULL if the queue is empty                *
+ * Purpose: takes the game at tail once it has been published, then frees     *
+ *          its slot for the next lap of the ring. Only the writer thread     *
+ *          takes games, so tail needs no atomic update.                      *
+ ******************************************************************************/
+static GameLog *_dequeue( AsyncLog *log )
+{
+    QueueSlot *slot;
+    GameLog *gameLog;
+
+    gameLog = NULL;
+    slot = &log->slots[log->tail & ( ASYNC_QUEUE_SIZE - 1 )];
+    if ( slot->sequence == log->tail + 1 )
+    {
+        __sync_synchronize( );
+        gameLog = slot->gameLog;
+        slot->sequence = log->tail + ASYNC_QUEUE_SIZE;
+        log->tail++;
+    }
+
+    return gameLog;
+}
+
+
+
+/******************************************************************************
+ * Function: _writer                                                          *
+ * Imports: pointer to the AsyncLog the thread writes for                     *
+ * Returns: NULL                                                              *
+ * Purpose: the body of the writer thread. Writes games as they arrive, into  *
+ *          the file's buffer, which stdio writes out in LOG_BUFFER blocks.   *
+ *          Whenever the queue runs dry the buffer is flushed, so games do    *
+ *          not sit in memory while nothing else is happening, and the file   *
+ *          is synced at most every ASYNC_SYNC_SECONDS. Stops once the log is *
+ *          closing and the queue is empty.                                   *
+ ******************************************************************************/
+static void *_writer( void *data )
+{
+    AsyncLog *log;
+    GameLog *gameLog;
+    struct timespec idle;
+    BOOL closing, done;
+
+    log = (AsyncLog*) data;
+    idle.tv_sec = 0;
+    idle.tv_nsec = ASYNC_IDLE_NS;
+    done = FALSE;
+    while ( !done )
+    {
+        /* read closing first, so a game queued before it was set is still
+         * found below */
+        closing = log->closing;
+        __sync_synchronize( );
+
+        gameLog = _dequeue( log );
+        if ( gameLog != NULL )
+        {
+            _write_game( log, gameLog );
+        }
+        else if ( closing )
+        {
+            done = TRUE;
+        }
+        else
+        {
+            if ( wallTime( ) - log->lastSync >= ASYNC_SYNC_SECONDS )
+            {
+                _sync( log );
+            }
+            else
+            {
+                flushRollingLog( log->output, FALSE );
+            }
+            nanosleep( &idle, NULL );
+        }
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: _write_game                                                      *
+ * Imports: log - the background writer, gameLog - the game to write          *
+ * Exports: none                                                              *
+ * Purpose: appends one game to the rolling log, then frees it if the writer  *
+ *          owns it                                                           *
+ ******************************************************************************/
+static void _write_game( AsyncLog *log, GameLog *gameLog )
+{
+    rollingLogGame( log->output, gameLog );
+
+    if ( log->freeLog != NULL )
+    {
+        log->freeLog( gameLog );
+    }
+
+    /* a steady stream of games never lets the queue run dry */
+    if ( ( log->output->games & 1023 ) == 0 &&
+         wallTime( ) - log->lastSync >= ASYNC_SYNC_SECONDS )
+    {
+        _sync( log );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _sync                                                            *
+ * Imports: pointer to a background writer                                    *
+ * Exports: none                                                              *
+ * Purpose: pushes everything written so far out of the buffers and onto the  *
+ *          disk                                                              *
+ ******************************************************************************/
+static void _sync( AsyncLog *log )
+{
+    flushRollingLog( log->output, TRUE );
+    log->lastSync = wallTime( );
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * File:---- asyncLog.h                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a background log writer: game threads hand finished      *
+ *           games to a bounded lock-free queue, and a writer thread of its   *
+ *           own formats them and writes them to a log file, so that no game  *
+ *           ever waits for the disk.                                         *
+ *           Declares functions to start the writer, queue games and shut it  *
+ *           down.                                                            *
+ ******************************************************************************/
+
+#ifndef ASYNCLOG_H
+#define ASYNCLOG_H
+
+#include <stdio.h>
+#include <pthread.h>
+#include "game.h"
+#include "rollingLog.h"
+
+
+/******************************************************************************
+ * ASYNC_QUEUE_SIZE: the number of games the queue can hold, a power of 2     *
+ * ASYNC_SYNC_SECONDS: the longest a written game waits before the file is    *
+ *                     synced to the disk                                     *
+ * ASYNC_IDLE_NS: how long the writer sleeps when the queue is empty          *
+ ******************************************************************************/
+#define ASYNC_QUEUE_SIZE 4096
+#define ASYNC_SYNC_SECONDS 1.0
+#define ASYNC_IDLE_NS 1000000L
+
+
+
+/******************************************************************************
+ * QueueSlot: A struct that holds one place in the queue.                     *
+ * Consists of:                                                               *
+ *     sequence - the position in the queue the slot is ready for: equal to   *
+ *                the position when it can be filled, one more than the       *
+ *                position once it holds a game                               *
+ *     gameLog - the queued game                                              *
+ ******************************************************************************/
+typedef struct
+{
+    volatile long sequence;
+    GameLog *gameLog;
+} QueueSlot;
+
+
+
+/******************************************************************************
+ * AsyncLog: A struct that holds the state of a background log writer.        *
+ * Consists of:                                                               *
+ *     slots - the ring of ASYNC_QUEUE_SIZE queue slots                       *
+ *     padding1, padding2, padding3 - keep head and tail on cache lines of    *
+ *                                    their own, as each is written by a      *
+ *                                    different side of the queue             *
+ *     head - the next position to queue a game at, claimed with an atomic    *
+ *            compare and swap so any number of threads can queue games       *
+ *     tail - the next position the writer takes a game from, only ever       *
+ *            changed by the writer                                           *
+ *     highWater - the most games that have been in the queue at once         *
+ *     waits - the number of times a game thread found the queue full         *
+ *     closing - set once no more games will be queued                        *
+ *     thread - the writer thread                                             *
+ *     started - FALSE if the writer thread could not be started, in which    *
+ *               case each game is written by the thread that queues it       *
+ *     lock - keeps those threads from writing at the same time               *
+ *     output - the rolling log the games are written to                      *
+ *     freeLog - frees a game once it is written, NULL to leave it alone      *
+ *     lastSync - the wall time the file was last synced                      *
+ ******************************************************************************/
+typedef struct
+{
+    QueueSlot *slots;
+    char padding1[64];
+    volatile long head;
+    char padding2[64];
+    volatile long tail;
+    char padding3[64];
+    volatile long highWater;
+    volatile long waits;
+    volatile int closing;
+    pthread_t thread;
+    BOOL started;
+    pthread_mutex_t lock;
+    RollingLog *output;
+    FreeFunc freeLog;
+    double lastSync;
+} AsyncLog;
+
+
+
+/* Function Prototypes */
+AsyncLog *createAsyncLog( Settings*, LogOptions*, FreeFunc );
+void asyncLogGame( AsyncLog*, GameLog* );
+BOOL closeAsyncLog( AsyncLog* );
+
+#endif
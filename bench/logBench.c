@@ -0,0 +1,178 @@
+/******************************************************************************
+ * File:---- logBench.c                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- A benchmark of printing a session's game log, run by "make       *
+ *           bench". It times the single pass of displayLog and saveLog over  *
+ *           100,000 logged games against the old way of fetching each game   *
+ *           from a linked list by its index with printElement, which walks   *
+ *           the list from its head for every game.                           *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "game.h"
+#include "linkedList.h"
+#include "chunkedArray.h"
+#include "timer.h"
+
+
+/******************************************************************************
+ * BENCH_GAMES: the number of games printed in one pass                       *
+ * BENCH_INDEXED_GAMES: the number of games printed by index. The indexed     *
+ *                      walk is quadratic, so 100,000 games would take over   *
+ *                      two minutes                                           *
+ * BENCH_TURNS: the number of turns in each game                              *
+ * BENCH_OUTPUT: where the logs are printed to                                *
+ ******************************************************************************/
+#define BENCH_GAMES 100000
+#define BENCH_INDEXED_GAMES 10000
+#define BENCH_TURNS 9
+#define BENCH_OUTPUT "/dev/null"
+
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Log a game, and print the logs both ways                                   *
+ ******************************************************************************/
+static void _log_game( GameLog* );
+static double _print_indexed( FILE*, LinkedList*, int );
+static double _print_one_pass( FILE*, ChunkedArray* );
+
+
+int main( void )
+{
+    ChunkedArray *gameLogs, *firstLogs;
+    LinkedList *gameList;
+    GameLog game, *copy;
+    FILE *output;
+    double indexed, onePass, small;
+    int error, i;
+
+    output = fopen( BENCH_OUTPUT, "w" );
+    error = output == NULL;
+    if ( error )
+    {
+        perror( BENCH_OUTPUT );
+    }
+    else
+    {
+        /* the arrays hold the games by value, as playGame stores them, and
+         * the list holds copies of the first of them, as it did before */
+        gameLogs = createArray( sizeof(GameLog), NULL );
+        firstLogs = createArray( sizeof(GameLog), NULL );
+        gameList = createList( );
+        for ( i = 0; i < BENCH_GAMES; i++ )
+        {
+            _log_game( &game );
+            arrayAppend( gameLogs, &game );
+            if ( i < BENCH_INDEXED_GAMES )
+            {
+                arrayAppend( firstLogs, &game );
+                copy = (GameLog*) malloc( sizeof(GameLog) );
+                *copy = game;
+                listInsertLast( gameList, copy );
+            }
+        }
+
+        indexed = _print_indexed( output, gameList, BENCH_INDEXED_GAMES );
+        small = _print_one_pass( output, firstLogs );
+        onePass = _print_one_pass( output, gameLogs );
+
+        printf( "game log, %d turns per game\n", BENCH_TURNS );
+        printf( "     games   indexed (s)   one pass (s)\n" );
+        printf( "%10d %13.3f %14.3f\n", BENCH_INDEXED_GAMES, indexed, small );
+        printf( "%10d %13s %14.3f\n", BENCH_GAMES, "-", onePass );
+
+        /* every copy shares its turns with the game in gameLogs */
+        for ( i = 0; i < BENCH_GAMES; i++ )
+        {
+            freeArray( ( (GameLog*) arrayGet( gameLogs, i ) )->turnList );
+        }
+        freeList( gameList, &free );
+        freeArray( firstLogs );
+        freeArray( gameLogs );
+        fclose( output );
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _log_game                                                        *
+ * Imports: the game log to fill in                                           *
+ * Exports: a game log of BENCH_TURNS turns, filling a 3x3 board row by row   *
+ ******************************************************************************/
+static void _log_game( GameLog *game )
+{
+    TurnLog turn;
+    int t;
+
+    #ifdef Editor
+    game->settings.width = 3;
+    game->settings.height = 3;
+    game->settings.matches = 3;
+    game->settings.tableSize = 0;
+    #endif
+    game->turnList = createArray( sizeof(TurnLog), NULL );
+    for ( t = 0; t < BENCH_TURNS; t++ )
+    {
+        turn.turnNum = t + 1;
+        turn.player = t % 2 == 0 ? TicTacX : TicTacO;
+        turn.location.x = t % 3;
+        turn.location.y = t / 3;
+        arrayAppend( game->turnList, &turn );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _print_indexed                                                   *
+ * Imports: output stream, list of game logs, number of games to print        *
+ * Returns: the time taken, in seconds                                        *
+ * Purpose: prints the games the way displayLog and saveLog used to, with a   *
+ *          banner and a call to printElement for each index                  *
+ ******************************************************************************/
+static double _print_indexed( FILE *stream, LinkedList *gameList, int games )
+{
+    double start;
+    int i;
+
+    start = wallTime( );
+    for ( i = 0; i < games; i++ )
+    {
+        fprintf( stream, "##################\n"
+                         "###   GAME %2d  ###\n"
+                         "##################\n", i + 1 );
+        printElement( stream, gameList, i, &printGameLog );
+    }
+    fflush( stream );
+
+    return wallTime( ) - start;
+}
+
+
+
+/******************************************************************************
+ * Function: _print_one_pass                                                  *
+ * Imports: output stream, array of game logs                                 *
+ * Returns: the time taken, in seconds                                        *
+ * Purpose: prints the games the way displayLog and saveLog do now            *
+ ******************************************************************************/
+static double _print_one_pass( FILE *stream, ChunkedArray *gameLogs )
+{
+    double start;
+
+    start = wallTime( );
+    arrayForEach( gameLogs, &printGame, stream );
+    fflush( stream );
+
+    return wallTime( ) - start;
+}
+
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * File:---- winBench.c                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- A microbenchmark of checkWin for K from 3 to 10. It is built     *
+ *           twice by "make bench", once with each win check, and both builds *
+ *           write a checksum of every answer they gave so that the two can   *
+ *           be compared as well as timed.                                    *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "game.h"
+#include "player.h"
+#include "timer.h"
+
+
+/******************************************************************************
+ * BENCH_SIZE: the width and height of the boards that are checked            *
+ * BENCH_BOARDS: the number of random positions checked for each K            *
+ * BENCH_FILL: one cell in this many is given a tile in each position         *
+ * BENCH_REPEATS: the number of times each position is checked in a run       *
+ * BENCH_RUNS: the number of runs, of which the fastest is reported           *
+ * BENCH_MIN_K, BENCH_MAX_K: the range of K that is measured                  *
+ * BENCH_TILES: the number of tiles in each position                          *
+ ******************************************************************************/
+#define BENCH_SIZE 20
+#define BENCH_BOARDS 64
+#define BENCH_FILL 2
+#define BENCH_REPEATS 20
+#define BENCH_RUNS 9
+#define BENCH_MIN_K 3
+#define BENCH_MAX_K 10
+#define BENCH_TILES ( BENCH_SIZE * BENCH_SIZE / BENCH_FILL )
+
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Set up a random position and time the checks of all of its tiles           *
+ ******************************************************************************/
+static void _fill( GameBoard*, int*, unsigned long* );
+static double _time_checks( GameBoard**, int (*)[BENCH_TILES],
+    unsigned long* );
+
+
+int main( int argc, char **argv )
+{
+    Settings settings[BENCH_MAX_K + 1];
+    GameBoard *boards[BENCH_BOARDS];
+    static int cells[BENCH_BOARDS][BENCH_TILES];
+    FILE *sums;
+    unsigned long seed, checksum;
+    double best, seconds;
+    int k, b, run, error;
+
+    error = argc != 2;
+    sums = error ? NULL : fopen( argv[1], "w" );
+    if ( sums == NULL )
+    {
+        fprintf( stderr, "usage: winBench CHECKSUM_FILE\n" );
+        error = 1;
+    }
+    else
+    {
+        #ifdef Scalar
+        printf( "checkWin, scalar scan, %dx%d boards\n", BENCH_SIZE,
+            BENCH_SIZE );
+        #else
+        printf( "checkWin, word-parallel check, %dx%d boards\n", BENCH_SIZE,
+            BENCH_SIZE );
+        #endif
+        printf( "   K   ns per check\n" );
+
+        for ( k = BENCH_MIN_K; k <= BENCH_MAX_K; k++ )
+        {
+            /* the same positions for both builds */
+            settings[k].width = BENCH_SIZE;
+            settings[k].height = BENCH_SIZE;
+            settings[k].matches = k;
+            settings[k].tableSize = 0;
+            seed = (unsigned long) k;
+            for ( b = 0; b < BENCH_BOARDS; b++ )
+            {
+                boards[b] = (GameBoard*) malloc( sizeof(GameBoard) );
+                boardInit( boards[b], &settings[k] );
+                _fill( boards[b], cells[b], &seed );
+            }
+
+            best = 0.0;
+            for ( run = 0; run < BENCH_RUNS; run++ )
+            {
+                checksum = 0;
+                seconds = _time_checks( boards, cells, &checksum );
+                best = run == 0 || seconds < best ? seconds : best;
+            }
+
+            printf( "%4d %14.1f\n", k,
+                best * 1e9 / ( BENCH_REPEATS * BENCH_BOARDS * BENCH_TILES ) );
+            fprintf( sums, "%d %lx\n", k, checksum );
+
+            for ( b = 0; b < BENCH_BOARDS; b++ )
+            {
+                deleteGameBoard( boards[b] );
+            }
+        }
+        fclose( sums );
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _fill                                                            *
+ * Imports: board - an empty board                                            *
+ *          seed - the state of the random number generator                   *
+ * Exports: the board, with BENCH_TILES tiles on it                           *
+ *          cells - the tiles, ( y * width + x ) * 2, plus one for an O       *
+ * Purpose: places tiles at random without checking for wins. Three tiles in  *
+ *          four are X's, so that the positions hold lines of every length,   *
+ *          up to 10                                                          *
+ ******************************************************************************/
+static void _fill( GameBoard *board, int *cells, unsigned long *seed )
+{
+    int placed, cell;
+    TicTacTile tile;
+
+    placed = 0;
+    while ( placed < BENCH_TILES )
+    {
+        cell = (int) ( nextRandom( seed ) % ( BENCH_SIZE * BENCH_SIZE ) );
+        tile = nextRandom( seed ) % 4 == 0 ? TicTacO : TicTacX;
+        if ( placeTile( board, tile, cell % BENCH_SIZE, cell / BENCH_SIZE ) )
+        {
+            cells[placed] = cell * 2 + ( tile == TicTacO );
+            placed++;
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _time_checks                                                     *
+ * Imports: boards - the positions to check                                   *
+ *          cells - the cells of the tiles of each position, see _fill        *
+ * Returns: the time taken, in seconds                                        *
+ * Exports: checksum - mixed with the answer for every tile of every position *
+ * Purpose: asks checkWin about every tile of every position, BENCH_REPEATS   *
+ *          times over                                                        *
+ ******************************************************************************/
+static double _time_checks( GameBoard **boards, int (*cells)[BENCH_TILES],
+    unsigned long *checksum )
+{
+    double start;
+    int r, b, i, x, y;
+
+    start = wallTime( );
+    for ( r = 0; r < BENCH_REPEATS; r++ )
+    {
+        for ( b = 0; b < BENCH_BOARDS; b++ )
+        {
+            for ( i = 0; i < BENCH_TILES; i++ )
+            {
+                x = cells[b][i] / 2 % BENCH_SIZE;
+                y = cells[b][i] / 2 / BENCH_SIZE;
+                *checksum = *checksum * 31 + (unsigned long) checkWin(
+                    boards[b], cells[b][i] % 2 ? TicTacO : TicTacX, x, y );
+            }
+        }
+    }
+
+    return wallTime( ) - start;
+}
@@ -0,0 +1,493 @@
+/******************************************************************************
+ * File:---- binaryLog.c                                                      *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the binary log writer and reader declared in          *
+ *           binaryLog.h                                                      *
+ ******************************************************************************/
+#include <stdlib.h>
+
+#include "binaryLog.h"
+#include "fileIO.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Move single bytes and varints through the buffers and check the settings   *
+ * of a logged game                                                           *
+ ******************************************************************************/
+static void _put_byte( LogWriter*, int );
+static void _put_varint( LogWriter*, unsigned long );
+static void _put_settings( LogWriter*, Settings* );
+static void _flush( LogWriter* );
+static BOOL _get_byte( LogReader*, int* );
+static BOOL _get_varint( LogReader*, unsigned long* );
+static BOOL _get_settings( LogReader*, Settings* );
+
+
+/******************************************************************************
+ * Function: createLogWriter                                                  *
+ * Imports: file - an open file to write the log to                           *
+ *          settings - the settings of the current session                    *
+ * Returns: pointer to a new writer                                           *
+ * Purpose: starts a binary log by buffering its header. Nothing reaches the  *
+ *          file until the buffer fills up or the writer is deleted.          *
+ ******************************************************************************/
+LogWriter *createLogWriter( FILE *file, Settings *settings )
+{
+    LogWriter *writer;
+    int i;
+
+    writer = (LogWriter*) malloc( sizeof(LogWriter) );
+    writer->file = file;
+    writer->settings = *settings;
+    writer->used = 0;
+    writer->bytes = 0;
+    writer->error = FALSE;
+
+    for ( i = 0; i < BINLOG_MAGIC_LEN; i++ )
+    {
+        _put_byte( writer, BINLOG_MAGIC[i] );
+    }
+    _put_byte( writer, BINLOG_VERSION );
+    _put_settings( writer, settings );
+
+    return writer;
+}
+
+
+
+/******************************************************************************
+ * Function: writeGameLog                                                     *
+ * Imports: writer - the writer to add the game to                            *
+ *          gameLog - the game to add                                         *
+ * Returns: TRUE if writing to the file has failed, FALSE otherwise           *
+ * Purpose: encodes one game into the writer's buffer. Turns are almost       *
+ *          always numbered one after another, so with the player the turn    *
+ *          fits into a single byte, and so does the cell on most boards.     *
+ ******************************************************************************/
+BOOL writeGameLog( LogWriter *writer, GameLog *gameLog )
+{
+    Settings *settings;
+    TurnLog *turn;
+    int i, area, lastTurn, cell;
+
+    #ifdef Editor
+    settings = &gameLog->settings;
+    #else
+    settings = &writer->settings;
+    #endif
+
+    area = settings->width * settings->height;
+    _put_settings( writer, settings );
+    _put_varint( writer, (unsigned long) gameLog->turnList->size );
+
+    lastTurn = 0;
+    for ( i = 0; i < gameLog->turnList->size; i++ )
+    {
+        turn = (TurnLog*) arrayGet( gameLog->turnList, i );
+        cell = turn->location.y * settings->width + turn->location.x;
+
+        _put_varint( writer,
+            (unsigned long) ( turn->turnNum - lastTurn ) << 2 |
+            (unsigned long) turn->player );
+        if ( area <= BINLOG_SMALL_AREA )
+        {
+            _put_byte( writer, cell );
+        }
+        else
+        {
+            _put_varint( writer, (unsigned long) cell );
+        }
+        lastTurn = turn->turnNum;
+    }
+
+    return writer->error;
+}
+
+
+
+/******************************************************************************
+ * Function: flushLogWriter                                                   *
+ * Imports: pointer to a writer                                               *
+ * Returns: TRUE if any write to the file failed, FALSE otherwise             *
+ * Purpose: writes out whatever is in the buffer and flushes the file, so     *
+ *          that every game written so far can be read back. The writer can   *
+ *          carry on writing games afterwards.                                *
+ ******************************************************************************/
+BOOL flushLogWriter( LogWriter *writer )
+{
+    _flush( writer );
+    if ( fflush( writer->file ) != 0 )
+    {
+        writer->error = TRUE;
+    }
+
+    return writer->error;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteLogWriter                                                  *
+ * Imports: pointer to a writer                                               *
+ * Returns: TRUE if any write to the file failed, FALSE otherwise             *
+ * Purpose: writes out whatever is left in the buffer and frees the writer.   *
+ *          The file is left open for the caller to close.                    *
+ ******************************************************************************/
+BOOL deleteLogWriter( LogWriter *writer )
+{
+    BOOL error;
+
+    error = flushLogWriter( writer );
+    free( writer );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _put_byte                                                        *
+ * Imports: pointer to a writer, the byte to write                            *
+ * Exports: none                                                              *
+ * Purpose: adds a byte to the buffer, writing the buffer out first if it is  *
+ *          full                                                              *
+ ******************************************************************************/
+static void _put_byte( LogWriter *writer, int byte )
+{
+    if ( writer->used == BINLOG_BUFFER )
+    {
+        _flush( writer );
+    }
+    writer->buffer[writer->used] = (unsigned char) byte;
+    writer->used++;
+    writer->bytes++;
+}
+
+
+
+/******************************************************************************
+ * Function: _put_varint                                                      *
+ * Imports: pointer to a writer, the number to write                          *
+ * Exports: none                                                              *
+ * Purpose: writes a number 7 bits at a time, lowest bits first, marking      *
+ *          every byte but the last with the top bit                          *
+ ******************************************************************************/
+static void _put_varint( LogWriter *writer, unsigned long value )
+{
+    while ( value >= 0x80 )
+    {
+        _put_byte( writer, (int) ( value & 0x7F ) | 0x80 );
+        value >>= 7;
+    }
+    _put_byte( writer, (int) value );
+}
+
+
+
+/******************************************************************************
+ * Function: _put_settings                                                    *
+ * Imports: pointer to a writer, the settings to write                        *
+ * Exports: none                                                              *
+ * Purpose: writes M, N and K. The table size only matters to the computer    *
+ *          players, so it is not logged                                      *
+ ******************************************************************************/
+static void _put_settings( LogWriter *writer, Settings *settings )
+{
+    _put_varint( writer, (unsigned long) settings->width );
+    _put_varint( writer, (unsigned long) settings->height );
+    _put_varint( writer, (unsigned long) settings->matches );
+}
+
+
+
+/******************************************************************************
+ * Function: _flush                                                           *
+ * Imports: pointer to a writer                                               *
+ * Exports: none                                                              *
+ * Purpose: writes the buffer to the file with a single call and empties it.  *
+ *          Once a write has failed nothing more is written.                  *
+ ******************************************************************************/
+static void _flush( LogWriter *writer )
+{
+    if ( !writer->error && writer->used > 0 &&
+         fwrite( writer->buffer, 1, writer->used, writer->file ) !=
+            (size_t) writer->used )
+    {
+        writer->error = TRUE;
+    }
+    writer->used = 0;
+}
+
+
+
+/******************************************************************************
+ * Function: createLogReader                                                  *
+ * Imports: file - an open file to read a log from                            *
+ * Returns: pointer to a new reader, with error set if the file does not      *
+ *          start with a valid header                                         *
+ * Purpose: starts reading a binary log and reads the settings it was saved   *
+ *          with                                                              *
+ ******************************************************************************/
+LogReader *createLogReader( FILE *file )
+{
+    LogReader *reader;
+    int i, byte;
+
+    reader = (LogReader*) malloc( sizeof(LogReader) );
+    reader->file = file;
+    reader->start = 0;
+    reader->next = 0;
+    reader->length = 0;
+    reader->games = 0;
+    reader->error = FALSE;
+
+    i = 0;
+    while ( !reader->error && i < BINLOG_MAGIC_LEN )
+    {
+        reader->error = !_get_byte( reader, &byte ) ||
+            byte != BINLOG_MAGIC[i];
+        i++;
+    }
+    if ( !reader->error )
+    {
+        reader->error = !_get_byte( reader, &byte ) ||
+            byte != BINLOG_VERSION || !_get_settings( reader,
+            &reader->settings );
+    }
+
+    return reader;
+}
+
+
+
+/******************************************************************************
+ * Function: readGameLog                                                      *
+ * Imports: reader - the reader to take the next game from                    *
+ *          gameLog - the game log to fill in                                 *
+ *          settings - where to put the settings of the game                  *
+ *          arena - arena for the game's turns, NULL to use malloc            *
+ * Returns: TRUE if a game was read, FALSE at the end of the log or if the    *
+ *          log is damaged, in which case the reader's error is set           *
+ * Exports: the game's turns in gameLog, its settings in settings             *
+ * Purpose: decodes the next game of the log. Only as much of the file as is  *
+ *          needed for the game is read, so logs of any size can be replayed  *
+ *          in little memory.                                                 *
+ ******************************************************************************/
+BOOL readGameLog( LogReader *reader, GameLog *gameLog, Settings *settings,
+    Arena *arena )
+{
+    BOOL found;
+    TurnLog turn;
+    unsigned long count, value, cell, i;
+    int byte, area;
+
+    found = FALSE;
+    gameLog->turnList = NULL;
+    gameLog->winner = TicTacNone;
+
+    /* a log that ends cleanly ends just before the next game */
+    if ( !reader->error && reader->next == reader->length )
+    {
+        reader->start += reader->length;
+        reader->length = (int) fread( reader->buffer, 1, BINLOG_BUFFER,
+            reader->file );
+        reader->next = 0;
+    }
+
+    if ( !reader->error && reader->length > 0 )
+    {
+        reader->error = !_get_settings( reader, settings ) ||
+            !_get_varint( reader, &count );
+        area = settings->width * settings->height;
+        if ( !reader->error && count > (unsigned long) area )
+        {
+            reader->error = TRUE;
+        }
+
+        gameLog->turnList = createArray( sizeof(TurnLog), arena );
+        #ifdef Editor
+        gameLog->settings = *settings;
+        #endif
+
+        turn.turnNum = 0;
+        i = 0;
+        while ( !reader->error && i < count )
+        {
+            reader->error = !_get_varint( reader, &value );
+            if ( !reader->error && area <= BINLOG_SMALL_AREA )
+            {
+                reader->error = !_get_byte( reader, &byte );
+                cell = (unsigned long) byte;
+            }
+            else if ( !reader->error )
+            {
+                reader->error = !_get_varint( reader, &cell );
+            }
+
+            turn.turnNum += (int) ( value >> 2 );
+            turn.player = (TicTacTile) ( value & 3 );
+            if ( !reader->error && ( cell >= (unsigned long) area ||
+                 turn.player == TicTacNone || turn.player >= TicTacTotal ) )
+            {
+                reader->error = TRUE;
+            }
+            else if ( !reader->error )
+            {
+                turn.location.x = (int) ( cell % settings->width );
+                turn.location.y = (int) ( cell / settings->width );
+                arrayAppend( gameLog->turnList, &turn );
+            }
+            i++;
+        }
+
+        if ( !reader->error )
+        {
+            found = TRUE;
+            reader->games++;
+        }
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: seekLogReader                                                    *
+ * Imports: reader - a reader whose header has been read                      *
+ *          offset - the offset in the file of the start of a game            *
+ * Returns: TRUE if the file could not be seeked, FALSE otherwise             *
+ * Purpose: moves the reader straight to a game, e.g. one found in the log's  *
+ *          index, so that the next readGameLog reads that game. The games    *
+ *          before it are never read.                                         *
+ ******************************************************************************/
+BOOL seekLogReader( LogReader *reader, long offset )
+{
+    if ( fseek( reader->file, offset, SEEK_SET ) != 0 )
+    {
+        reader->error = TRUE;
+    }
+    reader->start = offset;
+    reader->next = 0;
+    reader->length = 0;
+
+    return reader->error;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteLogReader                                                  *
+ * Imports: pointer to a reader                                               *
+ * Exports: none                                                              *
+ * Purpose: frees the reader. The file is left open for the caller to close.  *
+ ******************************************************************************/
+void deleteLogReader( LogReader *reader )
+{
+    free( reader );
+}
+
+
+
+/******************************************************************************
+ * Function: _get_byte                                                        *
+ * Imports: pointer to a reader                                               *
+ * Returns: TRUE if a byte was read, FALSE at the end of the file             *
+ * Exports: byte - the next byte of the log                                   *
+ * Purpose: takes the next byte from the buffer, refilling the buffer from    *
+ *          the file once it has all been used                                *
+ ******************************************************************************/
+static BOOL _get_byte( LogReader *reader, int *byte )
+{
+    BOOL found;
+
+    if ( reader->next == reader->length )
+    {
+        reader->start += reader->length;
+        reader->length = (int) fread( reader->buffer, 1, BINLOG_BUFFER,
+            reader->file );
+        reader->next = 0;
+    }
+
+    found = reader->next < reader->length;
+    if ( found )
+    {
+        *byte = reader->buffer[reader->next];
+        reader->next++;
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _get_varint                                                      *
+ * Imports: pointer to a reader                                               *
+ * Returns: TRUE if a number was read, FALSE if the file ended part way       *
+ *          through it or it is too long to be a number                       *
+ * Exports: value - the number read                                           *
+ * Purpose: reads a number written by _put_varint                             *
+ ******************************************************************************/
+static BOOL _get_varint( LogReader *reader, unsigned long *value )
+{
+    BOOL found, more;
+    int byte, shift;
+
+    *value = 0;
+    shift = 0;
+    more = TRUE;
+    found = TRUE;
+    while ( found && more )
+    {
+        found = shift < (int) sizeof(unsigned long) * 8 &&
+            _get_byte( reader, &byte );
+        if ( found )
+        {
+            *value |= (unsigned long) ( byte & 0x7F ) << shift;
+            more = ( byte & 0x80 ) != 0;
+            shift += 7;
+        }
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _get_settings                                                    *
+ * Imports: pointer to a reader                                               *
+ * Returns: TRUE if M, N and K were read and are valid settings               *
+ * Exports: settings - M, N and K of the log or game                          *
+ * Purpose: reads the settings written by _put_settings and checks them the   *
+ *          same way as the settings file, so that a damaged log can never    *
+ *          describe a board that could not be played                         *
+ ******************************************************************************/
+static BOOL _get_settings( LogReader *reader, Settings *settings )
+{
+    BOOL valid;
+    unsigned long width, height, matches;
+
+    valid = _get_varint( reader, &width ) &&
+        _get_varint( reader, &height ) && _get_varint( reader, &matches ) &&
+        width <= MAX_DIMENSION && height <= MAX_DIMENSION &&
+        matches <= MAX_DIMENSION;
+
+    if ( valid )
+    {
+        settings->width = (int) width;
+        settings->height = (int) height;
+        settings->matches = (int) matches;
+        settings->tableSize = DEFAULT_TABLE_SIZE;
+        settings->tableSet = FALSE;
+        valid = validSetting( "M", settings->width ) &&
+            validSetting( "N", settings->height ) &&
+            validSetting( "K", settings->matches );
+    }
+
+    return valid;
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * File:---- binaryLog.h                                                      *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a compact binary format for game logs, along with a      *
+ *           buffered writer that streams games into it and a buffered reader *
+ *           that streams them back out one game at a time.                   *
+ *                                                                            *
+ * Format:-- every number is a varint: 7 bits per byte, lowest bits first,    *
+ *           with the top bit set on every byte but the last.                 *
+ *           header: BINLOG_MAGIC, a version byte, then M, N and K of the     *
+ *                   session the log was saved in                             *
+ *           game:   M, N and K of the game, the number of turns, then for    *
+ *                   each turn ( turnDelta << 2 ) | player followed by the    *
+ *                   cell y * M + x. The cell takes one plain byte on boards  *
+ *                   of up to BINLOG_SMALL_AREA cells, and a varint otherwise *
+ *           Games follow one another until the end of the file.              *
+ ******************************************************************************/
+
+#ifndef BINARYLOG_H
+#define BINARYLOG_H
+
+#include <stdio.h>
+#include "game.h"
+
+
+/******************************************************************************
+ * BINLOG_MAGIC: the first bytes of a binary log file                         *
+ * BINLOG_MAGIC_LEN: the number of bytes in BINLOG_MAGIC                      *
+ * BINLOG_VERSION: the version of the format written after the magic          *
+ * BINLOG_SMALL_AREA: the largest board whose cells fit into a single byte    *
+ * BINLOG_BUFFER: the size of the reader's and writer's buffers, in bytes     *
+ ******************************************************************************/
+#define BINLOG_MAGIC "MNKB"
+#define BINLOG_MAGIC_LEN 4
+#define BINLOG_VERSION 1
+#define BINLOG_SMALL_AREA 256
+#define BINLOG_BUFFER 65536
+
+
+
+/******************************************************************************
+ * LogWriter: A struct that holds the state of a binary log being written.    *
+ * Consists of:                                                               *
+ *     file - the file the log is written to, opened by the caller            *
+ *     settings - the settings written into the header. Games are logged      *
+ *                with these unless Editor gives each game its own            *
+ *     buffer - bytes waiting to be written to the file                       *
+ *     used - the number of bytes in buffer                                   *
+ *     bytes - the number of bytes written so far, including the buffer       *
+ *     error - TRUE once a write to the file has failed                       *
+ ******************************************************************************/
+typedef struct
+{
+    FILE *file;
+    Settings settings;
+    unsigned char buffer[BINLOG_BUFFER];
+    int used;
+    long bytes;
+    BOOL error;
+} LogWriter;
+
+
+
+/******************************************************************************
+ * LogReader: A struct that holds the state of a binary log being read.       *
+ * Consists of:                                                               *
+ *     file - the file the log is read from, opened by the caller             *
+ *     settings - the settings read from the header                           *
+ *     buffer - bytes read from the file but not yet decoded                  *
+ *     start - the offset in the file of the first byte of buffer             *
+ *     next - index of the next byte to decode in buffer                      *
+ *     length - the number of bytes in buffer                                 *
+ *     games - the number of games read so far                                *
+ *     error - TRUE once the file turned out not to be a valid binary log,    *
+ *             or ended part way through a game                               *
+ ******************************************************************************/
+typedef struct
+{
+    FILE *file;
+    Settings settings;
+    unsigned char buffer[BINLOG_BUFFER];
+    long start;
+    int next;
+    int length;
+    long games;
+    BOOL error;
+} LogReader;
+
+
+
+/* Function Prototypes */
+LogWriter *createLogWriter( FILE*, Settings* );
+BOOL writeGameLog( LogWriter*, GameLog* );
+BOOL flushLogWriter( LogWriter* );
+BOOL deleteLogWriter( LogWriter* );
+
+LogReader *createLogReader( FILE* );
+BOOL readGameLog( LogReader*, GameLog*, Settings*, Arena* );
+BOOL seekLogReader( LogReader*, long );
+void deleteLogReader( LogReader* );
+
+#endif
@@ -0,0 +1,29 @@
+/******************************************************************************
+ * File:---- bits.h                                                           *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines bit scans of unsigned long words, which GCC and Clang    *
+ *           turn into a single instruction. The program needs one of the two *
+ *           compilers anyway for the __sync atomics its threads share work   *
+ *           with, so there is no fallback for other compilers.               *
+ ******************************************************************************/
+
+#ifndef BITS_H
+#define BITS_H
+
+
+/******************************************************************************
+ * LOWEST_BIT: the index of the lowest set bit of a word, from 0              *
+ * HIGHEST_BIT: the index of the highest set bit of a word, from 0            *
+ * Assertions: the word is not 0                                              *
+ ******************************************************************************/
+#ifndef __GNUC__
+#error "TicTacToe needs GCC or Clang for its builtins and __sync atomics"
+#endif
+
+#define LOWEST_BIT( word ) __builtin_ctzl( word )
+#define HIGHEST_BIT( word ) \
+    ( (int) sizeof(unsigned long) * 8 - 1 - __builtin_clzl( word ) )
+
+#endif
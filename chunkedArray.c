@@ -0,0 +1,262 @@
+/******************************************************************************
+ * File:---- chunkedArray.c                                                   *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the chunked array declared in chunkedArray.h          *
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "chunkedArray.h"
+#include "interface.h"
+#include "bits.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Locates an element inside its chunk, only used by the array functions      *
+ ******************************************************************************/
+static char *_element( ChunkedArray*, long );
+
+
+/******************************************************************************
+ * Function: createArray                                                      *
+ * Imports: size of each element in bytes                                     *
+ *          arena to allocate from, NULL to use malloc                        *
+ * Exports: newArray                                                          *
+ * Purpose: allocates an empty chunked array. No chunk is allocated until     *
+ *          the first element is appended. An array made in an arena is       *
+ *          freed along with the arena.                                       *
+ ******************************************************************************/
+ChunkedArray *createArray( int elementSize, Arena *arena )
+{
+    ChunkedArray *newArray;
+
+    if ( arena != NULL )
+    {
+        newArray = (ChunkedArray*) arenaAlloc( arena, sizeof(ChunkedArray) );
+        memset( newArray, 0, sizeof(ChunkedArray) );
+    }
+    else
+    {
+        newArray = (ChunkedArray*) calloc( sizeof(ChunkedArray), 1 );
+    }
+    newArray->elementSize = elementSize;
+    newArray->arena = arena;
+
+    return newArray;
+}
+
+
+
+/******************************************************************************
+ * Function: arrayAppend                                                      *
+ * Imports: pointer to a chunked array,                                       *
+ *          pointer to the element to copy in                                 *
+ * Returns: pointer to the stored copy, NULL if the array is full or its     *
+ *          next chunk could not be allocated                                 *
+ * Purpose: copies the element onto the end of the array, allocating a new    *
+ *          chunk, twice the size of the last one, when the last is full.     *
+ *          A full array is only reported through the returned NULL, so that  *
+ *          arrays can be filled from threads that must not print.            *
+ ******************************************************************************/
+void *arrayAppend( ChunkedArray *array, void *element )
+{
+    char *stored;
+    size_t bytes;
+    long capacity;
+
+    stored = NULL;
+    if ( array != NULL )
+    {
+        /* the chunks so far hold ARRAY_FIRST_CHUNK * ( 2^numChunks - 1 ) */
+        capacity = ARRAY_FIRST_CHUNK * ( ( 1L << array->numChunks ) - 1 );
+        if ( array->size == capacity && array->numChunks < ARRAY_MAX_CHUNKS )
+        {
+            bytes = ( (size_t) ARRAY_FIRST_CHUNK << array->numChunks ) *
+                array->elementSize;
+            array->chunks[array->numChunks] = array->arena != NULL ?
+                (char*) arenaAlloc( array->arena, bytes ) :
+                (char*) malloc( bytes );
+            if ( array->chunks[array->numChunks] != NULL )
+            {
+                array->numChunks++;
+                capacity =
+                    ARRAY_FIRST_CHUNK * ( ( 1L << array->numChunks ) - 1 );
+            }
+        }
+
+        if ( array->size < capacity )
+        {
+            stored = _element( array, array->size );
+            memcpy( stored, element, array->elementSize );
+            array->size++;
+        }
+    }
+    else
+    {
+        printErr( "Array points to NULL" );
+    }
+
+    return stored;
+}
+
+
+
+/******************************************************************************
+ * Function: arrayGet                                                         *
+ * Imports: pointer to a chunked array,                                       *
+ *          index inside the array                                            *
+ * Returns: pointer to the element at the index, NULL if there is none        *
+ * Purpose: looks an element up in constant time, without walking the array.  *
+ ******************************************************************************/
+void *arrayGet( ChunkedArray *array, long index )
+{
+    char *element;
+
+    element = NULL;
+    if ( array != NULL && index >= 0 && index < array->size )
+    {
+        element = _element( array, index );
+    }
+    else if ( array == NULL )
+    {
+        printErr( "Array points to NULL" );
+    }
+    else
+    {
+        printErr( "Array index outside of range" );
+    }
+
+    return element;
+}
+
+
+
+/******************************************************************************
+ * Function: arrayForEach                                                     *
+ * Imports: pointer to a chunked array,                                       *
+ *          visiting function pointer,                                        *
+ *          context passed through to the visiting function                   *
+ * Exports: none                                                              *
+ * Purpose: calls the visiting function on every element of the array in      *
+ *          order, along with the element's index. Each chunk is walked from  *
+ *          start to end, so the elements are read in memory order.           *
+ ******************************************************************************/
+void arrayForEach( ChunkedArray *array, VisitFunc visitElement,
+    void *context )
+{
+    char *element;
+    long count, i, index;
+    int chunk;
+
+    if ( array != NULL )
+    {
+        index = 0;
+        for ( chunk = 0; chunk < array->numChunks; chunk++ )
+        {
+            count = (long) ARRAY_FIRST_CHUNK << chunk;
+            element = array->chunks[chunk];
+            for ( i = 0; i < count && index < array->size; i++ )
+            {
+                visitElement( context, element, index );
+                element += array->elementSize;
+                index++;
+            }
+        }
+    }
+    else
+    {
+        printErr( "Array points to NULL" );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: printArray                                                       *
+ * Imports: output file stream,                                               *
+ *          pointer to a chunked array,                                       *
+ *          printing function pointer                                         *
+ * Exports: none                                                              *
+ * Purpose: prints every element of the array into the specified stream,      *
+ *          the same way printList does for a linked list.                    *
+ ******************************************************************************/
+void printArray( FILE *stream, ChunkedArray *array, PrintFunc printElement )
+{
+    char *element;
+    long count, i, index;
+    int chunk;
+
+    if ( array != NULL )
+    {
+        index = 0;
+        for ( chunk = 0; chunk < array->numChunks; chunk++ )
+        {
+            count = (long) ARRAY_FIRST_CHUNK << chunk;
+            element = array->chunks[chunk];
+            for ( i = 0; i < count && index < array->size; i++ )
+            {
+                printElement( stream, element );
+                element += array->elementSize;
+                index++;
+            }
+        }
+    }
+    else
+    {
+        printErr( "Array points to NULL" );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: freeArray                                                        *
+ * Imports: pointer to a chunked array                                        *
+ * Exports: none                                                              *
+ * Purpose: frees every chunk and the array itself in one go. The elements    *
+ *          are stored by value, so they need no freeing function of their    *
+ *          own. An array made in an arena is left for the arena to free.     *
+ ******************************************************************************/
+void freeArray( ChunkedArray *array )
+{
+    int chunk;
+
+    if ( array == NULL )
+    {
+        printErr( "Array points to NULL" );
+    }
+    else if ( array->arena == NULL )
+    {
+        for ( chunk = 0; chunk < array->numChunks; chunk++ )
+        {
+            free( array->chunks[chunk] );
+        }
+        free( array );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _element                                                         *
+ * Imports: pointer to a chunked array, index of an element                   *
+ * Returns: pointer to where the element is stored                            *
+ * Purpose: chunk k starts at index ARRAY_FIRST_CHUNK * ( 2^k - 1 ), so the   *
+ *          chunk of an index is the position of the highest set bit of       *
+ *          index / ARRAY_FIRST_CHUNK + 1.                                    *
+ * Assertions: the chunk holding the index has been allocated                 *
+ ******************************************************************************/
+static char *_element( ChunkedArray *array, long index )
+{
+    unsigned long slot;
+    int chunk;
+
+    slot = (unsigned long) index / ARRAY_FIRST_CHUNK + 1;
+    chunk = HIGHEST_BIT( slot );
+
+    return array->chunks[chunk] + ( index - ARRAY_FIRST_CHUNK *
+        ( ( 1L << chunk ) - 1 ) ) * (size_t) array->elementSize;
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * File:---- chunkedArray.h                                                   *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a generic growable array that stores its elements by     *
+ *           value in a few large blocks (chunks) instead of one allocation   *
+ *           per element.                                                     *
+ *           Declares functions for creating, appending to, reading, walking  *
+ *           and deleting chunked arrays.                                     *
+ ******************************************************************************/
+
+#ifndef CHUNKEDARRAY_H
+#define CHUNKEDARRAY_H
+
+#include <stdio.h>
+#include "linkedList.h"
+#include "arena.h"
+
+
+/******************************************************************************
+ * ARRAY_FIRST_CHUNK: the number of elements in the first chunk, a power of 2 *
+ * ARRAY_MAX_CHUNKS: the most chunks an array can have. Each chunk is twice   *
+ *                   the size of the one before it, so 32 chunks hold over    *
+ *                   34 billion elements, more turns than a log of hundreds   *
+ *                   of gigabytes has                                         *
+ ******************************************************************************/
+#define ARRAY_FIRST_CHUNK 8
+#define ARRAY_MAX_CHUNKS 32
+
+
+
+/******************************************************************************
+ * Struct: ChunkedArray                                                       *
+ * Purpose: holds elements of a fixed size, copied in by value. Chunk k has   *
+ *          room for ARRAY_FIRST_CHUNK << k elements, so an array of n        *
+ *          elements takes about log2( n / ARRAY_FIRST_CHUNK ) allocations,   *
+ *          elements never move once appended, and the chunk of any index     *
+ *          can be worked out directly.                                       *
+ * Consists of:                                                               *
+ *     chunks - the blocks of elements, in order                              *
+ *     elementSize - the size of each element in bytes                        *
+ *     size - the number of elements in the array                             *
+ *     numChunks - the number of chunks allocated so far                      *
+ *     arena - the arena the array and its chunks come from, NULL if they     *
+ *             are allocated with malloc                                      *
+ ******************************************************************************/
+typedef struct
+{
+    char *chunks[ARRAY_MAX_CHUNKS];
+    int elementSize;
+    long size;
+    int numChunks;
+    Arena *arena;
+} ChunkedArray;
+
+
+
+/******************************************************************************
+ * VisitFunc: type definition for a function pointer called by arrayForEach   *
+ *     with the caller's context, the data of an element and its index.       *
+ ******************************************************************************/
+typedef void ( *VisitFunc )( void*, void*, long );
+
+
+
+/* Function Prototypes */
+ChunkedArray *createArray( int, Arena* );
+void *arrayAppend( ChunkedArray*, void* );
+void *arrayGet( ChunkedArray*, long );
+void arrayForEach( ChunkedArray*, VisitFunc, void* );
+void printArray( FILE*, ChunkedArray*, PrintFunc );
+void freeArray( ChunkedArray* );
+
+#endif
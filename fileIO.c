@@ -8,11 +8,16 @@
  *           logs to another file.                                            *
  ******************************************************************************/
 
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "fileIO.h"
 #include "bool.h"
@@ -26,10 +31,12 @@
  *          settings - pointer to the game settings struct                    *
  * Returns: TRUE if an error occurred while reading the file                  *
  *          FALSE if the file was read sucessfully                            *
- * Exports: the three values in settings: width, height, matches              *
+ * Exports: the values in settings: width, height, matches, tableSize         *
  * Purpose: Attempts to read and validate the game settings from an external  *
  *          file. If successful, exports the values into a Settings struct    *
  *          and returns TRUE.                                                 *
+ *          M, N and K must be given, T (the transposition table size in MB)  *
+ *          is optional and defaults to DEFAULT_TABLE_SIZE.                   *
  ******************************************************************************/
 BOOL getSettings( char *fileName, Settings *settings )
 {
@@ -48,30 +55,41 @@ BOOL getSettings( char *fileName, Settings *settings )
     else
     {
         int lineCount;
-        int width, height, matches;
+        int width, height, matches, tableSize;
+        char format[16];
         lineCount = 0;
         width = 0;
         height = 0;
         matches = 0;
+        tableSize = 0;
+
+        /* read at most MAX_LINE_LEN - 1 characters of a setting name, and
+         * the character after them, which is only '=' if the name fit */
+        sprintf( format, "%%%d[^=]%%c%%d\n", MAX_LINE_LEN - 1 );
         
         /* start reading the input file */
         while ( !error && !feof( file ) && !ferror( file ) )
         {
-            char *setting;
-            int value;
-
-            setting = (char*) malloc( MAX_LINE_LEN * sizeof( char ) );
+            char setting[MAX_LINE_LEN];
+            char equals;
+            int value, read;
 
             /* try to read values from a line and check for correct format */
-            if ( fscanf( file, "%[^=]=%d\n", setting, &value ) != 2  )
+            read = fscanf( file, format, setting, &equals, &value );
+            if ( read >= 2 && equals != '=' )
+            {
+                printErr( "Setting name too long" );
+                error = TRUE;
+            }
+            else if ( read != 3 )
             {
                 printErr( "Invalid file format" );
                 error = TRUE;
             }
             else
             {
-                char *errString;
-                errString = calloc( MAX_ERR_STRING * sizeof( char ), 1 );
+                /* room for the message and the setting it is about */
+                char errString[MAX_ERR_STRING + MAX_LINE_LEN];
 
                 /* if format is correct, validate the setting */
                 if ( validSetting( setting, value )  )
@@ -88,6 +106,10 @@ BOOL getSettings( char *fileName, Settings *settings )
                     {
                         matches = value;
                     }
+                    else if ( tolower( setting[0] ) == 't' && tableSize == 0 )
+                    {
+                        tableSize = value;
+                    }
                     else
                     {
                         sprintf( errString, "Duplicate setting: %s", setting );
@@ -102,16 +124,14 @@ BOOL getSettings( char *fileName, Settings *settings )
                     printErr( errString );
                     error = TRUE;
                 }
-
-                free( errString );
             }
 
-            free( setting );
             lineCount++;
         }
 
-        /* if line count less than 3, then there are not enought settings */
-        if ( !error && lineCount < 3 )
+        /* if any of M, N or K is missing, there are not enough settings */
+        if ( !error && ( lineCount < 3 || width == 0 || height == 0 ||
+            matches == 0 ) )
         {
             printErr( "Not all 3 settings were provided" );
             error = TRUE;
@@ -129,6 +149,9 @@ BOOL getSettings( char *fileName, Settings *settings )
                 settings->width = width;
                 settings->height = height;
                 settings->matches = matches;
+                settings->tableSize =
+                    tableSize > 0 ? tableSize : DEFAULT_TABLE_SIZE;
+                settings->tableSet = tableSize > 0;
             }
         }
 
@@ -144,41 +167,66 @@ BOOL getSettings( char *fileName, Settings *settings )
  * Function: createLogFile                                                    *
  * Imports: settings of the current game                                      *
  *          pointer to a file name                                            *
- * Returns: pointer to an output file                                         *
+ *          format the log will be written in                                 *
+ * Returns: pointer to an output file, NULL if it could not be opened         *
  * Exports: name of the output file                                           *
  * Purpose: creates a log file based on the current date and time, as well as *
- *          the settings of the current game.                                 *
+ *          the settings of the current game. The extension of the file is    *
+ *          LOG_EXTENSION or BINLOG_EXTENSION depending on the format.        *
+ *          The name only changes once a minute, so if a file of that name    *
+ *          already exists the next free one of NAME_2, NAME_3 and so on is   *
+ *          used instead. Files are created exclusively, so an existing log   *
+ *          is never overwritten, even by another copy of the program.        *
  *                                                                            *
  * Based on information from:                                                 *
  * https://www.tutorialspoint.com/c_standard_library/c_function_localtime.htm *
  * (last accessed 26/10/2019)                                                 *
  ******************************************************************************/
-FILE *createLogFile( Settings *settings, char *fileName )
+FILE *createLogFile( Settings *settings, char *fileName, LogFormat format )
 {
     FILE *logFile;
     time_t currentTime;
     struct tm *timeStruct;
+    char *extension;
+    int length, copy, fd;
 
     /* get current time from the system and convert it to a readable struct */
     time( &currentTime );
     timeStruct = localtime( &currentTime );
 
     /* create a file name based on the current time and game settings */
-    sprintf( fileName, "MNK_%d-%d-%d_%02d-%02d_%02d-%02d.log",
+    length = sprintf( fileName, "MNK_%d-%d-%d_%02d-%02d_%02d-%02d",
         settings->width, settings->height, settings->matches,
         timeStruct->tm_hour, timeStruct->tm_min,
         timeStruct->tm_mday, timeStruct->tm_mon + 1 );
+    extension = format == LogBinary ? BINLOG_EXTENSION : LOG_EXTENSION;
+    strcpy( fileName + length, extension );
 
-    /* try to open the output file */
-    logFile = fopen( fileName, "w" );
+    /* try to create the output file, counting up until a name is free */
+    logFile = NULL;
+    fd = open( fileName, O_WRONLY | O_CREAT | O_EXCL, 0644 );
+    copy = 1;
+    while ( fd < 0 && errno == EEXIST && copy < LOG_MAX_COPIES )
+    {
+        copy++;
+        sprintf( fileName + length, "_%d%s", copy, extension );
+        fd = open( fileName, O_WRONLY | O_CREAT | O_EXCL, 0644 );
+    }
+
+    if ( fd >= 0 )
+    {
+        logFile = fdopen( fd, format == LogBinary ? "wb" : "w" );
+        if ( logFile == NULL )
+        {
+            close( fd );
+        }
+    }
 
     /* if successful, return the file pointer,
      * otherwise return NULL */
-    if ( ferror( logFile ) )
+    if ( logFile == NULL )
     {
         printErr( "Failed to open the output file" );
-        fclose( logFile );
-        logFile = NULL;
     }
 
     return logFile;
@@ -193,6 +241,7 @@ FILE *createLogFile( Settings *settings, char *fileName )
  *          FALSE otherwise                                                   *
  * Exports: none                                                              *
  * Purpose: ensures that the settings in the input file are valid             *
+ *          M, N and K can be 1 to MAX_DIMENSION, T 1 to MAX_TABLE_SIZE       *
  ******************************************************************************/
 BOOL validSetting( char *setting, int value )
 {
@@ -210,6 +259,10 @@ BOOL validSetting( char *setting, int value )
                 valid = TRUE;
             }
         }
+        else if ( ch == 't' && value > 0 && value <= MAX_TABLE_SIZE )
+        {
+            valid = TRUE;
+        }
     }
 
     return valid;
@@ -21,14 +21,19 @@
 #define MAX_LINE_LEN 50
 
 
-/* max log file name with all variables set to 2-digit numbers
- * (includes the null terminator) */
-#define LOG_NAME_LEN 29
+/* max log file name: "MNK_", M, N and K of up to MAX_DIGITS digits each
+ * and two dashes, a 12 character time stamp, a 4 character extension,
+ * a suffix of up to 5 characters that tells up to LOG_MAX_COPIES files
+ * with the same name apart, e.g. "_9999", and the null terminator */
+#define LOG_NAME_LEN ( 28 + 3 * MAX_DIGITS )
+#define LOG_MAX_COPIES 9999
+#define LOG_EXTENSION ".log"
+#define BINLOG_EXTENSION ".mnk"
 
 
 /* Function Prototypes */
 int getSettings( char*, Settings* );
-FILE *createLogFile( Settings*, char* );
+FILE *createLogFile( Settings*, char*, LogFormat );
 int validSetting( char*, int );
 
 #endif
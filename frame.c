@@ -0,0 +1,255 @@
+/******************************************************************************
+ * File:---- frame.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the frame declared in frame.h. A board drawn one      *
+ *           printf at a time costs a call per character and two pairs of     *
+ *           escape sequences per cell; composed in a frame it costs one      *
+ *           write, and only the escape sequences the picture needs.          *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "frame.h"
+#include "interface.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Make room in a frame and add single characters to it                       *
+ ******************************************************************************/
+static void _reserve( Frame*, long );
+static void _put( Frame*, char, BOOL );
+
+
+/******************************************************************************
+ * Function: createFrame                                                      *
+ * Imports: the number of bytes the frame is expected to need                 *
+ * Returns: pointer to a new, empty frame                                     *
+ * Purpose: sets up a frame with all of its room allocated up front, so that  *
+ *          composing a frame of the expected size never allocates            *
+ ******************************************************************************/
+Frame *createFrame( long capacity )
+{
+    Frame *frame;
+
+    frame = (Frame*) malloc( sizeof(Frame) );
+    frame->capacity = capacity > 0 ? capacity : 1;
+    frame->text = (char*) malloc( frame->capacity );
+    frame->length = 0;
+    frame->graphics = FALSE;
+    frame->colour = FRAME_NO_COLOUR;
+
+    return frame;
+}
+
+
+
+/******************************************************************************
+ * Function: frameText                                                        *
+ * Imports: frame - the frame, text - the text to add                         *
+ * Exports: none                                                              *
+ * Purpose: adds ordinary text to a frame                                     *
+ ******************************************************************************/
+void frameText( Frame *frame, char *text )
+{
+    while ( *text != '\0' )
+    {
+        _put( frame, *text, FALSE );
+        text++;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: frameBox                                                         *
+ * Imports: frame - the frame, box - a box-drawing character (see interface.h)*
+ * Exports: none                                                              *
+ * Purpose: adds a character of the DEC special graphics set to a frame       *
+ ******************************************************************************/
+void frameBox( Frame *frame, int box )
+{
+    _put( frame, (char) box, TRUE );
+}
+
+
+
+/******************************************************************************
+ * Function: frameNumber                                                      *
+ * Imports: frame - the frame, value - the number to add                      *
+ *          width - the width to right-align it in, as printf's "%*d"         *
+ * Exports: none                                                              *
+ * Purpose: adds a number to a frame                                          *
+ ******************************************************************************/
+void frameNumber( Frame *frame, int value, int width )
+{
+    char digits[32];
+
+    sprintf( digits, "%*d", width < 16 ? width : 16, value );
+    frameText( frame, digits );
+}
+
+
+
+/******************************************************************************
+ * Function: frameColour                                                      *
+ * Imports: frame - the frame                                                 *
+ *          colour - an ANSI colour code, FRAME_NO_COLOUR for the terminal's  *
+ * Exports: none                                                              *
+ * Purpose: makes the text added after it the given colour. Nothing is added  *
+ *          if the text is that colour already.                               *
+ ******************************************************************************/
+void frameColour( Frame *frame, int colour )
+{
+    char sequence[16];
+
+    if ( colour != frame->colour )
+    {
+        if ( colour == FRAME_NO_COLOUR )
+        {
+            frameEscape( frame, COL_RESET );
+        }
+        else
+        {
+            sprintf( sequence, "\x1b[%dm", colour );
+            frameEscape( frame, sequence );
+        }
+        frame->colour = colour;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: frameEscape                                                      *
+ * Imports: frame - the frame, sequence - an escape sequence                  *
+ * Exports: none                                                              *
+ * Purpose: adds an escape sequence to a frame as it is. Unlike frameText, it *
+ *          never switches the character set, which would split the sequence. *
+ ******************************************************************************/
+void frameEscape( Frame *frame, char *sequence )
+{
+    long length;
+
+    length = (long) strlen( sequence );
+    _reserve( frame, length );
+    memcpy( frame->text + frame->length, sequence, length );
+    frame->length += length;
+}
+
+
+
+/******************************************************************************
+ * Function: writeFrame                                                       *
+ * Imports: pointer to a frame                                                *
+ * Returns: TRUE if the frame could not be written, FALSE otherwise           *
+ * Purpose: puts the terminal back into ASCII and its own colour, then sends  *
+ *          the frame to it in a single write, after anything already printed *
+ *          through stdio. The frame is left empty for the next one.          *
+ ******************************************************************************/
+BOOL writeFrame( Frame *frame )
+{
+    long written, result;
+
+    frameColour( frame, FRAME_NO_COLOUR );
+    if ( frame->graphics )
+    {
+        frameEscape( frame, DRAW_END );
+        frame->graphics = FALSE;
+    }
+
+    fflush( stdout );
+    written = 0;
+    result = 0;
+    while ( written < frame->length && result >= 0 )
+    {
+        /* a terminal or pipe may take less than all of it at a time, and a
+         * signal may interrupt it before anything is written */
+        result = (long) write( STDOUT_FILENO, frame->text + written,
+            (size_t) ( frame->length - written ) );
+        if ( result > 0 )
+        {
+            written += result;
+        }
+        else if ( result < 0 && errno == EINTR )
+        {
+            result = 0;
+        }
+        else
+        {
+            /* nothing was taken, which would otherwise never end */
+            result = -1;
+        }
+    }
+    frame->length = 0;
+
+    return result < 0;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteFrame                                                      *
+ * Imports: pointer to a frame                                                *
+ * Exports: none                                                              *
+ * Purpose: frees a frame                                                     *
+ ******************************************************************************/
+void deleteFrame( Frame *frame )
+{
+    free( frame->text );
+    free( frame );
+}
+
+
+
+/******************************************************************************
+ * Function: _reserve                                                         *
+ * Imports: frame - the frame, bytes - the number of bytes about to be added  *
+ * Exports: none                                                              *
+ * Purpose: makes sure the frame has room for the bytes, doubling its room    *
+ *          as many times as it takes if not                                  *
+ ******************************************************************************/
+static void _reserve( Frame *frame, long bytes )
+{
+    if ( frame->length + bytes > frame->capacity )
+    {
+        while ( frame->length + bytes > frame->capacity )
+        {
+            frame->capacity *= 2;
+        }
+        frame->text = (char*) realloc( frame->text, frame->capacity );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _put                                                             *
+ * Imports: frame - the frame, ch - the character to add                      *
+ *          graphics - TRUE if ch is meant in the DEC special graphics set    *
+ * Exports: none                                                              *
+ * Purpose: adds a character, switching the character set first only if the   *
+ *          character is one the two sets draw differently. Spaces, digits,   *
+ *          X and O look the same in both, so a board can be drawn without    *
+ *          leaving the graphics set.                                         *
+ ******************************************************************************/
+static void _put( Frame *frame, char ch, BOOL graphics )
+{
+    if ( graphics != frame->graphics && ch >= FRAME_GRAPHICS_FIRST &&
+         ch <= FRAME_GRAPHICS_LAST )
+    {
+        frameEscape( frame, graphics ? DRAW_START : DRAW_END );
+        frame->graphics = graphics;
+    }
+    _reserve( frame, 1 );
+    frame->text[frame->length] = ch;
+    frame->length++;
+}
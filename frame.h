@@ -0,0 +1,65 @@
+/******************************************************************************
+ * File:---- frame.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a frame: a buffer that a whole screen of output is       *
+ *           composed in before it is sent to the terminal with one write.    *
+ *           The frame remembers the character set and colour the terminal    *
+ *           is left in, so their escape sequences are only added when they   *
+ *           actually change.                                                 *
+ *           Declares functions to add text, box-drawing characters, numbers, *
+ *           colours and escape sequences to a frame, and to write it out.    *
+ ******************************************************************************/
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include "bool.h"
+
+
+/******************************************************************************
+ * FRAME_GRAPHICS_FIRST, FRAME_GRAPHICS_LAST: the range of characters that    *
+ *     the DEC special graphics set draws differently from ASCII. Any other   *
+ *     character looks the same in either set, so it never needs a switch.    *
+ * FRAME_NO_COLOUR: the colour of a frame's text before any colour is set     *
+ ******************************************************************************/
+#define FRAME_GRAPHICS_FIRST 0x5f
+#define FRAME_GRAPHICS_LAST  0x7e
+#define FRAME_NO_COLOUR 0
+
+
+
+/******************************************************************************
+ * Frame: A struct that holds a frame being composed.                         *
+ * Consists of:                                                               *
+ *     text - the bytes of the frame                                          *
+ *     length - the number of bytes in the frame                              *
+ *     capacity - the number of bytes text has room for                       *
+ *     graphics - TRUE if the terminal will be in the DEC special graphics    *
+ *                set at the end of the frame so far                          *
+ *     colour - the ANSI colour code the text so far ends in, FRAME_NO_COLOUR *
+ *              for the terminal's own                                        *
+ ******************************************************************************/
+typedef struct
+{
+    char *text;
+    long length;
+    long capacity;
+    BOOL graphics;
+    int colour;
+} Frame;
+
+
+
+/* Function Prototypes */
+Frame *createFrame( long );
+void frameText( Frame*, char* );
+void frameBox( Frame*, int );
+void frameNumber( Frame*, int, int );
+void frameColour( Frame*, int );
+void frameEscape( Frame*, char* );
+BOOL writeFrame( Frame* );
+void deleteFrame( Frame* );
+
+#endif
@@ -6,13 +6,135 @@
  * Purpose:- Defines a set of functions that control the gameplay
  ******************************************************************************/
 
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 
 #include "game.h"
+#include "player.h"
 #include "interface.h"
 #include "fileIO.h"
+#include "asyncLog.h"
+#include "rollingLog.h"
 #include "bool.h"
+#include "bits.h"
+
+
+/******************************************************************************
+ * DIRECTIONS: the x and y steps of each line direction, in window order:     *
+ *             horizontal, vertical, descending and rising diagonals          *
+ ******************************************************************************/
+static const int DIRECTIONS[NUM_DIRECTIONS][2] =
+{
+    { 1,  0 },
+    { 0,  1 },
+    { 1,  1 },
+    { 1, -1 }
+};
+
+
+
+/******************************************************************************
+ * SYMMETRIES: each symmetry of the board as three steps applied to a cell in *
+ *             order: swap x and y, reflect x, reflect y. The first four keep *
+ *             the board's shape, the last four only apply to square boards   *
+ ******************************************************************************/
+static const int SYMMETRIES[MAX_SYMMETRIES][3] =
+{
+    { 0, 0, 0 },
+    { 0, 1, 0 },
+    { 0, 0, 1 },
+    { 0, 1, 1 },
+    { 1, 0, 0 },
+    { 1, 1, 0 },
+    { 1, 0, 1 },
+    { 1, 1, 1 }
+};
+
+
+
+/******************************************************************************
+ * ZOBRIST_SEED: seed of the generator that makes the Zobrist keys            *
+ ******************************************************************************/
+#define ZOBRIST_SEED 0x2545F4914F6CDD1DUL
+
+
+
+/******************************************************************************
+ * BoardTables: A struct that holds the tables of a board that only depend on *
+ *              its width and height. They are made once for each size and    *
+ *              shared, read-only, by every board of that size in every       *
+ *              thread, rather than being made again for each new board.      *
+ * Consists of:                                                               *
+ *     width, height - the size of the boards the tables are for              *
+ *     zobrist - the Zobrist keys, laid out as in GameBoard                   *
+ *     numSymmetries, symmetry, inverse - the symmetries, as in GameBoard.    *
+ *                                        inverse shares symmetry's block     *
+ ******************************************************************************/
+typedef struct
+{
+    int width;
+    int height;
+    unsigned long *zobrist;
+    int numSymmetries;
+    int *symmetry;
+    int *inverse;
+} BoardTables;
+
+
+
+/******************************************************************************
+ * sharedTables: the BoardTables of every board size made so far. They last   *
+ *               until the program exits, as boards from an arena are never   *
+ *               deleted one by one, so there is no last board to free them   *
+ * tablesLock: taken while sharedTables is searched or added to               *
+ ******************************************************************************/
+static LinkedList *sharedTables = NULL;
+static pthread_mutex_t tablesLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+
+/******************************************************************************
+ * SPARSE_HASH: the multiplier that spreads the cells of a sparse board over  *
+ *              its hash table, 2^64 divided by the golden ratio              *
+ ******************************************************************************/
+#define SPARSE_HASH 0x9E3779B97F4A7C15UL
+
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Win checks, window bookkeeping, board allocation and log printing          *
+ * helpers, only used by the functions in game.c                              *
+ ******************************************************************************/
+static BOOL _check_win_scalar( GameBoard*, TicTacTile, int, int );
+static BOOL _check_win_sparse( GameBoard*, TicTacTile, int, int );
+#ifndef Scalar
+static BOOL _check_win_words( GameBoard*, TicTacTile, int, int );
+#endif
+static BOOL _valid_window( GameBoard*, int, int, int );
+static int _window_index( GameBoard*, int, int, int );
+static int _window_total( unsigned char* );
+static void _update_windows( GameBoard*, TicTacTile, int, int, int );
+static void _flip_tile( GameBoard*, TicTacTile, int, int );
+#ifndef Secret
+static void _append_log( ChunkedArray*, RollingLog* );
+#endif
+static void _board_init( GameBoard*, Settings*, Arena* );
+static void _dense_init( GameBoard*, Settings*, Arena* );
+static void _sparse_init( GameBoard*, Settings* );
+static void *_board_alloc( Arena*, size_t );
+static BoardTables *_board_tables( Settings* );
+static int _sparse_home( GameBoard*, int );
+static SparseCell *_sparse_slot( GameBoard*, int );
+static void _sparse_alloc( GameBoard*, int );
+static BOOL _sparse_place( GameBoard*, TicTacTile, int );
+static void _sparse_remove( GameBoard*, SparseCell* );
+static BitWord _near_rows( GameBoard*, int, int, int );
+
 
 
 /******************************************************************************
@@ -38,34 +160,75 @@ const char* MENU_ITEMS[] =
 /******************************************************************************
  * Function: gameLoop                                                         *
  * Imports: pointer to a GameSettings struct                                  *
- * Exports: none                                                              *
+ *          array of move sources, indexed by TicTacTile                      *
+ *          how the logs are saved                                            *
+ * Returns: TRUE if the logs could not all be saved on Exit, FALSE otherwise  *
  * Purpose: The main gameplay function, determines the next gamestate based   *
  *          on user input in the main menu.                                   *
  *          Prompts the user for a choice based on the pre-defined set of     *
  *          menu items and their enumerated values. Keeps prompting until     *
  *          the user chooses the Exit option.                                 *
+ *          When logs are saved in the background, each game is queued for    *
+ *          the writer thread as soon as it is over, and the writer is        *
+ *          flushed and stopped on Exit. When saves append, the menu adds     *
+ *          the games played since the last save to a rolling log that is     *
+ *          closed on Exit.                                                   *
  ******************************************************************************/
-void gameLoop( Settings *gameSettings )
+BOOL gameLoop( Settings *gameSettings, MoveSource **players,
+    LogOptions *logOptions )
 {
+    BOOL error;
     GameState gameState;
-    LinkedList *gameLogList;
-
-    gameLogList = createList( );
+    ChunkedArray *gameLogs;
+    GameLog *gameLog;
+    Arena *logArena, *gameArena;
+    AsyncLog *autoSave;
+    RollingLog *savedLog;
+
+    /* the logs last until the program exits, everything else in a game
+     * only lasts until the game is over */
+    logArena = createArena( ARENA_BLOCK_SIZE );
+    gameArena = createArena( ARENA_BLOCK_SIZE );
+    gameLogs = createArray( sizeof(GameLog), logArena );
+
+    /* the logs live in the arena until the writer has been stopped, so the
+     * writer has nothing to free */
+    autoSave = NULL;
+    savedLog = NULL;
+    error = FALSE;
+    #ifndef Secret
+    if ( logOptions->background )
+    {
+        autoSave = createAsyncLog( gameSettings, logOptions, NULL );
+    }
+    if ( logOptions->append )
+    {
+        savedLog = createRollingLog( gameSettings, logOptions->format,
+            logOptions->maxBytes );
+    }
+    #endif
 
     /* get a new gamestate from the user and keep running until
 	 * the user chooses to exit */
 	do
 	{
-	    GameLog *newLog;
-	
 	    gameState = menuSelection( "MAIN MENU", MENU_ITEMS, (int) Exit );
 	
 	    /* choose next interface based on the current gamestate */
 	    switch ( gameState )
 	    {
 	        case NewGame:
-	            newLog = playGame( gameSettings );
-	            listInsertLast( gameLogList, (void*) newLog );
+	            /* the settings may have been edited since the start */
+	            if ( !denseOnlyPlayers( gameSettings,
+	                     players[TicTacX]->name, players[TicTacO]->name ) )
+	            {
+	                gameLog = playGame( gameSettings, players, gameLogs,
+	                    gameArena );
+	                if ( autoSave != NULL )
+	                {
+	                    asyncLogGame( autoSave, gameLog );
+	                }
+	            }
 	            enterToContinue( );
 	            break;
 	
@@ -80,16 +243,32 @@ void gameLoop( Settings *gameSettings )
 	            break;
 	
 	        case ViewLog:
-	            displayLog( gameLogList, gameSettings );
+	            displayLog( gameLogs, gameSettings );
 	            break;
 	
 	        #ifndef Secret
 	        case SaveLog:
-	            saveLog( gameLogList, gameSettings );
+	            if ( savedLog != NULL )
+	            {
+	                _append_log( gameLogs, savedLog );
+	            }
+	            else
+	            {
+	                saveLog( gameLogs, gameSettings, logOptions->format );
+	            }
 	            break;
 	        #endif
 	
 	        case Exit:
+	            if ( autoSave != NULL )
+	            {
+	                error = closeAsyncLog( autoSave );
+	            }
+	            if ( savedLog != NULL && closeRollingLog( savedLog ) )
+	            {
+	                printErr( "Failed to write the logs to the output file" );
+	                error = TRUE;
+	            }
 	            printf( "Goodbye\n" );
 	            break;
 	
@@ -100,7 +279,10 @@ void gameLoop( Settings *gameSettings )
 	while ( gameState != Exit );
     
     /* clean up */
-    freeList( gameLogList, &deleteGameLog );
+    deleteArena( gameArena );
+    deleteArena( logArena );
+
+    return error;
 }
 
 
@@ -108,74 +290,114 @@ void gameLoop( Settings *gameSettings )
 /******************************************************************************
  * Function: playGame                                                         *
  * Imports: pointer to current game settings                                  *
- * Exports: pointer to a new game log                                         *
+ *          array of move sources, indexed by TicTacTile                      *
+ *          array of game logs that the new game is added to                  *
+ *          arena for the memory that is only needed during the game          *
+ * Returns: pointer to the new game log, inside the array of game logs        *
  * Purpose: This function starts a new game and plays it turn by turn until   *
  *          one of the players wins or all tiles are filled in an unwinnable  *
  *          way. Every turn is logged and saved into a GameLog struct, which  *
- *          is then returned to the calling function.                         *
+ *          is added to the array of game logs.                               *
+ *          Each player's moves come from their move source, moves made by    *
+ *          the computer are printed so the user can follow the game.         *
+ *          The board is allocated from the game arena, which is reset once   *
+ *          the game is over, and the turns from the arena of the logs.       *
+ *          After each move only the changed cells of the board on the screen *
+ *          are drawn again, see showGameBoard. A board too big for the       *
+ *          terminal is shown in a window that follows the moves.             *
  ******************************************************************************/
-GameLog *playGame( Settings *settings )
+GameLog *playGame( Settings *settings, MoveSource **players,
+    ChunkedArray *gameLogs, Arena *gameArena )
 {
-    GameLog *gameLog;
+    GameLog newLog, *gameLog;
     GameBoard *gameBoard;
+    BoardView *view;
     TicTacTile currentPlayer;
     int turnNum;
     BOOL finished;
 
-    /* Initialize all gameplay variables */
+    /* Initialize all gameplay variables, elements of the array never move
+     * so the log can be filled in after it is added */
     currentPlayer = TicTacX;
-    gameLog = (GameLog*) malloc( sizeof(GameLog) );
+    gameLog = (GameLog*) arrayAppend( gameLogs, &newLog );
     #ifdef Editor
     gameLog->settings = *settings;
     #endif
-    gameLog->turnList = createList( );
-    gameBoard = (GameBoard*) malloc( sizeof(GameBoard) );
-    boardInit( gameBoard, settings );
+    gameLog->turnList = createArray( sizeof(TurnLog), gameLogs->arena );
+    gameLog->winner = TicTacNone;
+    gameBoard = boardCreate( settings, gameArena );
     finished = FALSE;
 
     /* draw the game board and start playing */
     turnNum = 1;
-    clearScreen( );
-    drawGameBoard( gameBoard );
+    view = createBoardView( );
+    setBoardView( players[TicTacX], view );
+    setBoardView( players[TicTacO], view );
+    showGameBoard( view, gameBoard );
     while ( !finished )
     {
-        TurnLog *log;
+        TurnLog log;
         Coordinates newTile;
+        MoveSource *player;
 
         /* get a new tile from the player and place it on the board */
         printf( "Player %d's turn\n", ( int ) currentPlayer );
-        newTile = getCoordinates( "Place a tile (x,y): ",
-            settings->width, settings->height );
+        player = players[currentPlayer];
+        newTile = player->getMove( gameBoard, currentPlayer, player->state );
 
         if ( placeTile( gameBoard, currentPlayer, newTile.x, newTile.y ) )
         {
-            log = (TurnLog*) malloc( sizeof(TurnLog) );
-            log->turnNum = turnNum;
-            log->player = currentPlayer;
-            log->location = newTile;
-            listInsertLast( gameLog->turnList, (void*) log );
+            log.turnNum = turnNum;
+            log.player = currentPlayer;
+            log.location = newTile;
+            arrayAppend( gameLog->turnList, &log );
+
+            followBoardView( view, newTile );
+            showGameBoard( view, gameBoard );
+            if ( !isHuman( player ) )
+            {
+                printf( "Player %d (%s) played %d,%d\n", (int) currentPlayer,
+                    player->name, newTile.x, newTile.y );
+                if ( player->printStats != NULL )
+                {
+                    player->printStats( stdout, player->state );
+                }
+            }
 
-            clearScreen( );
-            drawGameBoard( gameBoard );
-            
             /* check if the player has won, if not check for a draw */
             if ( checkWin( gameBoard, currentPlayer, newTile.x, newTile.y ) )
             {
                 finished = TRUE;
+                gameLog->winner = currentPlayer;
                 printf( "Player %d has won!\n", currentPlayer );
             }
             else if ( checkDraw( gameBoard ) )
             {
                 finished = TRUE;
-                printf( "All tiles are taken, this is a draw!\n" );
+                if ( gameBoard->emptyCount == 0 )
+                {
+                    printf( "All tiles are taken, this is a draw!\n" );
+                }
+                else
+                {
+                    printf( "Nobody can get %d in a row anymore, "
+                            "this is a draw!\n", settings->matches );
+                }
             }
             changePlayer( &currentPlayer );
             turnNum++;
         }
+        else
+        {
+            printErr( "These coordinates are already taken!" );
+        }
     }
 
-    /* clean up */
-    deleteGameBoard( gameBoard );
+    /* clean up, which frees the board */
+    setBoardView( players[TicTacX], NULL );
+    setBoardView( players[TicTacO], NULL );
+    deleteBoardView( view );
+    arenaReset( gameArena );
 
     return gameLog;
 }
@@ -195,7 +417,7 @@ void editSettings( Settings *settings )
 {
     displaySettings( settings );
 
-    printf( "!! ALL SETTINGS MUST BE BETWEEN 1 AND 99 !!\n" );
+    printf( "!! ALL SETTINGS MUST BE BETWEEN 1 AND %d !!\n", MAX_DIMENSION );
     do
     {
         printf("\n");
@@ -248,15 +470,17 @@ void displaySettings( Settings *settings )
 {
     printf( "\nThe game's settings are:\n\n"
            "  Board size: %dx%d\n"
-           "  Win condition: %d tiles in a row\n\n",
-           settings->width, settings->height, settings->matches );
+           "  Win condition: %d tiles in a row\n"
+           "  Transposition table: %d MB\n\n",
+           settings->width, settings->height, settings->matches,
+           settings->tableSize );
 }
 
 
 
 /******************************************************************************
  * Function: displayLog                                                       *
- * Imports: pointer to a list of game logs                                    *
+ * Imports: pointer to an array of game logs                                  *
  *          pointer to the current settings struct                            *
  * Exports: none                                                              *
  * Purpose: prints the contents of the game log to the user using the         *
@@ -264,10 +488,8 @@ void displaySettings( Settings *settings )
  *          If Editor is enabled, prints the settings of each individual game,*
  *          otherwise prints the current settings at the start                *
  ******************************************************************************/
-void displayLog( LinkedList *logList, Settings *settings )
+void displayLog( ChunkedArray *gameLogs, Settings *settings )
 {
-    int i;
-
     printf( "\n" );
 
     /* print settings first if editor is disabled */
@@ -280,13 +502,7 @@ void displayLog( LinkedList *logList, Settings *settings )
     #endif
 
     /* print each game log one by one */
-    for ( i = 0; i < logList->size; i++ )
-    {
-        printf( "##################\n"
-                "###   GAME %2d  ###\n"
-                "##################\n", i + 1 );
-        printElement( stdout, logList, i, &printGameLog );
-    }
+    arrayForEach( gameLogs, &printGame, stdout );
 
     printf( "\n" );
 }
@@ -295,51 +511,93 @@ void displayLog( LinkedList *logList, Settings *settings )
 
 /******************************************************************************
  * Function: saveLog                                                          *
- * Imports: pointer to a list of game logs                                    *
+ * Imports: pointer to an array of game logs                                  *
  *          pointer to the current settings struct                            *
+ *          format to save the logs in                                        *
  * Exports: none                                                              *
  * Purpose: writes the contents of the game log into an external file which   *
  *          is named based on the current date, time and game settings.       *
- *          Format is identical to the displayLog function.                   *
+ *          The text format is identical to the displayLog function, the      *
+ *          binary format is streamed through a LogWriter, see binaryLog.h.   *
+ *          The file is written as a rolling log that is never rotated, so it *
+ *          gets an index of its games like every other log.                  *
  ******************************************************************************/
-void saveLog( LinkedList *logList, Settings *settings)
+void saveLog( ChunkedArray *gameLogs, Settings *settings, LogFormat format )
 {
-    int i;
-    char *fileName;
-    FILE *outFile;
+    char fileName[LOG_NAME_LEN];
+    RollingLog *outLog;
+    BOOL error, saved;
 
-    fileName = (char*) malloc( LOG_NAME_LEN * sizeof(char) );
-    outFile = createLogFile( settings, fileName );
-
-    /* virtually same code as displayLog */
-    #ifndef Editor
-    fprintf( outFile, "SETTINGS:\n"
-                      "  M: %d\n"
-                      "  N: %d\n"
-                      "  K: %d\n\n",
-                      settings->width, settings->height, settings->matches );
-    #endif
+    outLog = createRollingLog( settings, format, 0 );
+    error = appendGameLogs( outLog, gameLogs );
+    saved = outLog->files > 0;
+    strcpy( fileName, outLog->fileName );
+    error = closeRollingLog( outLog ) || error;
 
-    for ( i = 0; i < logList->size; i++ )
+    if ( error )
     {
-        fprintf( outFile, "##################\n"
-                          "###   GAME %2d  ###\n"
-                          "##################\n", i + 1 );
-        printElement( outFile, logList, i, &printGameLog );
+        printErr( "Failed to write the logs to the output file\n" );
     }
-
-    if ( !ferror( outFile ) )
+    else if ( !saved )
+    {
+        printf( "\nThere are no games to save\n\n" );
+    }
+    else
     {
         printf( "\nGame logs have been saved to %s\n\n", fileName );
     }
+}
+
+
+
+#ifndef Secret
+/******************************************************************************
+ * Function: _append_log                                                      *
+ * Imports: pointer to an array of game logs                                  *
+ *          pointer to the session's rolling log                              *
+ * Exports: none                                                              *
+ * Purpose: the append mode of saveLog. Writes only the games played since    *
+ *          the last save to the end of the rolling log, so that saving costs *
+ *          the same however long the session has been going.                 *
+ ******************************************************************************/
+static void _append_log( ChunkedArray *gameLogs, RollingLog *savedLog )
+{
+    int saved;
+
+    saved = savedLog->saved;
+    if ( appendGameLogs( savedLog, gameLogs ) )
+    {
+        printErr( "Failed to write the logs to the output file" );
+    }
+    else if ( savedLog->saved == saved )
+    {
+        printf( "\nThere are no new games to save\n\n" );
+    }
     else
     {
-        printErr( "Failed to write the logs to the output file\n" );
+        printf( "\n%d new games have been saved to %s\n\n",
+            savedLog->saved - saved, savedLog->fileName );
     }
+}
+#endif
 
-    /* clean up */
-    free(fileName);
-    fclose(outFile);
+
+
+/******************************************************************************
+ * Function: printGame                                                        *
+ * Imports: output stream, pointer to a game log, index of the game           *
+ * Exports: none                                                              *
+ * Purpose: prints the numbered banner of a game followed by its log. Used    *
+ *          with arrayForEach by displayLog and saveLog, so that the whole    *
+ *          log is written in one pass over the array, and by the background  *
+ *          writer for one game at a time.                                    *
+ ******************************************************************************/
+void printGame( void *stream, void *log, long index )
+{
+    fprintf( (FILE*) stream, "##################\n"
+                             "###   GAME %2ld  ###\n"
+                             "##################\n", index + 1 );
+    printGameLog( (FILE*) stream, log );
 }
 
 
@@ -351,303 +609,1370 @@ void saveLog( LinkedList *logList, Settings *settings)
  * Exports: sets the values of all the board's fields                         *
  * Purpose: allocates memory for a new gameboard and sets the values of all   *
  *          cells to empty.                                                   *
+ *          The occupied bitboard and one bitboard per player are allocated   *
+ *          as a single zeroed block, with each row padded to a whole number  *
+ *          of words.                                                         *
+ *          Every window that fits on the board starts out open for both      *
+ *          players.                                                          *
+ *          The Zobrist keys come from a fixed seed, so boards of the same    *
+ *          size always give a position the same hash.                        *
+ *          The symmetries are tabulated once per cell, so that the hash of   *
+ *          every symmetric copy of the board can be updated move by move.    *
+ *          A sparse board only gets an empty hash table, see isSparse.       *
  ******************************************************************************/
 void boardInit( GameBoard *board, Settings *settings )
 {
-    int i, j;
+    _board_init( board, settings, NULL );
+}
 
-    board->settings = settings;
 
-    /* allocate memory for each row */
-    board->tiles = (TicTacTile**) malloc(
-        board->settings->height * sizeof( TicTacTile* ) );
 
-    /* allocate memory for each column and set all values to empty tile */
-    for ( i = 0; i < board->settings->height; i++ )
-    {
-        board->tiles[i] = (TicTacTile*) malloc(
-            board->settings->width * sizeof( TicTacTile ) );
+/******************************************************************************
+ * Function: boardCreate                                                      *
+ * Imports: pointer to a Settings struct                                      *
+ *          arena to allocate the board from                                  *
+ * Returns: pointer to a new, empty game board                                *
+ * Purpose: makes a board whose struct and arrays all come from the arena, so *
+ *          that it is freed in constant time when the arena is reset. Such a *
+ *          board must not be passed to deleteGameBoard.                      *
+ ******************************************************************************/
+GameBoard *boardCreate( Settings *settings, Arena *arena )
+{
+    GameBoard *board;
 
-        for ( j = 0; j < board->settings->width; j++ )
-        {
-            board->tiles[i][j] = TicTacNone;
-        }
-    }
+    board = (GameBoard*) arenaAlloc( arena, sizeof(GameBoard) );
+    _board_init( board, settings, arena );
+
+    return board;
 }
 
 
 
 /******************************************************************************
- * Function: placeTile                                                        *
+ * Function: isSparse                                                         *
+ * Imports: pointer to a Settings struct                                      *
+ * Returns: TRUE if a board with these settings is sparse, FALSE otherwise    *
+ * Purpose: the bitboards, window counts, keys and symmetry tables of a board *
+ *          all grow with its area, which is fine up to DENSE_DIMENSION but   *
+ *          would take gigabytes at 10,000x10,000. A sparse board only keeps  *
+ *          the tiles that have been placed, in a hash table, so placing a    *
+ *          tile and checking for a win take O(K) whatever the board's size.  *
+ *          The computer players need the window counts, so they can only     *
+ *          play on boards that are not sparse.                               *
+ ******************************************************************************/
+BOOL isSparse( Settings *settings )
+{
+    return settings->width > DENSE_DIMENSION ||
+           settings->height > DENSE_DIMENSION ||
+           settings->matches > DENSE_DIMENSION;
+}
+
+
+
+/******************************************************************************
+ * Function: _board_init                                                      *
  * Imports: pointer to a GameBoard struct                                     *
- *          tile variable representing the current player                     *
- *          x and y coordinates of the new tile                               *
- * Returns: TRUE if the tile was placed on the board                          *
- *          FALSE if the could not be placed                                  *
- * Exports: none                                                              *
- * Purpose: attempts to place a new tile onto the game board.                 *
- *          If the spot is already taken, notifies the user and returns FALSE.*
+ *          pointer to a Settings struct                                      *
+ *          arena to allocate from, NULL to use malloc                        *
+ * Exports: sets the values of all the board's fields                         *
+ * Purpose: does the work of boardInit and boardCreate                        *
  ******************************************************************************/
-BOOL placeTile( GameBoard *board, TicTacTile tile, int x, int y )
+static void _board_init( GameBoard *board, Settings *settings, Arena *arena )
 {
-    BOOL valid;
-    valid = FALSE;
+    board->settings = settings;
+    board->sparse = isSparse( settings );
+    board->cells = NULL;
+    board->numSlots = 0;
+    board->arena = arena;
 
-    /* ensure the tile is in a valid range */
-    if ( x >= 0 && x < board->settings->width &&
-        y >= 0 && y < board->settings->height )
+    if ( board->sparse )
     {
-        /* if there is no other tile at the coordinates, place it */
-        if ( board->tiles[y][x] == TicTacNone )
-        {
-            board->tiles[y][x] = tile;
-            valid = TRUE;
-        }
-        else
-        {
-            printErr( "These coordinates are already taken!" );
-        }
+        _sparse_init( board, settings );
+    }
+    else
+    {
+        _dense_init( board, settings, arena );
     }
 
-    return valid;
+    boardReset( board );
 }
 
 
 
 /******************************************************************************
-* Function: checkWin                                                          *
-* Imports: pointer to a GameBoard struct                                      *
-*          tile representing the current player                               *
-*          x and y coordinates of the newest tile                             *
-* Returns: TRUE if the current player has won the game                        *
-*          FALSE otherwise                                                    *
-* Exports: none                                                               *
-* Purpose: This function checks if the current player has won the game by     *
-*          scanning the tiles in 8 direcions from the tile they had just      *
-*          placed.                                                            *
-*          It validates the win by counting the number of relevant tiles in a *
-*          row in each main direction (horizontal, vertical, and diagonals).  *
-*          counting stops once an unwanted tile is found.                     *
-*          Directions to be checked are as follows:                           *
-*               (1, 0) - horizontal                                           *
-*               (0, 1) - vertical                                             *
-*               (1, 1) - desceding diagonal                                   *
-*               (1,-1) - rising diagonal                                      *
-******************************************************************************/
-BOOL checkWin( GameBoard *board, TicTacTile tile, int x, int y )
+ * Function: _dense_init                                                      *
+ * Imports: pointer to a GameBoard struct                                     *
+ *          pointer to a Settings struct                                      *
+ *          arena to allocate from, NULL to use malloc                        *
+ * Exports: allocates and fills in the bitboards and tables of the board      *
+ * Purpose: sets up a board that is not sparse                                *
+ ******************************************************************************/
+static void _dense_init( GameBoard *board, Settings *settings, Arena *arena )
 {
-    BOOL won = FALSE;
-    int count;
+    int i, boardWords, windows, dir, spanX, spanY;
+    BoardTables *tables;
+
+    board->rowWords = ( settings->width + WORD_BITS - 1 ) / WORD_BITS;
+    boardWords = board->rowWords * settings->height;
+
+    /* one bitboard for the occupied cells followed by one for each player */
+    board->numWords = boardWords * TicTacTotal;
+    board->occupied = (BitWord*) _board_alloc( arena,
+        board->numWords * sizeof( BitWord ) );
 
-    /* check column */
-    count = checkDirection( board, tile, x, y, 1, 0 );
-    if ( count >= board->settings->matches )
+    board->tiles[TicTacNone] = NULL;
+    for ( i = TicTacX; i < TicTacTotal; i++ )
     {
-        won = TRUE;
+        board->tiles[i] = board->occupied + boardWords * i;
     }
 
-    /* check row */
-    if ( !won )
+    /* only windows that fit on the board get counts, direction by direction
+     * in the order of DIRECTIONS, row by row within a direction */
+    windows = 0;
+    for ( dir = 0; dir < NUM_DIRECTIONS; dir++ )
     {
-        count = checkDirection( board, tile, x, y, 0, 1 );
-        if ( count >= board->settings->matches )
-        {
-            won = TRUE;
-        }
+        spanX = settings->width -
+            DIRECTIONS[dir][0] * ( settings->matches - 1 );
+        spanY = settings->height - ( DIRECTIONS[dir][1] != 0 ) *
+            ( settings->matches - 1 );
+        board->windowStart[dir] = windows;
+        windows += spanX * spanY;
     }
+    board->numWindows = windows;
+    board->lineCounts = (unsigned char*) _board_alloc( arena,
+        windows * WINDOW_PLAYERS * sizeof( unsigned char ) );
+
+    tables = _board_tables( settings );
+    board->zobrist = tables->zobrist;
+    board->numSymmetries = tables->numSymmetries;
+    board->symmetry = tables->symmetry;
+    board->inverse = tables->inverse;
+}
+
+
+
+/******************************************************************************
+ * Function: _sparse_init                                                     *
+ * Imports: pointer to a GameBoard struct                                     *
+ *          pointer to a Settings struct                                      *
+ * Exports: gives the board an empty hash table, and no bitboards or tables   *
+ * Purpose: sets up a sparse board. The windows are counted per direction     *
+ *          without visiting them, as there can be billions.                  *
+ ******************************************************************************/
+static void _sparse_init( GameBoard *board, Settings *settings )
+{
+    long spanX, spanY, windows;
+    int i, dir;
 
-    /* check diagonal (top-down) */
-    if ( !won )
+    board->rowWords = 0;
+    board->occupied = NULL;
+    for ( i = TicTacNone; i < TicTacTotal; i++ )
     {
-        count = checkDirection( board, tile, x, y, 1, 1 );
-        if ( count >= board->settings->matches )
-        {
-            won = TRUE;
-        }
+        board->tiles[i] = NULL;
     }
-
-    /* check diagonal (bottom-up) */
-    if ( !won )
+    for ( dir = 0; dir < NUM_DIRECTIONS; dir++ )
     {
-        count = checkDirection( board, tile, x, y, 1, -1 );
-        if ( count >= board->settings->matches )
-        {
-            won = TRUE;
-        }
+        board->windowStart[dir] = 0;
     }
+    board->lineCounts = NULL;
+    board->zobrist = NULL;
+    board->numSymmetries = 1;
+    board->symmetry = NULL;
+    board->inverse = NULL;
+    board->numWords = 0;
+
+    /* the window starts along each direction, kept within an int as only
+     * whether there are any matters to checkDraw */
+    spanX = settings->width - settings->matches + 1;
+    spanY = settings->height - settings->matches + 1;
+    spanX = spanX > 0 ? spanX : 0;
+    spanY = spanY > 0 ? spanY : 0;
+    windows = spanX * settings->height + spanY * settings->width +
+        2 * spanX * spanY;
+    board->numWindows = windows < INT_MAX ? (int) windows : INT_MAX;
+
+    _sparse_alloc( board, SPARSE_MIN_SLOTS );
+}
 
-    return won;
+
+
+/******************************************************************************
+ * Function: _board_alloc                                                     *
+ * Imports: arena to allocate from, NULL to use malloc, number of bytes       *
+ * Returns: pointer to the memory                                             *
+ ******************************************************************************/
+static void *_board_alloc( Arena *arena, size_t size )
+{
+    return arena != NULL ? arenaAlloc( arena, size ) : malloc( size );
 }
 
 
 
 /******************************************************************************
- * Function: checkDirection                                                   *
- * Imports: pointer to a game board                                           *
- *          tile representing a current player                                *
- *          x and y coordinates of the new tile                               *
- *          x and y increments for the scanner                                *
- * Returns: number of relevant tiles in a row in the specified direction      *
- * Purpose: counts the number of tiles along a straight line.                 *
- *          Starts at the specified point and moves along a straight line     *
- *          until aninvalid tile, then returns to the staring point and       *
- *          moves in the opposite direction.                                  *
+ * Function: _board_tables                                                    *
+ * Imports: pointer to the settings of a board that is not sparse             *
+ * Returns: pointer to the shared tables for boards of that width and height  *
+ * Purpose: looks the tables up, and makes them the first time a board of     *
+ *          that size is set up. Boards of the same size in different threads *
+ *          get the same keys, as the generator always starts from            *
+ *          ZOBRIST_SEED.                                                     *
  ******************************************************************************/
-int checkDirection( GameBoard *board, TicTacTile tile, int x, int y,
-    int xStep, int yStep )
+static BoardTables *_board_tables( Settings *settings )
 {
-    int counter, i, j;
-    TicTacTile currentTile = TicTacNone;
+    BoardTables *tables;
+    ListNode *node;
+    unsigned long seed;
+    int i, x, y, s, sx, sy, area;
 
-    /* scan along the specified direction until an unwanted tile is found */
-    counter = 0;
-    i = y;
-    j = x;
-    do
+    pthread_mutex_lock( &tablesLock );
+    if ( sharedTables == NULL )
+    {
+        sharedTables = createList( );
+    }
+
+    tables = NULL;
+    node = sharedTables->head;
+    while ( tables == NULL && node != NULL )
     {
-        if ( i >= 0 && i < board->settings->height &&
-             j >= 0 && j < board->settings->width )
+        tables = (BoardTables*) node->data;
+        if ( tables->width != settings->width ||
+             tables->height != settings->height )
         {
-            /* count all tiles for current player */
-            currentTile = board->tiles[i][j];
-            if ( currentTile == tile )
-            {
-                counter++;
-            }
+            tables = NULL;
         }
-
-        i += yStep;
-        j += xStep;
+        node = node->next;
     }
-    while ( i >= 0 && i < board->settings->height &&
-            j >= 0 && j < board->settings->width &&
-            currentTile == tile );
-
 
-    /* come back to the starting point and reverse the direction */
-    /* repeat the same process as above */
-    i = y - yStep;
-    j = x - xStep;
-    do
+    if ( tables == NULL )
     {
-        if ( i >= 0 && i < board->settings->height &&
-             j >= 0 && j < board->settings->width )
+        area = settings->width * settings->height;
+        tables = (BoardTables*) malloc( sizeof(BoardTables) );
+        tables->width = settings->width;
+        tables->height = settings->height;
+        tables->zobrist = (unsigned long*) malloc(
+            area * ( TicTacTotal - 1 ) * sizeof( unsigned long ) );
+        seed = ZOBRIST_SEED;
+        for ( i = 0; i < area * ( TicTacTotal - 1 ); i++ )
+        {
+            tables->zobrist[i] = nextRandom( &seed );
+        }
+
+        tables->numSymmetries =
+            settings->width == settings->height ? MAX_SYMMETRIES : 4;
+        tables->symmetry = (int*) malloc(
+            2 * tables->numSymmetries * area * sizeof( int ) );
+        tables->inverse = tables->symmetry + tables->numSymmetries * area;
+        for ( s = 0; s < tables->numSymmetries; s++ )
         {
-            currentTile = board->tiles[i][j];
-            if ( currentTile == tile )
+            for ( y = 0; y < settings->height; y++ )
             {
-                counter++;
+                for ( x = 0; x < settings->width; x++ )
+                {
+                    sx = SYMMETRIES[s][0] ? y : x;
+                    sy = SYMMETRIES[s][0] ? x : y;
+                    sx = SYMMETRIES[s][1] ? settings->width - 1 - sx : sx;
+                    sy = SYMMETRIES[s][2] ? settings->height - 1 - sy : sy;
+
+                    tables->symmetry[s * area + y * settings->width + x] =
+                        sy * settings->width + sx;
+                    tables->inverse[s * area + sy * settings->width + sx] =
+                        y * settings->width + x;
+                }
             }
         }
-
-        i -= yStep;
-        j -= xStep;
+        listInsertLast( sharedTables, tables );
     }
-    while ( i >= 0 && i < board->settings->height &&
-            j >= 0 && j < board->settings->width &&
-            currentTile == tile );
+    pthread_mutex_unlock( &tablesLock );
 
-    return counter;
+    return tables;
+}
+
+
+/******************************************************************************
+ * Function: _sparse_home                                                     *
+ * Imports: pointer to a sparse board, a cell (y * width + x)                 *
+ * Returns: the slot of the hash table the cell's search starts at            *
+ ******************************************************************************/
+static int _sparse_home( GameBoard *board, int cell )
+{
+    return (int) ( ( (unsigned long) cell * SPARSE_HASH ) >> 32 &
+        (unsigned long) ( board->numSlots - 1 ) );
 }
 
 
 
 /******************************************************************************
- * Function: checkDraw                                                        *
- * Imports: pointer to the game board                                         *
- * Returns: TRUE if there are no emty tiles left on the board                 *
- *          FALSE if there are still some emty tiles left                     *
- * Exports: none                                                              *
- * Purpose: checks if there are no empty tiles left on the board, in which    *
- *          case the game ends in a draw unless a player has already won.     *
+ * Function: _sparse_slot                                                     *
+ * Imports: pointer to a sparse board, a cell (y * width + x)                 *
+ * Returns: the slot that holds the cell's tile, or the free slot it would go *
+ *          in if the cell is empty                                           *
+ * Purpose: finds a cell by linear probing. The table is never more than half *
+ *          full, so this looks at two slots on average.                      *
  ******************************************************************************/
-BOOL checkDraw( GameBoard *board )
+static SparseCell *_sparse_slot( GameBoard *board, int cell )
 {
-    int i, j;
-    BOOL noCellsLeft = TRUE;
+    int slot;
 
-    /* iterate over each tile on the board
-     * and stop when an emty tile is found */
-    i = 0;
-    while ( i < board->settings->height && noCellsLeft )
+    slot = _sparse_home( board, cell );
+    while ( board->cells[slot].cell != SPARSE_FREE &&
+            board->cells[slot].cell != cell )
     {
-        j = 0;
-        while ( j < board->settings->width && noCellsLeft )
-        {
-            if ( board->tiles[i][j] == TicTacNone )
-            {
-                noCellsLeft = FALSE;
-            }
-            j++;
-        }
-        i++;
+        slot = ( slot + 1 ) & ( board->numSlots - 1 );
     }
 
-    return noCellsLeft;
+    return &board->cells[slot];
 }
 
 
 
 /******************************************************************************
- * Function: changePlayer                                                     *
- * Imports: pointer to the current player tile                                *
- * Exports: changes the current player value                                  *
- * Purpose: used to swap between players when changing turns                  *
- *          The algorithm increments the player value until it reaches the    *
- *          last player, when it resets back to 1 using modulo division       *
+ * Function: _sparse_alloc                                                    *
+ * Imports: pointer to a sparse board, the number of slots, a power of 2      *
+ * Exports: gives the board a new, empty hash table of that size              *
+ * Purpose: the old table is freed if it came from malloc. One from an arena  *
+ *          is left to the arena, which the doubling keeps to less than the   *
+ *          size of the last table.                                           *
  ******************************************************************************/
-void changePlayer( TicTacTile *player )
+static void _sparse_alloc( GameBoard *board, int numSlots )
 {
-    *player = *player % ( TicTacTotal - 1 ) + 1;
+    int i;
+
+    if ( board->arena == NULL )
+    {
+        free( board->cells );
+    }
+    board->cells = (SparseCell*) _board_alloc( board->arena,
+        numSlots * sizeof( SparseCell ) );
+    board->numSlots = numSlots;
+    board->numCells = 0;
+    for ( i = 0; i < numSlots; i++ )
+    {
+        board->cells[i].cell = SPARSE_FREE;
+        board->cells[i].tile = TicTacNone;
+    }
 }
 
 
 
 /******************************************************************************
- * Function: deleteGameBoard                                                  *
- * Imports: pointer to game board                                             *
+ * Function: _sparse_place                                                    *
+ * Imports: pointer to a sparse board, the tile, the cell (y * width + x)     *
+ * Returns: TRUE if the cell was empty and now holds the tile, FALSE if it    *
+ *          was already taken                                                 *
+ * Purpose: adds a tile to the hash table, doubling the table once it is half *
+ *          full, so that adding a tile takes constant time on average.       *
+ ******************************************************************************/
+static BOOL _sparse_place( GameBoard *board, TicTacTile tile, int cell )
+{
+    SparseCell *slot, *old;
+    int i, numSlots;
+    BOOL valid;
+
+    slot = _sparse_slot( board, cell );
+    valid = slot->cell == SPARSE_FREE;
+    if ( valid )
+    {
+        slot->cell = cell;
+        slot->tile = tile;
+        board->numCells++;
+    }
+
+    if ( 2 * board->numCells > board->numSlots )
+    {
+        /* move every tile into a table twice the size */
+        old = board->cells;
+        numSlots = board->numSlots;
+        board->cells = NULL;
+        _sparse_alloc( board, 2 * numSlots );
+        for ( i = 0; i < numSlots; i++ )
+        {
+            if ( old[i].cell != SPARSE_FREE )
+            {
+                *_sparse_slot( board, old[i].cell ) = old[i];
+                board->numCells++;
+            }
+        }
+        if ( board->arena == NULL )
+        {
+            free( old );
+        }
+    }
+
+    return valid;
+}
+
+
+
+/******************************************************************************
+ * Function: _sparse_remove                                                   *
+ * Imports: pointer to a sparse board, the slot of a tile in its hash table   *
+ * Exports: the tile is taken out of the table                                *
+ * Purpose: frees the slot and moves later tiles of the same run back into    *
+ *          it where their search would otherwise stop short of them, so      *
+ *          that no markers for removed tiles are needed.                     *
+ ******************************************************************************/
+static void _sparse_remove( GameBoard *board, SparseCell *slot )
+{
+    int hole, next, home, mask;
+
+    mask = board->numSlots - 1;
+    hole = (int) ( slot - board->cells );
+    next = ( hole + 1 ) & mask;
+    while ( board->cells[next].cell != SPARSE_FREE )
+    {
+        /* the tile can move if the hole is between its home and it */
+        home = _sparse_home( board, board->cells[next].cell );
+        if ( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) )
+        {
+            board->cells[hole] = board->cells[next];
+            hole = next;
+        }
+        next = ( next + 1 ) & mask;
+    }
+
+    board->cells[hole].cell = SPARSE_FREE;
+    board->cells[hole].tile = TicTacNone;
+    board->numCells--;
+}
+
+
+
+/******************************************************************************
+ * Function: boardReset                                                       *
+ * Imports: pointer to an initialised GameBoard struct                        *
+ * Exports: clears all cells and counters of the board                        *
+ * Purpose: empties a board so that it can be reused for another game         *
+ *          without allocating it again.                                      *
+ ******************************************************************************/
+void boardReset( GameBoard *board )
+{
+    int i, area;
+
+    area = board->settings->width * board->settings->height;
+
+    if ( board->sparse )
+    {
+        for ( i = 0; i < board->numSlots; i++ )
+        {
+            board->cells[i].cell = SPARSE_FREE;
+            board->cells[i].tile = TicTacNone;
+        }
+        board->numCells = 0;
+    }
+    else
+    {
+        memset( board->occupied, 0, board->numWords * sizeof( BitWord ) );
+        memset( board->lineCounts, 0,
+            board->numWindows * WINDOW_PLAYERS * sizeof( unsigned char ) );
+    }
+
+    board->emptyCount = area;
+    board->lastMove.x = -1;
+    board->lastMove.y = -1;
+    memset( board->hashes, 0, sizeof( board->hashes ) );
+    board->openLines[TicTacNone] = 0;
+    for ( i = TicTacX; i < TicTacTotal; i++ )
+    {
+        board->openLines[i] = board->numWindows;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: boardCopy                                                        *
+ * Imports: dest - a board initialised with the same settings as source       *
+ *          source - the board to copy                                        *
+ * Exports: every cell and counter of source is copied into dest              *
+ * Purpose: lets a search play moves on a scratch board of its own without    *
+ *          allocating one. The keys and symmetry tables only depend on the   *
+ *          settings, so both boards already share them. A sparse board's     *
+ *          hash table is resized to match first if it has to be.             *
+ ******************************************************************************/
+void boardCopy( GameBoard *dest, GameBoard *source )
+{
+    int i;
+
+    if ( source->sparse )
+    {
+        if ( dest->numSlots != source->numSlots )
+        {
+            _sparse_alloc( dest, source->numSlots );
+        }
+        memcpy( dest->cells, source->cells,
+            source->numSlots * sizeof( SparseCell ) );
+        dest->numCells = source->numCells;
+    }
+    else
+    {
+        memcpy( dest->occupied, source->occupied,
+            source->numWords * sizeof( BitWord ) );
+        memcpy( dest->lineCounts, source->lineCounts,
+            source->numWindows * WINDOW_PLAYERS * sizeof( unsigned char ) );
+    }
+
+    dest->emptyCount = source->emptyCount;
+    dest->lastMove = source->lastMove;
+    memcpy( dest->hashes, source->hashes, sizeof( source->hashes ) );
+    for ( i = TicTacNone; i < TicTacTotal; i++ )
+    {
+        dest->openLines[i] = source->openLines[i];
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: placeTile                                                        *
+ * Imports: pointer to a GameBoard struct                                     *
+ *          tile variable representing the current player                     *
+ *          x and y coordinates of the new tile                               *
+ * Returns: TRUE if the tile was placed on the board                          *
+ *          FALSE if the could not be placed                                  *
  * Exports: none                                                              *
- * Purpose: frees the memory allocated for a game board                       *
+ * Purpose: attempts to place a new tile onto the game board.                 *
+ *          If the spot is already taken, returns FALSE. Nothing is printed,  *
+ *          so that games can be played without a terminal.                   *
  ******************************************************************************/
-void deleteGameBoard( GameBoard *board )
+BOOL placeTile( GameBoard *board, TicTacTile tile, int x, int y )
+{
+    BOOL valid;
+    valid = FALSE;
+
+    /* ensure the tile is in a valid range */
+    if ( x >= 0 && x < board->settings->width &&
+        y >= 0 && y < board->settings->height )
+    {
+        /* if there is no other tile at the coordinates, place it */
+        if ( board->sparse )
+        {
+            valid = _sparse_place( board, tile,
+                y * board->settings->width + x );
+        }
+        else if ( !( board->occupied[BIT_INDEX( board, x, y )] &
+                     BIT_MASK( x ) ) )
+        {
+            _flip_tile( board, tile, x, y );
+            _update_windows( board, tile, x, y, 1 );
+            valid = TRUE;
+        }
+
+        if ( valid )
+        {
+            board->emptyCount--;
+            board->lastMove.x = x;
+            board->lastMove.y = y;
+        }
+    }
+
+    return valid;
+}
+
+
+
+/******************************************************************************
+ * Function: removeTile                                                       *
+ * Imports: pointer to a GameBoard struct                                     *
+ *          x and y coordinates of the tile to remove                         *
+ * Returns: TRUE if a tile was removed                                        *
+ *          FALSE if the cell was already empty                               *
+ * Exports: none                                                              *
+ * Purpose: takes a tile back off the board, undoing placeTile exactly. Used  *
+ *          by the computer players to search ahead without copying boards.   *
+ *          lastMove is left unchanged, as the board does not keep a history. *
+ ******************************************************************************/
+BOOL removeTile( GameBoard *board, int x, int y )
+{
+    TicTacTile tile;
+    BOOL valid;
+    valid = FALSE;
+
+    if ( x >= 0 && x < board->settings->width &&
+        y >= 0 && y < board->settings->height )
+    {
+        tile = getTile( board, x, y );
+        if ( tile != TicTacNone && board->sparse )
+        {
+            _sparse_remove( board,
+                _sparse_slot( board, y * board->settings->width + x ) );
+        }
+        else if ( tile != TicTacNone )
+        {
+            _flip_tile( board, tile, x, y );
+            _update_windows( board, tile, x, y, -1 );
+        }
+
+        if ( tile != TicTacNone )
+        {
+            board->emptyCount++;
+            valid = TRUE;
+        }
+    }
+
+    return valid;
+}
+
+
+
+/******************************************************************************
+ * Function: _flip_tile                                                       *
+ * Imports: pointer to a GameBoard struct                                     *
+ *          tile of the player that owns the cell                             *
+ *          x and y coordinates of the cell                                   *
+ * Exports: toggles the cell in every bitboard of the board                   *
+ * Purpose: sets the bits of an empty cell or clears the bits of a taken one, *
+ *          in the occupied bitboard and in each of the player's bitboards.   *
+ *          The cell's key is XOR'd into the hashes, which both adds and      *
+ *          takes away the tile. Each symmetric hash uses the key of the cell *
+ *          the tile is moved to by that symmetry.                            *
+ ******************************************************************************/
+static void _flip_tile( GameBoard *board, TicTacTile tile, int x, int y )
+{
+    int word, area, s;
+    BitWord mask;
+
+    word = BIT_INDEX( board, x, y );
+    mask = BIT_MASK( x );
+
+    board->occupied[word] ^= mask;
+    board->tiles[tile][word] ^= mask;
+    area = board->settings->width * board->settings->height;
+    for ( s = 0; s < board->numSymmetries; s++ )
+    {
+        board->hashes[s] ^= board->zobrist[( tile - 1 ) * area +
+            board->symmetry[s * area + y * board->settings->width + x]];
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: getTile                                                          *
+ * Imports: pointer to a GameBoard struct                                     *
+ *          x and y coordinates of a cell                                     *
+ * Returns: the tile at the given cell, TicTacNone if the cell is empty       *
+ * Purpose: looks up the state of a single cell in the packed bitboards, or   *
+ *          in the hash table of a sparse board, whose free slots hold        *
+ *          TicTacNone.                                                       *
+ * Assertions: the coordinates are within the board                           *
+ ******************************************************************************/
+TicTacTile getTile( GameBoard *board, int x, int y )
+{
+    TicTacTile tile;
+    int word;
+    BitWord mask;
+
+    tile = TicTacNone;
+    if ( board->sparse )
+    {
+        tile = _sparse_slot( board, y * board->settings->width + x )->tile;
+    }
+    else
+    {
+        word = BIT_INDEX( board, x, y );
+        mask = BIT_MASK( x );
+
+        if ( board->occupied[word] & mask )
+        {
+            tile = TicTacX;
+            while ( !( board->tiles[tile][word] & mask ) )
+            {
+                tile++;
+            }
+        }
+    }
+
+    return tile;
+}
+
+
+
+/******************************************************************************
+* Function: checkWin                                                          *
+* Imports: pointer to a GameBoard struct                                      *
+*          tile representing the current player                               *
+*          x and y coordinates of the newest tile                             *
+* Returns: TRUE if the current player has won the game                        *
+*          FALSE otherwise                                                    *
+* Exports: none                                                               *
+* Purpose: This function checks if the current player has won the game by     *
+*          looking for K tiles in a row through the tile they had just        *
+*          placed, in all four main directions.                               *
+*          Uses the word-parallel check when a line of 2K-1 cells fits into a *
+*          single BitWord, and the cell by cell scan otherwise, or when the   *
+*          program is compiled with Scalar. A sparse board is looked up in    *
+*          its hash table, at most K-1 cells each way.                        *
+******************************************************************************/
+BOOL checkWin( GameBoard *board, TicTacTile tile, int x, int y )
+{
+    BOOL won;
+
+    if ( board->sparse )
+    {
+        won = _check_win_sparse( board, tile, x, y );
+    }
+    else
+    {
+        #ifdef Scalar
+        won = _check_win_scalar( board, tile, x, y );
+        #else
+        if ( board->settings->matches * 2 - 1 <= WORD_BITS )
+        {
+            won = _check_win_words( board, tile, x, y );
+        }
+        else
+        {
+            won = _check_win_scalar( board, tile, x, y );
+        }
+        #endif
+    }
+
+    return won;
+}
+
+
+
+/******************************************************************************
+* Function: _check_win_scalar                                                 *
+* Imports: pointer to a GameBoard struct                                      *
+*          tile representing the current player                               *
+*          x and y coordinates of the newest tile                             *
+* Returns: TRUE if the current player has won the game                        *
+*          FALSE otherwise                                                    *
+* Purpose: validates the win by counting the number of relevant tiles in a    *
+*          row in each main direction (horizontal, vertical, and diagonals).  *
+*          counting stops once an unwanted tile is found.                     *
+*          Directions to be checked are as follows:                           *
+*               (1, 0) - horizontal                                           *
+*               (0, 1) - vertical                                             *
+*               (1, 1) - desceding diagonal                                   *
+*               (1,-1) - rising diagonal                                      *
+******************************************************************************/
+static BOOL _check_win_scalar( GameBoard *board, TicTacTile tile, int x, int y )
+{
+    BOOL won = FALSE;
+    int dir, count;
+
+    dir = 0;
+    while ( !won && dir < NUM_DIRECTIONS )
+    {
+        count = checkDirection( board, tile, x, y,
+            DIRECTIONS[dir][0], DIRECTIONS[dir][1] );
+        if ( count >= board->settings->matches )
+        {
+            won = TRUE;
+        }
+        dir++;
+    }
+
+    return won;
+}
+
+
+
+/******************************************************************************
+* Function: _check_win_sparse                                                 *
+* Imports: pointer to a sparse GameBoard struct                               *
+*          tile representing the current player                               *
+*          x and y coordinates of the newest tile                             *
+* Returns: TRUE if the current player has won the game                        *
+*          FALSE otherwise                                                    *
+* Purpose: counts the player's tiles in a row through the new tile in each    *
+*          main direction, like _check_win_scalar, but stops as soon as K are *
+*          found, so that at most 4 * ( K - 1 ) cells are looked up however   *
+*          long the lines on the board are.                                   *
+******************************************************************************/
+static BOOL _check_win_sparse( GameBoard *board, TicTacTile tile, int x, int y )
+{
+    int dir, side, count, cx, cy;
+    BOOL won = FALSE;
+
+    dir = 0;
+    while ( !won && dir < NUM_DIRECTIONS )
+    {
+        /* walk forwards from the tile, then backwards */
+        count = 1;
+        for ( side = 1; side >= -1; side -= 2 )
+        {
+            cx = x + side * DIRECTIONS[dir][0];
+            cy = y + side * DIRECTIONS[dir][1];
+            while ( count < board->settings->matches &&
+                    cx >= 0 && cx < board->settings->width &&
+                    cy >= 0 && cy < board->settings->height &&
+                    getTile( board, cx, cy ) == tile )
+            {
+                count++;
+                cx += side * DIRECTIONS[dir][0];
+                cy += side * DIRECTIONS[dir][1];
+            }
+        }
+
+        won = count >= board->settings->matches;
+        dir++;
+    }
+
+    return won;
+}
+
+
+
+#ifndef Scalar
+/******************************************************************************
+* Function: _check_win_words                                                  *
+* Imports: pointer to a GameBoard struct                                      *
+*          tile representing the current player                               *
+*          x and y coordinates of the newest tile                             *
+* Returns: TRUE if the current player has won the game                        *
+*          FALSE otherwise                                                    *
+* Purpose: reads the 2K-1 cells around the new tile out of each of the 2K-1   *
+*          rows around it, one BitWord per row, with the new tile's column at *
+*          bit K-1. The middle row is the horizontal line. A step down the    *
+*          board is a step of one row, plus or minus one column along the     *
+*          diagonals, so the vertical line takes bit K-1 of every row, and    *
+*          the diagonals take bit i and bit 2K-2-i of row i.                  *
+*          All four lines are then reduced together with shift-and-AND steps  *
+*          ( line & line >> 1 & line >> 2 ... ) that double the run length    *
+*          each time, so a bit survives only if K tiles in a row end there.   *
+*          This takes O(K) word reads and O(log K) word operations.           *
+* Assertions: 2K-1 <= WORD_BITS                                               *
+******************************************************************************/
+static BOOL _check_win_words( GameBoard *board, TicTacTile tile, int x, int y )
+{
+    int k, dir, run, shift, i, first, last, word, offset, index;
+    int lowWord, highWord;
+    BitWord lines[NUM_DIRECTIONS];
+    BitWord row, mask, lowMask, highMask, *bits;
+
+    k = board->settings->matches;
+    mask = 2 * k - 1 < WORD_BITS ? BIT_MASK( 2 * k - 1 ) - 1 : ~( (BitWord) 0 );
+
+    /* rows above and below the board read as empty, so they are skipped */
+    first = y < k - 1 ? k - 1 - y : 0;
+    last = y + k - 1 >= board->settings->height ?
+        board->settings->height - 1 - y + k - 1 : 2 * k - 2;
+
+    /* the window starts in the same word of every row, and may begin up to
+     * K-1 cells before the row does. The bits past the end of a row are
+     * never set, so only words before and after the row are skipped */
+    word = ( x - k + 1 + WORD_BITS ) / WORD_BITS - 1;
+    offset = ( x - k + 1 + WORD_BITS ) % WORD_BITS;
+    lowWord = word >= 0 ? word : 0;
+    highWord = word + 1 < board->rowWords ? word + 1 : word;
+    lowMask = word >= 0 ? ~( (BitWord) 0 ) : 0;
+    highMask = word + 1 < board->rowWords ? ~( (BitWord) 0 ) : 0;
+    bits = board->tiles[tile];
+    index = ( y - k + 1 + first ) * board->rowWords;
+
+    for ( dir = 0; dir < NUM_DIRECTIONS; dir++ )
+    {
+        lines[dir] = 0;
+    }
+    for ( i = first; i <= last; i++ )
+    {
+        /* the second shift is split in two so it stays below WORD_BITS */
+        row = mask & ( ( ( bits[index + lowWord] & lowMask ) >> offset ) |
+            ( ( ( bits[index + highWord] & highMask ) << 1 ) <<
+                ( WORD_BITS - 1 - offset ) ) );
+        index += board->rowWords;
+
+        if ( i == k - 1 )
+        {
+            lines[0] = row;
+        }
+        lines[1] |= ( ( row >> ( k - 1 ) ) & 1 ) << i;
+        lines[2] |= row & BIT_MASK( i );
+        lines[3] |= ( ( row >> ( 2 * k - 2 - i ) ) & 1 ) << i;
+    }
+
+    /* AND each line with shifted copies of itself until runs of K remain */
+    run = 1;
+    while ( run < k )
+    {
+        shift = run < k - run ? run : k - run;
+        for ( dir = 0; dir < NUM_DIRECTIONS; dir++ )
+        {
+            lines[dir] &= lines[dir] >> shift;
+        }
+        run += shift;
+    }
+
+    return ( lines[0] | lines[1] | lines[2] | lines[3] ) != 0;
+}
+#endif
+
+
+
+/******************************************************************************
+ * Function: checkDirection                                                   *
+ * Imports: pointer to a game board                                           *
+ *          tile representing a current player                                *
+ *          x and y coordinates of the new tile                               *
+ *          x and y increments for the scanner                                *
+ * Returns: number of relevant tiles in a row in the specified direction      *
+ * Purpose: counts the number of tiles along a straight line.                 *
+ *          Starts at the specified point and moves along a straight line     *
+ *          until aninvalid tile, then returns to the staring point and       *
+ *          moves in the opposite direction.                                  *
+ * Assertions: the board is not sparse                                        *
+ ******************************************************************************/
+int checkDirection( GameBoard *board, TicTacTile tile, int x, int y,
+    int xStep, int yStep )
+{
+    int counter, i, j;
+    BitWord *bits;
+
+    bits = board->tiles[tile];
+
+    /* scan along the specified direction until an unwanted tile is found */
+    counter = 0;
+    i = y;
+    j = x;
+    while ( i >= 0 && i < board->settings->height &&
+            j >= 0 && j < board->settings->width &&
+            ( bits[BIT_INDEX( board, j, i )] & BIT_MASK( j ) ) )
+    {
+        /* count all tiles for current player */
+        counter++;
+        i += yStep;
+        j += xStep;
+    }
+
+    /* come back to the starting point and reverse the direction */
+    /* repeat the same process as above */
+    i = y - yStep;
+    j = x - xStep;
+    while ( i >= 0 && i < board->settings->height &&
+            j >= 0 && j < board->settings->width &&
+            ( bits[BIT_INDEX( board, j, i )] & BIT_MASK( j ) ) )
+    {
+        counter++;
+        i -= yStep;
+        j -= xStep;
+    }
+
+    return counter;
+}
+
+
+
+/******************************************************************************
+ * Function: checkDraw                                                        *
+ * Imports: pointer to the game board                                         *
+ * Returns: TRUE if the game can no longer be won by anyone                   *
+ *          FALSE if at least one player can still get K in a row             *
+ * Exports: none                                                              *
+ * Purpose: checks if there are no empty tiles left on the board, or if every *
+ *          window on the board is blocked for every player. In both cases    *
+ *          the game ends in a draw unless a player has already won.          *
+ *          Both counters are kept up to date by placeTile, so the check      *
+ *          runs in constant time.                                            *
+ ******************************************************************************/
+BOOL checkDraw( GameBoard *board )
 {
     int i;
-    for ( i = 0; i < board->settings->height; i++ )
+    BOOL noLinesLeft = TRUE;
+
+    for ( i = TicTacX; i < TicTacTotal; i++ )
     {
-        free( board->tiles[i] );
+        if ( board->openLines[i] > 0 )
+        {
+            noLinesLeft = FALSE;
+        }
     }
-    free( board->tiles );
 
-    free( board );
+    return board->emptyCount == 0 || noLinesLeft;
 }
 
 
 
 /******************************************************************************
- * Function: deleteGameLog                                                    *
- * Imports: pointer to a game log                                             *
+ * Function: _valid_window                                                    *
+ * Imports: pointer to the game board                                         *
+ *          direction index into DIRECTIONS                                   *
+ *          x and y coordinates of the first cell of the window               *
+ * Returns: TRUE if all K cells of the window lie on the board                *
+ *          FALSE otherwise                                                   *
+ ******************************************************************************/
+static BOOL _valid_window( GameBoard *board, int dir, int x, int y )
+{
+    int endX, endY;
+
+    endX = x + DIRECTIONS[dir][0] * ( board->settings->matches - 1 );
+    endY = y + DIRECTIONS[dir][1] * ( board->settings->matches - 1 );
+
+    return x >= 0 && x < board->settings->width &&
+           y >= 0 && y < board->settings->height &&
+           endX >= 0 && endX < board->settings->width &&
+           endY >= 0 && endY < board->settings->height;
+}
+
+
+
+/******************************************************************************
+ * Function: _window_index                                                    *
+ * Imports: pointer to the game board                                         *
+ *          direction index into DIRECTIONS                                   *
+ *          x and y coordinates of the first cell of a window on the board    *
+ * Returns: the number of the window, from 0 to numWindows - 1                *
+ * Purpose: windows are numbered direction by direction, then row by row of   *
+ *          their first cells. Rising diagonals can only start K-1 rows down. *
+ ******************************************************************************/
+static int _window_index( GameBoard *board, int dir, int x, int y )
+{
+    int spanX, firstY;
+
+    spanX = board->settings->width -
+        DIRECTIONS[dir][0] * ( board->settings->matches - 1 );
+    firstY = DIRECTIONS[dir][1] < 0 ? board->settings->matches - 1 : 0;
+
+    return board->windowStart[dir] + ( y - firstY ) * spanX + x;
+}
+
+
+
+/******************************************************************************
+ * Function: _window_total                                                    *
+ * Imports: the lineCounts entries of a window                                *
+ * Returns: the number of tiles of any player in the window                   *
+ ******************************************************************************/
+static int _window_total( unsigned char *counts )
+{
+    int p, total;
+
+    total = 0;
+    for ( p = 0; p < WINDOW_PLAYERS; p++ )
+    {
+        total += counts[p];
+    }
+
+    return total;
+}
+
+
+
+/******************************************************************************
+ * Function: cellWindows                                                      *
+ * Imports: pointer to the game board                                         *
+ *          x and y coordinates of a cell                                     *
+ * Returns: the number of windows that pass through the cell                  *
+ * Exports: windows - pointers to the lineCounts entries of each window, the  *
+ *                    array must have room for NUM_DIRECTIONS * K pointers    *
+ * Purpose: lists the windows a tile at the given cell takes part in, so      *
+ *          that their counts can be updated or evaluated.                    *
+ * Assertions: the board is not sparse                                        *
+ ******************************************************************************/
+int cellWindows( GameBoard *board, int x, int y, unsigned char **windows )
+{
+    int dir, i, startX, startY, count;
+
+    count = 0;
+
+    for ( dir = 0; dir < NUM_DIRECTIONS; dir++ )
+    {
+        /* walk back along the direction over every possible window start */
+        for ( i = 0; i < board->settings->matches; i++ )
+        {
+            startX = x - DIRECTIONS[dir][0] * i;
+            startY = y - DIRECTIONS[dir][1] * i;
+
+            if ( _valid_window( board, dir, startX, startY ) )
+            {
+                windows[count] = board->lineCounts + WINDOW_PLAYERS *
+                    _window_index( board, dir, startX, startY );
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+
+
+/******************************************************************************
+ * Function: winningCells                                                     *
+ * Imports: pointer to the game board, player                                 *
+ *          max - the most cells to look for                                  *
+ * Returns: the number of cells found, at most max                            *
+ * Exports: cells - the cells (y * width + x) where a tile of the player      *
+ *                  would complete K in a row, each listed once               *
+ * Purpose: finds the windows that hold K-1 of the player's tiles and nothing *
+ *          else, and the empty cell left in each. Used to spot moves that    *
+ *          win at once, and threats that have to be blocked.                 *
+ * Assertions: the board is not sparse                                        *
+ ******************************************************************************/
+int winningCells( GameBoard *board, TicTacTile player, int *cells, int max )
+{
+    unsigned char *counts;
+    int dir, x, y, i, cx, cy, cell, count, known, spanX, firstY, lastY;
+
+    count = 0;
+    for ( dir = 0; dir < NUM_DIRECTIONS && count < max; dir++ )
+    {
+        spanX = board->settings->width -
+            DIRECTIONS[dir][0] * ( board->settings->matches - 1 );
+        firstY = DIRECTIONS[dir][1] < 0 ? board->settings->matches - 1 : 0;
+        lastY = DIRECTIONS[dir][1] > 0 ?
+            board->settings->height - board->settings->matches :
+            board->settings->height - 1;
+
+        for ( y = firstY; y <= lastY && count < max; y++ )
+        {
+            for ( x = 0; x < spanX && count < max; x++ )
+            {
+                counts = board->lineCounts +
+                    WINDOW_PLAYERS * _window_index( board, dir, x, y );
+                if ( counts[player - 1] == board->settings->matches - 1 &&
+                     _window_total( counts ) == counts[player - 1] )
+                {
+                    /* find the one empty cell of the window */
+                    i = 0;
+                    do
+                    {
+                        cx = x + DIRECTIONS[dir][0] * i;
+                        cy = y + DIRECTIONS[dir][1] * i;
+                        i++;
+                    }
+                    while ( getTile( board, cx, cy ) != TicTacNone );
+
+                    cell = cy * board->settings->width + cx;
+                    known = 0;
+                    while ( known < count && cells[known] != cell )
+                    {
+                        known++;
+                    }
+                    if ( known == count )
+                    {
+                        cells[count] = cell;
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+
+
+/******************************************************************************
+ * Function: canonicalHash                                                    *
+ * Imports: pointer to the game board                                         *
+ * Returns: the symmetry that gives the canonical hash                        *
+ * Exports: key - the canonical hash                                          *
+ * Purpose: all symmetric copies of a position share one canonical hash, the  *
+ *          smallest of their hashes, so searches and stored results can      *
+ *          treat them as one position. A cell of this board is moved into    *
+ *          the canonical board with symmetry[s * area + cell], and back      *
+ *          with inverse[s * area + cell], where s is the returned symmetry.  *
+ ******************************************************************************/
+int canonicalHash( GameBoard *board, unsigned long *key )
+{
+    int s, best;
+
+    best = 0;
+    for ( s = 1; s < board->numSymmetries; s++ )
+    {
+        if ( board->hashes[s] < board->hashes[best] )
+        {
+            best = s;
+        }
+    }
+    *key = board->hashes[best];
+
+    return best;
+}
+
+
+
+/******************************************************************************
+ * Function: nearCells                                                        *
+ * Imports: pointer to the game board                                         *
+ *          reach - how far from a tile a cell may be, less than WORD_BITS    *
+ * Returns: the number of cells found                                         *
+ * Exports: cells - the empty cells (y * width + x) that are at most reach    *
+ *                  cells from a tile in every direction, in row order. The   *
+ *                  array must have room for width * height cells             *
+ * Purpose: moves far away from every tile are almost never worth playing,    *
+ *          so searches only look at the cells near the tiles. The occupied   *
+ *          rows around each row are OR'd together and then spread sideways   *
+ *          with shifts, a word at a time.                                    *
+ * Assertions: the board is not sparse                                        *
+ ******************************************************************************/
+int nearCells( GameBoard *board, int reach, int *cells )
+{
+    BitWord near, spread, valid, left, right, *row;
+    int count, x, y, w, s;
+
+    count = 0;
+    for ( y = 0; y < board->settings->height; y++ )
+    {
+        row = board->occupied + y * board->rowWords;
+        for ( w = 0; w < board->rowWords; w++ )
+        {
+            near = _near_rows( board, y, w, reach );
+            left = _near_rows( board, y, w - 1, reach );
+            right = _near_rows( board, y, w + 1, reach );
+
+            spread = near;
+            for ( s = 1; s <= reach; s++ )
+            {
+                spread |= near << s | near >> s |
+                    left >> ( WORD_BITS - s ) | right << ( WORD_BITS - s );
+            }
+
+            valid = ~( (BitWord) 0 );
+            if ( w == board->rowWords - 1 &&
+                 board->settings->width % WORD_BITS != 0 )
+            {
+                valid = BIT_MASK( board->settings->width ) - 1;
+            }
+
+            spread &= ~row[w] & valid;
+            while ( spread != 0 )
+            {
+                x = w * WORD_BITS + LOWEST_BIT( spread );
+                spread &= spread - 1;
+                cells[count] = y * board->settings->width + x;
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+
+
+/******************************************************************************
+ * Function: _near_rows                                                       *
+ * Imports: pointer to the game board, row, word within the row, reach        *
+ * Returns: the given word of the rows within reach of the row, OR'd          *
+ *          together, or 0 if the word is outside the row                     *
+ ******************************************************************************/
+static BitWord _near_rows( GameBoard *board, int y, int w, int reach )
+{
+    BitWord near;
+    int row;
+
+    near = 0;
+    if ( w >= 0 && w < board->rowWords )
+    {
+        for ( row = y - reach; row <= y + reach; row++ )
+        {
+            if ( row >= 0 && row < board->settings->height )
+            {
+                near |= board->occupied[row * board->rowWords + w];
+            }
+        }
+    }
+
+    return near;
+}
+
+
+
+/******************************************************************************
+ * Function: _update_windows                                                  *
+ * Imports: pointer to the game board                                         *
+ *          tile that has just been placed or removed                         *
+ *          x and y coordinates of the tile                                   *
+ *          change - 1 if the tile was placed, -1 if it was removed           *
+ * Exports: updates lineCounts and openLines of the board                     *
+ * Purpose: visits the (up to 4*K) windows that pass through the tile and     *
+ *          adds the tile to, or takes it away from, their counts.            *
+ *          A window that was open for another player is closed for that      *
+ *          player by a new tile, and opens again once the tile is removed.   *
+ ******************************************************************************/
+static void _update_windows( GameBoard *board, TicTacTile tile, int x, int y,
+    int change )
+{
+    unsigned char *windows[NUM_DIRECTIONS * DENSE_DIMENSION];
+    unsigned char *counts;
+    int i, p, count, total;
+
+    count = cellWindows( board, x, y, windows );
+    for ( i = 0; i < count; i++ )
+    {
+        counts = windows[i];
+        total = _window_total( counts );
+
+        /* the window was open for p if only p had tiles in it */
+        if ( change > 0 )
+        {
+            for ( p = TicTacX; p < TicTacTotal; p++ )
+            {
+                if ( p != (int) tile && total == counts[p - 1] )
+                {
+                    board->openLines[p]--;
+                }
+            }
+        }
+
+        counts[tile - 1] += change;
+        total += change;
+
+        /* and it is open for p again if only p has tiles left in it */
+        if ( change < 0 )
+        {
+            for ( p = TicTacX; p < TicTacTotal; p++ )
+            {
+                if ( p != (int) tile && total == counts[p - 1] )
+                {
+                    board->openLines[p]++;
+                }
+            }
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: changePlayer                                                     *
+ * Imports: pointer to the current player tile                                *
+ * Exports: changes the current player value                                  *
+ * Purpose: used to swap between players when changing turns                  *
+ *          The algorithm increments the player value until it reaches the    *
+ *          last player, when it resets back to 1 using modulo division       *
+ ******************************************************************************/
+void changePlayer( TicTacTile *player )
+{
+    *player = *player % ( TicTacTotal - 1 ) + 1;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteGameBoard                                                  *
+ * Imports: pointer to game board                                             *
  * Exports: none                                                              *
- * Purpose: provides functionality to remove a game log from a linked list    *
- * Assertions: the imported pointer points to a GameLog struct                *
+ * Purpose: frees the memory allocated for a game board                       *
  ******************************************************************************/
-void deleteGameLog( void *log )
+void deleteGameBoard( GameBoard *board )
 {
-    GameLog *gameLog = (GameLog*) log;
-    freeList( gameLog->turnList, &deleteTurnLog );
-    free( log );
+    /* all bitboards share the block that starts at occupied */
+    free( board->occupied );
+    free( board->lineCounts );
+    free( board->cells );
+
+    free( board );
 }
 
 
 
 /******************************************************************************
- * Function: deleteTurnLog                                                    *
- * Imports: pointer to a turn log                                             *
+ * Function: deleteGameLog                                                    *
+ * Imports: pointer to a GameLog struct                                       *
  * Exports: none                                                              *
- * Purpose: provides functionality to remove a turn log from a linked list    *
- * Assertions: the imported pointer points to a TurnLog struct                *
+ * Purpose: frees a game log, and its turns, that were allocated with malloc  *
+ *          rather than from an arena. Used as a FreeFunc once a simulated    *
+ *          game has been written to the log file.                            *
  ******************************************************************************/
-void deleteTurnLog( void *log )
+void deleteGameLog( void *log )
 {
+    freeArray( ( (GameLog*) log )->turnList );
     free( log );
 }
 
@@ -672,7 +1997,7 @@ void printGameLog( FILE *stream, void *log )
                     gameLog->settings.width, gameLog->settings.height,
                     gameLog->settings.matches );
     #endif
-    printList( stream, gameLog->turnList, &printTurnLog );
+    printArray( stream, gameLog->turnList, &printTurnLog );
 }
 
 
@@ -682,7 +2007,7 @@ void printGameLog( FILE *stream, void *log )
  * Imports: pointer to output stream                                          *
  *          pointer to a turn log                                             *
  * Exports: none                                                              *
- * Purpose: provides functionality to print a game log from a linked list     *
+ * Purpose: provides functionality to print a single turn of a game log       *
  * Assertions: the imported pointer points to a TurnLog struct                *
  ******************************************************************************/
 void printTurnLog( FILE *stream, void *log )
@@ -12,17 +12,32 @@
 #define GAME_H
 
 #include <stdio.h>
+#include <limits.h>
 #include "linkedList.h"
+#include "chunkedArray.h"
 #include "bool.h"
 
 
 /******************************************************************************
- * MAX_DIMENSION: maximum allowed size of a game board dimension              *
- *                capped at 2 digits as settings this large will not ever     *
- *                be needed                                                   *
+ * MAX_DIMENSION: maximum allowed size of a game board dimension, small       *
+ *                enough for the area of the board to fit in an int           *
+ * MAX_DIGITS: the number of digits in MAX_DIMENSION                          *
+ * DENSE_DIMENSION: the largest M, N and K of a board kept in bitboards.      *
+ *                  Larger settings get a sparse board, see isSparse          *
  ******************************************************************************/
-#define MAX_DIMENSION 99
-#define MAX_DIGITS 2
+#define MAX_DIMENSION 30000
+#define MAX_DIGITS 5
+#define DENSE_DIMENSION 99
+
+
+
+/******************************************************************************
+ * DEFAULT_TABLE_SIZE: transposition table size used when the settings file   *
+ *                     does not set T, in megabytes                           *
+ * MAX_TABLE_SIZE: the largest transposition table allowed, in megabytes      *
+ ******************************************************************************/
+#define DEFAULT_TABLE_SIZE 16
+#define MAX_TABLE_SIZE 4096
 
 
 
@@ -74,6 +89,40 @@ typedef enum
 
 
 
+/******************************************************************************
+ * LogFormat: An enumeration of the formats that game logs can be saved in.   *
+ *     LogText - the readable layout shown by the View Log menu               *
+ *     LogBinary - the compact binary format described in binaryLog.h         *
+ ******************************************************************************/
+typedef enum
+{
+    LogText,
+    LogBinary
+} LogFormat;
+
+
+
+/******************************************************************************
+ * LogOptions: A struct that holds how the game logs of a session are saved.  *
+ * Consists of:                                                               *
+ *     format - the format logs are saved in                                  *
+ *     background - TRUE to save every game as soon as it is over, through a  *
+ *                  writer thread (see asyncLog.h), as well as from the menu  *
+ *     append - TRUE for the menu to append the games played since the last   *
+ *              save to one rolling log (see rollingLog.h), FALSE to write    *
+ *              every game of the session to a new file on each save          *
+ *     maxBytes - the size a rolling log is rotated at, 0 to never rotate     *
+ ******************************************************************************/
+typedef struct
+{
+    LogFormat format;
+    BOOL background;
+    BOOL append;
+    long maxBytes;
+} LogOptions;
+
+
+
 /******************************************************************************
  * Coordinates: A struct that holds the x and y values of a tile on the board *
  * Consist of:                                                                *
@@ -95,31 +144,185 @@ typedef struct
  *     height - the height of the game board                                  *
  *     matches - the number of identical tiles in a row required              *
  *               to win the game                                              *
+ *     tableSize - the size of the computer player's transposition table in   *
+ *                 megabytes, optional in the settings file (T=)              *
+ *     tableSet - TRUE if the settings file gave T, FALSE if tableSize is the *
+ *                default                                                     *
  ******************************************************************************/
 typedef struct
 {
     int width;
     int height;
     int matches;
+    int tableSize;
+    BOOL tableSet;
 } Settings;
 
 
 
+/******************************************************************************
+ * BitWord: the machine word used to store a packed row of board cells.       *
+ * WORD_BITS: the number of cells that fit into a single BitWord              *
+ * BIT_INDEX: index of the word holding cell (x, y) in a packed bitboard      *
+ * BIT_MASK: mask selecting column x inside its word                          *
+ * Notes: every row of a bitboard starts on a word boundary, so a row of      *
+ *        width cells takes up rowWords = ceil( width / WORD_BITS ) words.    *
+ ******************************************************************************/
+typedef unsigned long BitWord;
+
+#define WORD_BITS ( (int) ( sizeof( BitWord ) * CHAR_BIT ) )
+#define BIT_INDEX( board, x, y ) ( (y) * (board)->rowWords + (x) / WORD_BITS )
+#define BIT_MASK( x ) ( (BitWord) 1 << ( (x) % WORD_BITS ) )
+
+
+
+/******************************************************************************
+ * NUM_DIRECTIONS: the number of line directions a player can win along:      *
+ *                 horizontal, vertical and the two diagonals                 *
+ * WINDOW_PLAYERS: the number of tile counts kept for each window, one per    *
+ *                 player. The count of player p is at index p - 1            *
+ ******************************************************************************/
+#define NUM_DIRECTIONS 4
+#define WINDOW_PLAYERS ( TicTacTotal - 1 )
+
+
+
+/******************************************************************************
+ * MAX_SYMMETRIES: the number of symmetries of a square board: four turns,    *
+ *                 each with or without a reflection                          *
+ ******************************************************************************/
+#define MAX_SYMMETRIES 8
+
+
+
+/******************************************************************************
+ * SparseCell: A struct that holds a slot of a sparse board's hash table.     *
+ * Consists of:                                                               *
+ *     cell - the cell of the tile in the slot, y * width + x, or SPARSE_FREE *
+ *     tile - the tile in the cell                                            *
+ * SPARSE_FREE: the cell of a slot with no tile in it                         *
+ * SPARSE_MIN_SLOTS: the number of slots a sparse board starts out with       *
+ ******************************************************************************/
+typedef struct
+{
+    int cell;
+    TicTacTile tile;
+} SparseCell;
+
+#define SPARSE_FREE -1
+#define SPARSE_MIN_SLOTS 64
+
+
+
 /******************************************************************************
  * GameBoard: A struct that holds the game board as well as the settings of   *
  *            that board.                                                     *
  * Consists of:                                                               *
  *     settings - a struct with settings for this particular board            *
- *     tiles - a 2d array of tile states                                      *
+ *     rowWords - the number of BitWords used to store a single row           *
+ *     occupied - a packed bitboard with a bit set for every taken cell       *
+ *     tiles - a packed bitboard for each player, indexed by TicTacTile.      *
+ *             tiles[TicTacNone] is unused and set to NULL                    *
+ *     emptyCount - the number of cells that are still empty                  *
+ *     lineCounts - the number of tiles each player has in every K-long line  *
+ *                  (window) that fits on the board, WINDOW_PLAYERS entries   *
+ *                  per window                                                *
+ *     windowStart - the number of the first window of each direction         *
+ *     openLines - the number of windows each player could still complete,    *
+ *                 i.e. windows that hold no tiles of any other player        *
+ *     lastMove - the cell of the last tile placed, (-1,-1) on an empty board *
+ *     zobrist - a random 64-bit key for each player in each cell, at index   *
+ *               ( tile - 1 ) * area + y * width + x. Shared by every board   *
+ *               of the same width and height, so it must not be changed      *
+ *     numSymmetries - the number of ways the board can be reflected or       *
+ *                     turned onto itself: 8 if it is square, 4 otherwise     *
+ *     symmetry - the cell that each cell is moved to by each symmetry, at    *
+ *                index s * area + y * width + x. Symmetry 0 is the identity  *
+ *     inverse - the same for the inverse of each symmetry. Both tables are   *
+ *               shared like zobrist, and must not be changed either          *
+ *     hashes - for each symmetry s, the XOR of the keys of every tile after  *
+ *              the board is moved by s. hashes[0] names the position itself. *
+ *              The player to move follows from the number of tiles and       *
+ *              needs no key of its own                                       *
+ *     numWords - the number of BitWords allocated for all the bitboards      *
+ *     numWindows - the number of windows that fit on the board               *
+ *     sparse - TRUE if the board keeps its tiles in a hash table instead of  *
+ *              bitboards, see isSparse. A sparse board has no bitboards,     *
+ *              window counts, keys or symmetry tables, so those are NULL.    *
+ *              Its openLines are never counted down, and its hashes stay 0   *
+ *     cells - the hash table of a sparse board, with linear probing          *
+ *     numSlots - the number of slots in cells, a power of 2                  *
+ *     numCells - the number of slots in use, kept under half of numSlots     *
+ *     arena - the arena the board came from, NULL if it came from malloc     *
+ * Notes: all bitboards share one contiguous allocation starting at occupied, *
+ *        which comes to under 5 KB at 99x99. The window counts take two      *
+ *        bytes per window, about 75 KB at 99x99 for K=5, so a dense 99x99    *
+ *        board takes about 80 KB of its own. The keys and symmetry tables    *
+ *        take another 784 KB at 99x99, but only once for each board size, as *
+ *        every board of that size shares them. A sparse board takes a few    *
+ *        dozen bytes per tile, however big it is.                            *
+ *        Windows are numbered by direction and starting cell, see the        *
+ *        DIRECTIONS table in game.c.                                         *
  ******************************************************************************/
 typedef struct
 {
     Settings *settings;
-    TicTacTile **tiles;
+    int rowWords;
+    BitWord *occupied;
+    BitWord *tiles[TicTacTotal];
+    int emptyCount;
+    unsigned char *lineCounts;
+    int windowStart[NUM_DIRECTIONS];
+    int openLines[TicTacTotal];
+    Coordinates lastMove;
+    unsigned long *zobrist;
+    int numSymmetries;
+    int *symmetry;
+    int *inverse;
+    unsigned long hashes[MAX_SYMMETRIES];
+    int numWords;
+    int numWindows;
+    BOOL sparse;
+    SparseCell *cells;
+    int numSlots;
+    int numCells;
+    Arena *arena;
 } GameBoard;
 
 
 
+/******************************************************************************
+ * MoveFunc: type definition for a function pointer that chooses a move.      *
+ *     Takes the current board, the player to move and the source's own state *
+ *     and returns the coordinates of an empty cell on the board.             *
+ ******************************************************************************/
+typedef Coordinates ( *MoveFunc )( GameBoard*, TicTacTile, void* );
+
+
+
+/******************************************************************************
+ * MoveSource: A struct that holds one way of choosing moves, so that a game  *
+ *             can be played by a person at the terminal or by the computer   *
+ *             without changing the game code. See player.h                   *
+ * Consists of:                                                               *
+ *     name - the name the source was created with, e.g. "random"             *
+ *     getMove - the function that chooses the next move                      *
+ *     state - private data of the source, e.g. a random number generator     *
+ *     deleteState - the function that frees state                            *
+ *     printStats - prints how the last move was chosen, NULL if the source   *
+ *                  has nothing to report                                     *
+ ******************************************************************************/
+typedef struct
+{
+    char *name;
+    MoveFunc getMove;
+    void *state;
+    FreeFunc deleteState;
+    PrintFunc printStats;
+} MoveSource;
+
+
+
 /******************************************************************************
  * TurnLog: A struct that holds the information of a players turn.            *
  * Consists of:                                                               *
@@ -141,40 +344,54 @@ typedef struct
  * Consists of:
  *     settings - if Editor is enabled, each GameLog struct holds a copy of
  *                that game's settings
- *     turnList - a chronological linked list of TurnLog structs
+ *     turnList - a chronological chunked array of TurnLog structs, stored
+ *                by value
+ *     winner - the player who won the game, TicTacNone for a draw or when
+ *              the log was read back from a file, which does not hold it
  ******************************************************************************/
 typedef struct
 {
     #ifdef Editor
     Settings settings;
     #endif
-    LinkedList *turnList;
+    ChunkedArray *turnList;
+    TicTacTile winner;
 } GameLog;
 
 
 
 /* Function Prototypes */
 
-void gameLoop( Settings* );
-GameLog *playGame( Settings* );
+BOOL gameLoop( Settings*, MoveSource**, LogOptions* );
+GameLog *playGame( Settings*, MoveSource**, ChunkedArray*, Arena* );
 void displaySettings( Settings* );
 void editSettings( Settings* );
-void displayLog( LinkedList*, Settings* );
-void saveLog( LinkedList*, Settings* );
+void displayLog( ChunkedArray*, Settings* );
+void saveLog( ChunkedArray*, Settings*, LogFormat );
 
+BOOL isSparse( Settings* );
 void boardInit( GameBoard*, Settings* );
+GameBoard *boardCreate( Settings*, Arena* );
+void boardReset( GameBoard* );
+void boardCopy( GameBoard*, GameBoard* );
 BOOL placeTile( GameBoard*, TicTacTile, int, int );
+BOOL removeTile( GameBoard*, int, int );
+TicTacTile getTile( GameBoard*, int, int );
 BOOL checkWin( GameBoard*, TicTacTile, int, int );
 int  checkDirection( GameBoard*, TicTacTile, int, int, int, int );
 BOOL checkDraw( GameBoard* );
+int  cellWindows( GameBoard*, int, int, unsigned char** );
+int  canonicalHash( GameBoard*, unsigned long* );
+int  winningCells( GameBoard*, TicTacTile, int*, int );
+int  nearCells( GameBoard*, int, int* );
 void changePlayer( TicTacTile* );
 void newSetting( char*, int* );
 
+void printGame( void*, void*, long );
 void printGameLog( FILE*, void* );
 void printTurnLog( FILE*, void* );
 
 void deleteGameBoard( GameBoard* );
 void deleteGameLog( void* );
-void deleteTurnLog( void* );
 
 #endif
@@ -7,13 +7,19 @@
  *          terminal console.                                                 *
  ******************************************************************************/
 
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
 
 #include "interface.h"
 #include "game.h"
 #include "fileIO.h"
+#include "frame.h"
 
 
 /******************************************************************************
@@ -21,10 +27,21 @@
  * These functions are for drawing purposes only and are not intended for use *
  * outside of interface.c                                                     *
  ******************************************************************************/
-static void _draw_start( void );
-static void _draw_end( void );
 static void _col_set( int );
 static void _col_reset( );
+static void _frame_line( Frame*, int, int, int, int );
+static void _frame_tile( Frame*, TicTacTile );
+static BOOL _terminal_size( int*, int* );
+static void _redraw_view( BoardView*, GameBoard*, BOOL );
+static void _frame_cursor( Frame*, int, int );
+static long _board_bytes( int, int );
+static void _frame_board( Frame*, GameBoard*, int, int, int, int );
+static BOOL _read_coordinates( char*, Coordinates*, int, int );
+static BOOL _pan_command( char*, int*, int* );
+static int _clamp( int, int );
+static int _digits( int );
+static int _left_columns( int );
+static void _frame_margin( Frame*, int );
 
 
 /******************************************************************************
@@ -91,84 +108,180 @@ void welcomeMessage( void )
  * Exports: none                                                              *
  * Purpose: Displays the current board state to the user.                     *
  *          Uses box-drawing characters to draw the board (see interface.h)   *
+ *          The board is composed in a frame and written all at once, so a    *
+ *          large board costs one write instead of a few calls per cell.      *
  ******************************************************************************/
 void drawGameBoard( GameBoard *board )
 {
+    Frame *frame;
     int width, height;
-    int i, j;
 
     width = board->settings->width;
     height = board->settings->height;
 
-    printf( "Current Game Board:\n" );
+    frame = createFrame( _board_bytes( width, height ) );
+    frameText( frame, "Current Game Board:\n" );
+    _frame_board( frame, board, 0, 0, width, height );
+    writeFrame( frame );
+    deleteFrame( frame );
+}
 
-    /* Print column numbers.
-     * each number is in a right-aligned box 4 character wide so that they
-     * can align with the board's columns */
-    printf( " " );
-    for ( i = 0; i < width; i++ )
-    {
-        printf( "%4d", i );
-    }
-    printf( "\n" );
 
-    /* draw top frame */
-    _draw_start( );
-    printf( "  %c", BOX_TOP_LEFT );
-    for ( i = 0; i < width - 1; i++ )
+
+/******************************************************************************
+ * Function: createBoardView                                                  *
+ * Imports: none                                                              *
+ * Returns: pointer to a view with nothing on the screen yet                  *
+ * Purpose: sets up the view a game's board is shown through                  *
+ ******************************************************************************/
+BoardView *createBoardView( void )
+{
+    BoardView *view;
+
+    view = (BoardView*) malloc( sizeof(BoardView) );
+    memset( view, 0, sizeof(BoardView) );
+
+    return view;
+}
+
+
+
+/******************************************************************************
+ * Function: showGameBoard                                                    *
+ * Imports: view - the view the board was last shown through                  *
+ *          board - the board to show                                         *
+ * Exports: none                                                              *
+ * Purpose: brings the board on the screen up to date and leaves the cursor   *
+ *          at the start of the empty lines below it. The first time, when    *
+ *          the terminal has been resized or when the window has moved, the   *
+ *          screen is cleared and the window drawn in full. Otherwise only    *
+ *          the cells that changed are drawn again, one cursor move and tile  *
+ *          each, and the lines below the board are cleared, which on a 22x22 *
+ *          board takes a few dozen bytes instead of over 6 kB.               *
+ *          Only the cells that fit the terminal are drawn, so a board of any *
+ *          size costs as much to show as the terminal has room for.          *
+ *          While the board is updated in place, only the lines below it      *
+ *          scroll, so that no amount of output below it can move the board.  *
+ *          Output that is not a terminal always gets the board in full,      *
+ *          unless it is sparse, which gets a window of DENSE_DIMENSION cells *
+ *          each way.                                                         *
+ ******************************************************************************/
+void showGameBoard( BoardView *view, GameBoard *board )
+{
+    Frame *frame;
+    TicTacTile *shown, tile;
+    int rows, columns, width, height, visibleWidth, visibleHeight;
+    int statusLine, leftColumns, x, y;
+    BOOL fits;
+
+    width = board->settings->width;
+    height = board->settings->height;
+    fits = _terminal_size( &rows, &columns );
+    leftColumns = _left_columns( height );
+    visibleWidth = ( columns - leftColumns - 1 ) / CELL_WIDTH;
+    visibleHeight = ( rows - BOARD_TOP_LINES - 1 - VIEW_STATUS_LINES ) /
+        CELL_HEIGHT;
+    fits = fits && visibleWidth > 0 && visibleHeight > 0;
+    if ( !fits )
     {
-        printf( "%c%c%c%c", BOX_HORIZONTAL, BOX_HORIZONTAL,
-                           BOX_HORIZONTAL, BOX_TOP_T );
+        /* with no terminal to fit, only a sparse board is cut down */
+        visibleWidth = DENSE_DIMENSION;
+        visibleHeight = DENSE_DIMENSION;
     }
-    printf( "%c%c%c%c\n", BOX_HORIZONTAL, BOX_HORIZONTAL,
-                         BOX_HORIZONTAL, BOX_TOP_RIGHT );
+    visibleWidth = visibleWidth < width ? visibleWidth : width;
+    visibleHeight = visibleHeight < height ? visibleHeight : height;
 
-    /* draw rows */
-    for ( i = 0; i < height - 1; i++ )
+    if ( view->inPlace && fits && !view->panned && rows == view->rows &&
+         columns == view->columns && width == view->width &&
+         height == view->height )
     {
-        printf( "%2d%c", i, BOX_VERTICAL );
-
-        for ( j = 0; j < width; j++ )
-        {
-            _draw_end( );
-            printTile( board->tiles[i][j] );
-            _draw_start( );
-            printf( "%c", BOX_VERTICAL );
-        }
-        printf( "\n" );
-
-        printf( "  %c", BOX_LEFT_T );
-        for ( j = 0; j < width - 1; j++ )
+        frame = createFrame( 256 );
+        for ( y = 0; y < visibleHeight; y++ )
         {
-            printf( "%c%c%c%c", BOX_HORIZONTAL, BOX_HORIZONTAL,
-                               BOX_HORIZONTAL, BOX_CROSS );
+            for ( x = 0; x < visibleWidth; x++ )
+            {
+                tile = getTile( board, view->left + x, view->top + y );
+                shown = &view->tiles[y * visibleWidth + x];
+                if ( tile != *shown )
+                {
+                    _frame_cursor( frame,
+                        BOARD_TOP_LINES + 1 + CELL_HEIGHT * y,
+                        leftColumns + 1 + CELL_WIDTH * x );
+                    _frame_tile( frame, tile );
+                    *shown = tile;
+                }
+            }
         }
-        printf( "%c%c%c%c\n", BOX_HORIZONTAL, BOX_HORIZONTAL,
-                             BOX_HORIZONTAL, BOX_RIGHT_T );
+        statusLine = BOARD_TOP_LINES + CELL_HEIGHT * visibleHeight + 1;
+        _frame_cursor( frame, statusLine, 1 );
+        frameEscape( frame, CLEAR_BELOW );
+        writeFrame( frame );
+        deleteFrame( frame );
     }
+    else
+    {
+        view->rows = rows;
+        view->columns = columns;
+        view->width = width;
+        view->height = height;
+        view->visibleWidth = visibleWidth;
+        view->visibleHeight = visibleHeight;
+        view->left = _clamp( view->left, width - visibleWidth );
+        view->top = _clamp( view->top, height - visibleHeight );
+        view->panned = FALSE;
+        _redraw_view( view, board, fits );
+    }
+}
+
+
 
-    /* last row and bottom frame */
-    i = height - 1;
-    printf( "%2d%c", i, BOX_VERTICAL );
-    for ( j = 0; j < width; j++ )
+/******************************************************************************
+ * Function: followBoardView                                                  *
+ * Imports: view - the view a board is shown through                          *
+ *          move - the cell that was just played                              *
+ * Exports: view - with its window centred on the cell if it was outside it   *
+ * Purpose: keeps the last move in sight on a board too big for the terminal. *
+ *          The window only moves when the move is outside it, so most moves  *
+ *          are still drawn in place. It is redrawn by the next showGameBoard.*
+ ******************************************************************************/
+void followBoardView( BoardView *view, Coordinates move )
+{
+    if ( move.x < view->left ||
+         move.x >= view->left + view->visibleWidth )
+    {
+        view->left = move.x - view->visibleWidth / 2;
+        view->panned = TRUE;
+    }
+    if ( move.y < view->top ||
+         move.y >= view->top + view->visibleHeight )
     {
-        _draw_end( );
-        printTile( board->tiles[i][j] );
-        _draw_start( );
-        printf( "%c", BOX_VERTICAL );
+        view->top = move.y - view->visibleHeight / 2;
+        view->panned = TRUE;
     }
-    printf( "\n" );
+}
+
+
+
+/******************************************************************************
+ * Function: deleteBoardView                                                  *
+ * Imports: pointer to a view                                                 *
+ * Exports: none                                                              *
+ * Purpose: lets the whole screen scroll again, leaving the board and         *
+ *          everything below it where it is, and frees the view               *
+ ******************************************************************************/
+void deleteBoardView( BoardView *view )
+{
+    Frame *frame;
 
-    printf( "  %c", BOX_BOTTOM_LEFT );
-    for ( i = 0; i < width - 1; i++ )
+    if ( view->inPlace )
     {
-        printf( "%c%c%c%c", BOX_HORIZONTAL, BOX_HORIZONTAL,
-                           BOX_HORIZONTAL, BOX_BOTTOM_T );
+        frame = createFrame( 16 );
+        frameEscape( frame, SCROLL_RESET );
+        writeFrame( frame );
+        deleteFrame( frame );
     }
-    printf( "%c%c%c%c", BOX_HORIZONTAL, BOX_HORIZONTAL,
-                       BOX_HORIZONTAL, BOX_BOTTOM_RIGHT );
-    _draw_end( );
-    printf( "\n" );
+    free( view->tiles );
+    free( view );
 }
 
 
@@ -249,65 +362,68 @@ int getInt( char *prompt )
 Coordinates getCoordinates( char *prompt, int maxX, int maxY )
 {
     Coordinates coords;
-    char *buffer, *delimPointer;
-    int buffSize;
-    BOOL valid;
-
-    /* allocate enough memory for two numbers, two +/- signs, a comma,
-     * a newline, and a null terminator. Everything else will be discarded */
-    buffSize = MAX_DIGITS * 2 + 5;
-    buffer = (char*) malloc( buffSize * sizeof(char) );
+    /* enough room for two numbers, two +/- signs, a comma, a newline,
+     * and a null terminator. Everything else will be discarded */
+    char buffer[MAX_DIGITS * 2 + 5];
 
     do
     {
         /* get the coordinate string from the user */
         printf( "%s", prompt );
-        fgets( buffer, buffSize, stdin );
+        fgets( buffer, (int) sizeof( buffer ), stdin );
+    }
+    while ( !_read_coordinates( buffer, &coords, maxX, maxY ) );
 
-        /* validate the coordinates and read the values into the struct */
-        valid = validCoordString( buffer );
-        if ( valid )
-        {
-            int i;
-            char *temp;
+    return coords;
+}
 
-            /* read the x and y values as base-10 integers */
-            coords.x = strtol( buffer, &delimPointer, 10 );
-            i = skipSpace( delimPointer );
 
-            temp = delimPointer + i + 1;
-            coords.y = strtol( temp, &delimPointer, 10 );
-            /* the contents of delimPointer are not checked because the 
-             * string is assumed to be valid */
-        }
 
-        /* if the buffer doesn't end with a newline, then there must be
-         * characters left in stdin (leftover from fgets) */
-        if ( buffer[strlen( buffer ) - 1] != '\n' )
+/******************************************************************************
+ * Function: getBoardMove                                                     *
+ * Imports: prompt - the prompt string                                        *
+ *          view - the view the board is shown through                        *
+ *          board - the board to place a tile on                              *
+ * Exports: coordinates on the board                                          *
+ * Purpose: prompts the user for a move like getCoordinates. While the board  *
+ *          is too big for the terminal, the user may also scroll the window  *
+ *          by half its size at a time with one of the PAN keys, after which  *
+ *          the board is shown again and the prompt repeated.                 *
+ ******************************************************************************/
+Coordinates getBoardMove( char *prompt, BoardView *view, GameBoard *board )
+{
+    Coordinates coords;
+    char buffer[MAX_DIGITS * 2 + 5];
+    BOOL scrolls, valid;
+    int dx, dy;
+
+    do
+    {
+        scrolls = view->visibleWidth < board->settings->width ||
+                  view->visibleHeight < board->settings->height;
+        if ( scrolls )
         {
-            /* if buffer is whitespace only,
-             * the coordinates may still be valid */
-            if ( !clearBuffer( ) )
-            {
-                valid = FALSE;
-            }
+            printf( "Scroll the board with %c, %c, %c and %c\n", PAN_UP,
+                PAN_LEFT, PAN_DOWN, PAN_RIGHT );
         }
+        printf( "%s", prompt );
+        fgets( buffer, (int) sizeof( buffer ), stdin );
 
-        if ( !valid )
+        if ( scrolls && _pan_command( buffer, &dx, &dy ) )
         {
-            printErr( "Please enter valid coordinates" );
+            view->left += dx * ( view->visibleWidth / 2 + 1 );
+            view->top += dy * ( view->visibleHeight / 2 + 1 );
+            view->panned = TRUE;
+            showGameBoard( view, board );
+            valid = FALSE;
         }
-        else if ( coords.x >= maxX || coords.y >= maxY ||
-                  coords.x < 0 || coords.y < 0 )
+        else
         {
-            printErr( "Coordinates outside of valid range" );
+            valid = _read_coordinates( buffer, &coords,
+                board->settings->width, board->settings->height );
         }
     }
-    while ( !valid || coords.x >= maxX || coords.y >= maxY ||
-        coords.x < 0 || coords.y < 0 );
-
-    /* clean up */
-    free( buffer );
+    while ( !valid );
 
     return coords;
 }
@@ -498,67 +614,446 @@ void printErr( char *errMsg )
 
 
 /******************************************************************************
- * Function: _draw_start                                                      *
- * Imports: none                                                              *
+ * Function: _col_set                                                         *
+ * Imports: ANSI integer colour code                                          *
  * Exports: none                                                              *
- * Purpose: uses an ANSI sequence to switch to the DEC special character set  *
+ * Purpose: sets the terminal output colour according to the imported value   *
  *                                                                            *
  * Based on information from:                                                 *
- *      https://vt100.net/docs/vt100-ug/table3-9.html                         *
+ *      http://ascii-table.com/ansi-escape-sequences.php                      *
  *      (last accessed 26/10/2019)                                            *
  ******************************************************************************/
-static void _draw_start( void )
+static void _col_set( int col )
 {
-    printf( "%s", DRAW_START );
+    printf( "\x1b[%dm", col );
 }
 
 
 
 /******************************************************************************
- * Function: _draw_end                                                        *
+ * Function: _col_reset                                                       *
  * Imports: none                                                              *
  * Exports: none                                                              *
- * Purpose: switches back to normal ASCII                                     *
+ * Purpose: resets the terminal output colour back to default                 *
  *                                                                            *
  * Based on information from:                                                 *
- *      https://vt100.net/docs/vt100-ug/table3-9.html                         *
- *      (last accessed 26/10/2019                                             *
+ *      http://ascii-table.com/ansi-escape-sequences.php                      *
+ *      (last accessed 26/10/2019)                                            *
  ******************************************************************************/
-static void _draw_end( void )
+static void _col_reset( )
 {
-    printf( "%s", DRAW_END );
+    printf( "%s", COL_RESET );
 }
 
 
 
 /******************************************************************************
- * Function: _col_set                                                         *
- * Imports: ANSI integer colour code                                          *
+ * Function: _frame_line                                                      *
+ * Imports: frame - the frame to draw in                                      *
+ *          width - the width of the board                                    *
+ *          left, middle, right - the box-drawing characters at the left      *
+ *          edge, between columns and at the right edge                       *
  * Exports: none                                                              *
- * Purpose: sets the terminal output colour according to the imported value   *
- *                                                                            *
- * Based on information from:                                                 *
- *      http://ascii-table.com/ansi-escape-sequences.php                      *
- *      (last accessed 26/10/2019)                                            *
+ * Purpose: draws a horizontal line of the board's grid, and ends the line    *
  ******************************************************************************/
-static void _col_set( int col )
+static void _frame_line( Frame *frame, int width, int left, int middle,
+    int right )
 {
-    printf( "\x1b[%dm", col );
+    int i;
+
+    frameBox( frame, left );
+    for ( i = 0; i < width; i++ )
+    {
+        frameBox( frame, BOX_HORIZONTAL );
+        frameBox( frame, BOX_HORIZONTAL );
+        frameBox( frame, BOX_HORIZONTAL );
+        frameBox( frame, i < width - 1 ? middle : right );
+    }
+    frameText( frame, "\n" );
 }
 
 
 
 /******************************************************************************
- * Function: _col_reset                                                       *
+ * Function: _frame_tile                                                      *
+ * Imports: frame - the frame to draw in, tile - the tile to draw             *
+ * Exports: none                                                              *
+ * Purpose: draws a tile the same way printTile prints it. The grid around    *
+ *          it goes back to the terminal's own colour.                        *
+ ******************************************************************************/
+static void _frame_tile( Frame *frame, TicTacTile tile )
+{
+    if ( tile == TicTacX )
+    {
+        frameColour( frame, COL_RED_FG );
+        frameText( frame, " X " );
+    }
+    else if ( tile == TicTacO )
+    {
+        frameColour( frame, COL_GREEN_FG );
+        frameText( frame, " O " );
+    }
+    else
+    {
+        frameText( frame, "   " );
+    }
+    frameColour( frame, FRAME_NO_COLOUR );
+}
+
+
+
+/******************************************************************************
+ * Function: _terminal_size                                                   *
  * Imports: none                                                              *
+ * Returns: TRUE if the output is a terminal, FALSE otherwise                 *
+ * Exports: rows, columns - the size of the terminal, 0 if it is not one      *
+ * Purpose: asks the terminal how big it is, so that a board is only updated  *
+ *          in place while it fits and the terminal has not been resized      *
+ ******************************************************************************/
+static BOOL _terminal_size( int *rows, int *columns )
+{
+    struct winsize size;
+    BOOL terminal;
+
+    terminal = isatty( STDOUT_FILENO ) &&
+               ioctl( STDOUT_FILENO, TIOCGWINSZ, &size ) == 0 &&
+               size.ws_row > 0 && size.ws_col > 0;
+    *rows = terminal ? size.ws_row : 0;
+    *columns = terminal ? size.ws_col : 0;
+
+    return terminal;
+}
+
+
+
+/******************************************************************************
+ * Function: _redraw_view                                                     *
+ * Imports: view - the view to draw the board through                         *
+ *          board - the board                                                 *
+ *          fits - TRUE if the window and its status lines fit the terminal   *
+ * Exports: view - with the tiles of the window as they are now on the screen *
+ * Purpose: clears the screen and draws the whole window, titled with the     *
+ *          part of the board it shows if that is not all of it. If it fits,  *
+ *          the lines below it are then made to scroll on their own, so that  *
+ *          the board can be updated in place from now on.                    *
+ * Notes: the size of the terminal and the window are already in the view     *
+ ******************************************************************************/
+static void _redraw_view( BoardView *view, GameBoard *board, BOOL fits )
+{
+    Frame *frame;
+    char text[128];
+    int x, y, statusLine;
+
+    frame = createFrame( _board_bytes( view->visibleWidth,
+        view->visibleHeight ) + sizeof( text ) );
+    if ( view->inPlace )
+    {
+        frameEscape( frame, SCROLL_RESET );
+        writeFrame( frame );
+    }
+    clearScreen( );
+
+    if ( view->visibleWidth < view->width ||
+         view->visibleHeight < view->height )
+    {
+        sprintf( text, "Current Game Board, columns %d-%d of %d, "
+            "rows %d-%d of %d:", view->left,
+            view->left + view->visibleWidth - 1, view->width, view->top,
+            view->top + view->visibleHeight - 1, view->height );
+        /* the title must not wrap, or the board moves down a line */
+        if ( (int) strlen( text ) >= view->columns )
+        {
+            text[view->columns - 1] = '\0';
+        }
+    }
+    else
+    {
+        strcpy( text, "Current Game Board:" );
+    }
+    frameText( frame, text );
+    frameText( frame, "\n" );
+    _frame_board( frame, board, view->left, view->top, view->visibleWidth,
+        view->visibleHeight );
+
+    view->inPlace = fits;
+    if ( fits )
+    {
+        statusLine = BOARD_TOP_LINES + CELL_HEIGHT * view->visibleHeight + 1;
+        sprintf( text, SCROLL_REGION, statusLine, view->rows );
+        frameEscape( frame, text );
+        _frame_cursor( frame, statusLine, 1 );
+    }
+    writeFrame( frame );
+    deleteFrame( frame );
+
+    view->tiles = (TicTacTile*) realloc( view->tiles, (size_t)
+        view->visibleWidth * view->visibleHeight * sizeof(TicTacTile) );
+    for ( y = 0; y < view->visibleHeight; y++ )
+    {
+        for ( x = 0; x < view->visibleWidth; x++ )
+        {
+            view->tiles[y * view->visibleWidth + x] =
+                getTile( board, view->left + x, view->top + y );
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _frame_cursor                                                    *
+ * Imports: frame - the frame to add the move to                              *
+ *          line, column - where to move the cursor, counted from 1           *
  * Exports: none                                                              *
- * Purpose: resets the terminal output colour back to default                 *
- *                                                                            *
- * Based on information from:                                                 *
- *      http://ascii-table.com/ansi-escape-sequences.php                      *
- *      (last accessed 26/10/2019)                                            *
+ * Purpose: moves the cursor to a place on the screen                         *
  ******************************************************************************/
-static void _col_reset( )
+static void _frame_cursor( Frame *frame, int line, int column )
 {
-    printf( "%s", COL_RESET );
+    char sequence[32];
+
+    sprintf( sequence, CURSOR_TO, line, column );
+    frameEscape( frame, sequence );
+}
+
+
+
+/******************************************************************************
+ * Function: _board_bytes                                                     *
+ * Imports: width, height - the columns and rows of a board to draw           *
+ * Returns: the bytes a frame needs for the board: two lines of 4 characters  *
+ *          per cell, and a colour change per tile                            *
+ ******************************************************************************/
+static long _board_bytes( int width, int height )
+{
+    return ( 2L * height + 4 ) * ( 4L * width + 8 ) + 9L * width * height;
+}
+
+
+
+/******************************************************************************
+ * Function: _frame_board                                                     *
+ * Imports: frame - the frame to draw in                                      *
+ *          board - the board                                                 *
+ *          left, top - the first column and row to draw                      *
+ *          width, height - the number of columns and rows to draw            *
+ * Exports: none                                                              *
+ * Purpose: draws part of the board with its grid, numbered with the columns  *
+ *          and rows of the board, starting at the start of a line            *
+ ******************************************************************************/
+static void _frame_board( Frame *frame, GameBoard *board, int left, int top,
+    int width, int height )
+{
+    int i, j, margin;
+    BOOL wide;
+
+    margin = _left_columns( board->settings->height ) - 1;
+
+    /* Print column numbers.
+     * each number is in a right-aligned box 4 character wide so that they
+     * can align with the board's columns. Numbers too wide for that are
+     * put in a box of two columns, every other column */
+    _frame_margin( frame, margin - 1 );
+    wide = _digits( left + width - 1 ) >= CELL_WIDTH;
+    for ( i = 0; i < width; i++ )
+    {
+        if ( !wide )
+        {
+            frameNumber( frame, left + i, CELL_WIDTH );
+        }
+        else if ( i % 2 == 1 )
+        {
+            frameNumber( frame, left + i, 2 * CELL_WIDTH );
+        }
+    }
+    frameText( frame, "\n" );
+
+    /* draw top frame */
+    _frame_margin( frame, margin );
+    _frame_line( frame, width, BOX_TOP_LEFT, BOX_TOP_T, BOX_TOP_RIGHT );
+
+    /* draw rows, each but the last followed by a line between rows */
+    for ( i = 0; i < height; i++ )
+    {
+        frameNumber( frame, top + i, margin );
+        frameBox( frame, BOX_VERTICAL );
+        for ( j = 0; j < width; j++ )
+        {
+            _frame_tile( frame, getTile( board, left + j, top + i ) );
+            frameBox( frame, BOX_VERTICAL );
+        }
+        frameText( frame, "\n" );
+
+        _frame_margin( frame, margin );
+        if ( i < height - 1 )
+        {
+            _frame_line( frame, width, BOX_LEFT_T, BOX_CROSS, BOX_RIGHT_T );
+        }
+    }
+
+    /* bottom frame */
+    _frame_line( frame, width, BOX_BOTTOM_LEFT, BOX_BOTTOM_T,
+        BOX_BOTTOM_RIGHT );
+}
+
+
+
+/******************************************************************************
+ * Function: _read_coordinates                                                *
+ * Imports: buffer - a line read from the user                                *
+ *          maxX, maxY - the max values of X and Y                            *
+ * Returns: TRUE if the line held two numbers in range, FALSE otherwise       *
+ * Exports: coords - the numbers, if they were valid                          *
+ * Purpose: validates a line of coordinates and reads its values, telling the *
+ *          user what was wrong with it otherwise. Whatever did not fit in    *
+ *          the buffer is discarded.                                          *
+ ******************************************************************************/
+static BOOL _read_coordinates( char *buffer, Coordinates *coords, int maxX,
+    int maxY )
+{
+    char *delimPointer;
+    BOOL valid;
+
+    /* validate the coordinates and read the values into the struct */
+    valid = validCoordString( buffer );
+    if ( valid )
+    {
+        int i;
+        char *temp;
+
+        /* read the x and y values as base-10 integers */
+        coords->x = strtol( buffer, &delimPointer, 10 );
+        i = skipSpace( delimPointer );
+
+        temp = delimPointer + i + 1;
+        coords->y = strtol( temp, &delimPointer, 10 );
+        /* the contents of delimPointer are not checked because the 
+         * string is assumed to be valid */
+    }
+
+    /* if the buffer doesn't end with a newline, then there must be
+     * characters left in stdin (leftover from fgets) */
+    if ( buffer[strlen( buffer ) - 1] != '\n' )
+    {
+        /* if buffer is whitespace only,
+         * the coordinates may still be valid */
+        if ( !clearBuffer( ) )
+        {
+            valid = FALSE;
+        }
+    }
+
+    if ( !valid )
+    {
+        printErr( "Please enter valid coordinates" );
+    }
+    else if ( coords->x >= maxX || coords->y >= maxY ||
+              coords->x < 0 || coords->y < 0 )
+    {
+        printErr( "Coordinates outside of valid range" );
+        valid = FALSE;
+    }
+
+    return valid;
+}
+
+
+
+/******************************************************************************
+ * Function: _pan_command                                                     *
+ * Imports: buffer - a line read from the user                                *
+ * Returns: TRUE if the line is one of the PAN keys, FALSE otherwise          *
+ * Exports: dx, dy - the direction to scroll the board in, -1, 0 or 1         *
+ ******************************************************************************/
+static BOOL _pan_command( char *buffer, int *dx, int *dy )
+{
+    char key;
+    BOOL pan;
+
+    buffer += skipSpace( buffer );
+    key = (char) tolower( (unsigned char) buffer[0] );
+    pan = ( key == PAN_UP || key == PAN_LEFT || key == PAN_DOWN ||
+            key == PAN_RIGHT ) &&
+          buffer[1 + skipSpace( buffer + 1 )] == '\n';
+
+    *dx = key == PAN_LEFT ? -1 : key == PAN_RIGHT ? 1 : 0;
+    *dy = key == PAN_UP ? -1 : key == PAN_DOWN ? 1 : 0;
+
+    return pan;
+}
+
+
+
+/******************************************************************************
+ * Function: _clamp                                                           *
+ * Imports: value - a number, max - the largest value it may have             *
+ * Returns: the value, moved into the range 0 to max                          *
+ ******************************************************************************/
+static int _clamp( int value, int max )
+{
+    if ( value > max )
+    {
+        value = max;
+    }
+    if ( value < 0 )
+    {
+        value = 0;
+    }
+
+    return value;
+}
+
+
+
+/******************************************************************************
+ * Function: _digits                                                          *
+ * Imports: a number, 0 or more                                               *
+ * Returns: the number of digits it is written with                           *
+ ******************************************************************************/
+static int _digits( int value )
+{
+    int digits;
+
+    digits = 1;
+    while ( value >= 10 )
+    {
+        value /= 10;
+        digits++;
+    }
+
+    return digits;
+}
+
+
+
+/******************************************************************************
+ * Function: _left_columns                                                    *
+ * Imports: the height of a board                                             *
+ * Returns: the columns left of the first cell of the board when drawn: the   *
+ *          row numbers, at least 2 wide, and the left of the grid            *
+ ******************************************************************************/
+static int _left_columns( int height )
+{
+    int digits;
+
+    digits = _digits( height - 1 );
+
+    return ( digits > 2 ? digits : 2 ) + 1;
+}
+
+
+
+/******************************************************************************
+ * Function: _frame_margin                                                    *
+ * Imports: frame - the frame to draw in, width - the number of spaces        *
+ * Exports: none                                                              *
+ * Purpose: adds the spaces in front of a line of the grid                    *
+ ******************************************************************************/
+static void _frame_margin( Frame *frame, int width )
+{
+    int i;
+
+    for ( i = 0; i < width; i++ )
+    {
+        frameText( frame, " " );
+    }
 }
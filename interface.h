@@ -64,12 +64,97 @@
 
 
 
+/******************************************************************************
+ * ANSI sequences that move the cursor and limit scrolling, used to update a  *
+ * board already on the screen in place                                       *
+ *     CURSOR_TO - moves the cursor to a line and column, counted from 1      *
+ *     CLEAR_BELOW - clears the screen from the cursor to the end             *
+ *     SCROLL_REGION - makes only the lines from the first to the last given  *
+ *                     scroll, which also moves the cursor to the top left    *
+ *     SCROLL_RESET - lets the whole screen scroll again, keeping the cursor  *
+ *                    where it is                                             *
+ * Based on information from:                                                 *
+ *      https://vt100.net/docs/vt100-ug/chapter3.html                         *
+ ******************************************************************************/
+#define CURSOR_TO     "\x1b[%d;%dH"
+#define CLEAR_BELOW   "\x1b[J"
+#define SCROLL_REGION "\x1b[%d;%dr"
+#define SCROLL_RESET  "\x1b" "7" "\x1b[r" "\x1b" "8"
+
+
+
+/******************************************************************************
+ * The layout of a board drawn by drawGameBoard, in lines and columns of the  *
+ * screen counted from 1, for a board drawn at the top left of the screen.    *
+ * The columns left of the first cell depend on the width of the row numbers  *
+ *     BOARD_TOP_LINES - the lines above the first row of cells: the title,   *
+ *                       the column numbers and the top of the grid           *
+ *     CELL_WIDTH, CELL_HEIGHT - the columns and lines each cell takes, with  *
+ *                               the grid to its right and below it           *
+ * VIEW_STATUS_LINES: the lines kept below the board for the status of the    *
+ *                    game, a board that leaves fewer is shown in a window    *
+ ******************************************************************************/
+#define BOARD_TOP_LINES 3
+#define CELL_WIDTH 4
+#define CELL_HEIGHT 2
+#define VIEW_STATUS_LINES 8
+
+
+
+/******************************************************************************
+ * Keys that scroll a board too big for the terminal, see getBoardMove        *
+ ******************************************************************************/
+#define PAN_UP    'w'
+#define PAN_LEFT  'a'
+#define PAN_DOWN  's'
+#define PAN_RIGHT 'd'
+
+
+
+/******************************************************************************
+ * BoardView: A struct that holds what is on the screen of a board that is    *
+ *            being shown while a game is played. A board too big for the     *
+ *            terminal is shown through a window of the cells that fit.       *
+ * Consists of:                                                               *
+ *     rows, columns - the size of the terminal when the board was last       *
+ *                     drawn in full                                          *
+ *     width, height - the size of the board                                  *
+ *     left, top - the first column and row of the board in the window        *
+ *     visibleWidth, visibleHeight - the columns and rows in the window       *
+ *     tiles - the tile shown in each cell of the window, counted from its    *
+ *             top left, y * visibleWidth + x                                 *
+ *     inPlace - TRUE if the board on the screen can be updated in place:     *
+ *               it has been drawn in full, it fits the terminal and the      *
+ *               lines below it scroll on their own                           *
+ *     panned - TRUE if the window has moved since it was last drawn          *
+ ******************************************************************************/
+typedef struct
+{
+    int rows;
+    int columns;
+    int width;
+    int height;
+    int left;
+    int top;
+    int visibleWidth;
+    int visibleHeight;
+    TicTacTile *tiles;
+    BOOL inPlace;
+    BOOL panned;
+} BoardView;
+
+
+
 /******************************************************************************
  * Function Prototypes                                                        *
  ******************************************************************************/
 GameState menuSelection( char*, const char**, int );
 void welcomeMessage( void );
 void drawGameBoard( GameBoard* );
+BoardView *createBoardView( void );
+void showGameBoard( BoardView*, GameBoard* );
+void followBoardView( BoardView*, Coordinates );
+void deleteBoardView( BoardView* );
 void printTile( TicTacTile );
 
 void clearScreen( void );
@@ -78,6 +163,7 @@ void printErr( char* );
 
 int  getInt( char* );
 Coordinates getCoordinates( char*, int, int );
+Coordinates getBoardMove( char*, BoardView*, GameBoard* );
 BOOL clearBuffer( void );
 BOOL isWhiteSpace( char );
 BOOL validCoordString( char* );
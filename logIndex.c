@@ -0,0 +1,212 @@
+/******************************************************************************
+ * File:---- logIndex.c                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the log index declared in logIndex.h. Records are of  *
+ *           a fixed size and written byte by byte in little endian, so an    *
+ *           index can be read on any machine and any record can be found     *
+ *           with a single seek.                                              *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "logIndex.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Name the index of a log, and move numbers in and out of a record           *
+ ******************************************************************************/
+static char *_index_name( char* );
+static void _put_number( unsigned char*, unsigned long, int );
+static unsigned long _get_number( unsigned char*, int );
+
+
+/******************************************************************************
+ * Function: createIndexFile                                                  *
+ * Imports: name of the log the index is for                                  *
+ * Returns: pointer to the index file, NULL if it could not be created        *
+ * Purpose: creates the index of a log, replacing any old one, and writes its *
+ *          header. The caller closes the file.                               *
+ ******************************************************************************/
+FILE *createIndexFile( char *logName )
+{
+    FILE *file;
+    unsigned char header[INDEX_HEADER];
+    char *name;
+
+    name = _index_name( logName );
+    file = fopen( name, "wb" );
+    if ( file != NULL )
+    {
+        memset( header, 0, INDEX_HEADER );
+        memcpy( header, INDEX_MAGIC, INDEX_MAGIC_LEN );
+        header[INDEX_MAGIC_LEN] = INDEX_VERSION;
+        fwrite( header, 1, INDEX_HEADER, file );
+    }
+    free( name );
+
+    return file;
+}
+
+
+
+/******************************************************************************
+ * Function: writeIndexEntry                                                  *
+ * Imports: file - an index file, entry - the record of the next game         *
+ * Returns: TRUE if writing to the file has failed, FALSE otherwise           *
+ * Purpose: adds the record of a game to the end of an index                  *
+ ******************************************************************************/
+BOOL writeIndexEntry( FILE *file, IndexEntry *entry )
+{
+    unsigned char record[INDEX_RECORD];
+
+    _put_number( record, (unsigned long) entry->offset, 8 );
+    _put_number( record + 8, (unsigned long) entry->turns, 4 );
+    _put_number( record + 12, (unsigned long) entry->settings.width, 2 );
+    _put_number( record + 14, (unsigned long) entry->settings.height, 2 );
+    _put_number( record + 16, (unsigned long) entry->settings.matches, 2 );
+    record[18] = (unsigned char) entry->winner;
+    record[19] = 0;
+
+    return fwrite( record, 1, INDEX_RECORD, file ) != INDEX_RECORD;
+}
+
+
+
+/******************************************************************************
+ * Function: openIndexFile                                                    *
+ * Imports: name of the log to open the index of                              *
+ * Returns: pointer to the index file, NULL if the log has no index or the    *
+ *          index is not valid                                                *
+ * Exports: numGames - the number of games in the index                       *
+ * Purpose: opens the index of a log for reading and checks its header. Only  *
+ *          whole records are counted, so an index cut short by a crash still *
+ *          gives every game it finished writing.                             *
+ ******************************************************************************/
+FILE *openIndexFile( char *logName, long *numGames )
+{
+    FILE *file;
+    unsigned char header[INDEX_HEADER];
+    char *name;
+    long size;
+
+    name = _index_name( logName );
+    file = fopen( name, "rb" );
+    free( name );
+
+    if ( file != NULL )
+    {
+        if ( fread( header, 1, INDEX_HEADER, file ) != INDEX_HEADER ||
+             memcmp( header, INDEX_MAGIC, INDEX_MAGIC_LEN ) != 0 ||
+             header[INDEX_MAGIC_LEN] != INDEX_VERSION ||
+             fseek( file, 0, SEEK_END ) != 0 || ( size = ftell( file ) ) < 0 )
+        {
+            fclose( file );
+            file = NULL;
+        }
+        else
+        {
+            *numGames = ( size - INDEX_HEADER ) / INDEX_RECORD;
+        }
+    }
+
+    return file;
+}
+
+
+
+/******************************************************************************
+ * Function: readIndexEntry                                                   *
+ * Imports: file - an index opened with openIndexFile                         *
+ *          game - the position of the game in the log, from 0                *
+ * Returns: TRUE if the record was read, FALSE if there is no such game       *
+ * Exports: entry - the record of the game                                    *
+ * Purpose: seeks straight to the record of a game and reads it               *
+ ******************************************************************************/
+BOOL readIndexEntry( FILE *file, long game, IndexEntry *entry )
+{
+    unsigned char record[INDEX_RECORD];
+    BOOL found;
+
+    found = game >= 0 &&
+        fseek( file, INDEX_HEADER + game * INDEX_RECORD, SEEK_SET ) == 0 &&
+        fread( record, 1, INDEX_RECORD, file ) == INDEX_RECORD;
+
+    if ( found )
+    {
+        entry->offset = (long) _get_number( record, 8 );
+        entry->turns = (int) _get_number( record + 8, 4 );
+        entry->settings.width = (int) _get_number( record + 12, 2 );
+        entry->settings.height = (int) _get_number( record + 14, 2 );
+        entry->settings.matches = (int) _get_number( record + 16, 2 );
+        entry->settings.tableSize = DEFAULT_TABLE_SIZE;
+        entry->settings.tableSet = FALSE;
+        entry->winner = (TicTacTile) record[18];
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _index_name                                                      *
+ * Imports: name of a log                                                     *
+ * Returns: the name of the log's index, which the caller frees               *
+ * Purpose: names the index after its log, so the two stay together           *
+ ******************************************************************************/
+static char *_index_name( char *logName )
+{
+    char *name;
+
+    name = (char*) malloc( strlen( logName ) + sizeof(INDEX_EXTENSION) );
+    strcpy( name, logName );
+    strcat( name, INDEX_EXTENSION );
+
+    return name;
+}
+
+
+
+/******************************************************************************
+ * Function: _put_number                                                      *
+ * Imports: bytes - where to write, value - the number, size - its width      *
+ * Exports: the number in bytes, lowest byte first                            *
+ * Purpose: writes a number into a record the same way on every machine       *
+ ******************************************************************************/
+static void _put_number( unsigned char *bytes, unsigned long value, int size )
+{
+    int i;
+
+    for ( i = 0; i < size; i++ )
+    {
+        /* two shifts, as a shift by the whole width of a long is undefined */
+        bytes[i] = (unsigned char) ( value & 0xFF );
+        value = ( value >> 4 ) >> 4;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _get_number                                                      *
+ * Imports: bytes - where to read, size - the width of the number             *
+ * Returns: the number, read lowest byte first                                *
+ * Purpose: reads a number written by _put_number                             *
+ ******************************************************************************/
+static unsigned long _get_number( unsigned char *bytes, int size )
+{
+    unsigned long value;
+    int i;
+
+    value = 0;
+    for ( i = size - 1; i >= 0; i-- )
+    {
+        value = ( ( value << 4 ) << 4 ) | bytes[i];
+    }
+
+    return value;
+}
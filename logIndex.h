@@ -0,0 +1,67 @@
+/******************************************************************************
+ * File:---- logIndex.h                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the index file saved next to every log, which holds      *
+ *           where each game of the log starts, its settings and its result,  *
+ *           so that any game can be found without reading the ones before.   *
+ *           Declares functions to write an index and read single entries.    *
+ * Notes:--- the index of LOG is LOG.idx. It starts with INDEX_MAGIC and a    *
+ *           version byte padded to INDEX_HEADER bytes, followed by one       *
+ *           INDEX_RECORD byte record per game, so game n's record is at      *
+ *           INDEX_HEADER + n * INDEX_RECORD. Each record holds, in little    *
+ *           endian: the offset of the game in the log (8 bytes), the number  *
+ *           of turns (4 bytes), M, N and K (2 bytes each), the winner (1     *
+ *           byte) and a reserved byte.                                       *
+ ******************************************************************************/
+
+#ifndef LOGINDEX_H
+#define LOGINDEX_H
+
+#include <stdio.h>
+#include "game.h"
+
+
+/******************************************************************************
+ * INDEX_MAGIC: the first bytes of an index file                              *
+ * INDEX_MAGIC_LEN: the number of bytes in INDEX_MAGIC                        *
+ * INDEX_VERSION: the version of the format written after the magic           *
+ * INDEX_HEADER: the size of the header, in bytes                             *
+ * INDEX_RECORD: the size of each game's record, in bytes                     *
+ * INDEX_EXTENSION: added to the name of a log to get the name of its index   *
+ ******************************************************************************/
+#define INDEX_MAGIC "MNKI"
+#define INDEX_MAGIC_LEN 4
+#define INDEX_VERSION 1
+#define INDEX_HEADER 8
+#define INDEX_RECORD 20
+#define INDEX_EXTENSION ".idx"
+
+
+
+/******************************************************************************
+ * IndexEntry: A struct that holds the index record of one game.              *
+ * Consists of:                                                               *
+ *     offset - the byte the game starts at in the log                        *
+ *     turns - the number of turns logged for the game                        *
+ *     settings - M, N and K of the game                                      *
+ *     winner - the player who won the game, TicTacNone for a draw            *
+ ******************************************************************************/
+typedef struct
+{
+    long offset;
+    int turns;
+    Settings settings;
+    TicTacTile winner;
+} IndexEntry;
+
+
+
+/* Function Prototypes */
+FILE *createIndexFile( char* );
+BOOL writeIndexEntry( FILE*, IndexEntry* );
+FILE *openIndexFile( char*, long* );
+BOOL readIndexEntry( FILE*, long, IndexEntry* );
+
+#endif
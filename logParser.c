@@ -0,0 +1,644 @@
+/******************************************************************************
+ * File:---- logParser.c                                                      *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the text log parser declared in logParser.h           *
+ * Notes:--- the log file is mapped into memory and tokenized in place, so no *
+ *           line is ever copied and the file is read in large sequential     *
+ *           chunks by the kernel instead of through stdio's buffer.          *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "logParser.h"
+#include "binaryLog.h"
+#include "fileIO.h"
+#include "workerPool.h"
+
+
+/******************************************************************************
+ * LogLoader: A struct that holds the logs being parsed by parseLogs, shared  *
+ *            by all of its threads.                                          *
+ * Consists of:                                                               *
+ *     fileNames - the names of the logs                                      *
+ *     logs - the parsed logs, each written by the thread that parsed it      *
+ *     numFiles - the number of logs                                          *
+ *     next - the counter of logs that have been claimed                      *
+ ******************************************************************************/
+typedef struct
+{
+    char **fileNames;
+    ParsedLog **logs;
+    int numFiles;
+    long next;
+} LogLoader;
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Parse logs on several threads, the text of a mapped log and the tokens on  *
+ * each of its lines, or a binary log                                         *
+ ******************************************************************************/
+static void *_load_worker( void* );
+static void _parse_text( ParsedLog*, char*, char*, Settings* );
+static void _parse_binary( ParsedLog*, char*, long, long );
+static ParsedGame *_new_game( ParsedLog*, Settings*, int );
+static BOOL _banner( char**, char* );
+static BOOL _word( char**, char*, char* );
+static BOOL _number( char**, char*, int* );
+static BOOL _line_end( char**, char* );
+static void _skip_line( char**, char* );
+
+
+/******************************************************************************
+ * Function: parseLog                                                         *
+ * Imports: name of a log file                                                *
+ * Returns: pointer to the parsed log, NULL if the file could not be opened   *
+ * Purpose: maps a log saved by saveLog into memory and parses every game in  *
+ *          it. Logs saved with and without Editor are both understood, as    *
+ *          are the banners of older versions of the program. An empty file   *
+ *          gives a log with no games.                                        *
+ *          Binary logs are recognised by their magic and read through a      *
+ *          LogReader instead.                                                *
+ *          Nothing is printed, so that logs can be parsed on any thread.     *
+ ******************************************************************************/
+ParsedLog *parseLog( char *fileName )
+{
+    return parseLogRange( fileName, 0, -1, NULL );
+}
+
+
+
+/******************************************************************************
+ * Function: parseLogs                                                        *
+ * Imports: fileNames - names of the log files                                *
+ *          numFiles - the number of logs                                     *
+ *          numThreads - the number of threads to parse them with             *
+ * Returns: a new array of the parsed logs, in the order of their names, with *
+ *          NULL for any that could not be opened                             *
+ * Purpose: parses a set of logs with parseLog, one thread per log at a time. *
+ ******************************************************************************/
+ParsedLog **parseLogs( char **fileNames, int numFiles, int numThreads )
+{
+    LogLoader loader;
+
+    loader.fileNames = fileNames;
+    loader.logs = (ParsedLog**) malloc( numFiles * sizeof(ParsedLog*) );
+    loader.numFiles = numFiles;
+    loader.next = 0;
+    runWorkers( &loader, 0, numThreads, &_load_worker );
+
+    return loader.logs;
+}
+
+
+
+/******************************************************************************
+ * Function: _load_worker                                                     *
+ * Imports: pointer to the LogLoader struct                                   *
+ * Returns: NULL                                                              *
+ * Exports: the parsed logs claimed by the thread                             *
+ * Purpose: the body of a thread of parseLogs. Claims one log at a time,      *
+ *          since a single log can take far longer to parse than another.     *
+ ******************************************************************************/
+static void *_load_worker( void *data )
+{
+    LogLoader *loader;
+    long file;
+
+    loader = (LogLoader*) data;
+    file = __sync_fetch_and_add( &loader->next, 1 );
+    while ( file < loader->numFiles )
+    {
+        loader->logs[file] = parseLog( loader->fileNames[file] );
+        file = __sync_fetch_and_add( &loader->next, 1 );
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: parseLogRange                                                    *
+ * Imports: fileName - name of a log file                                     *
+ *          start - the offset of the first game to parse                     *
+ *          end - the offset just past the last game to parse, or -1 for the  *
+ *                end of the file                                             *
+ *          settings - the settings of the log, for text logs whose header is *
+ *                     before start, NULL to read them from the log           *
+ * Returns: pointer to the parsed log, NULL if the file could not be opened   *
+ * Purpose: the same as parseLog, but only parses the games between two       *
+ *          offsets, such as the ones in a log's index. Only the pages of the *
+ *          file that hold those games are ever read.                         *
+ ******************************************************************************/
+ParsedLog *parseLogRange( char *fileName, long start, long end,
+    Settings *settings )
+{
+    ParsedLog *log;
+    struct stat info;
+    char *data;
+    int file;
+
+    log = NULL;
+    file = open( fileName, O_RDONLY );
+    if ( file >= 0 && fstat( file, &info ) == 0 )
+    {
+        log = (ParsedLog*) malloc( sizeof(ParsedLog) );
+        log->games = createArray( sizeof(ParsedGame), NULL );
+        log->turns = createArray( sizeof(TurnLog), NULL );
+        log->bytes = (long) info.st_size;
+        log->error = NULL;
+        log->errorLine = 0;
+
+        if ( end < 0 || end > log->bytes )
+        {
+            end = log->bytes;
+        }
+
+        /* an empty file cannot be mapped, and has nothing to parse */
+        if ( info.st_size > 0 && start < end )
+        {
+            data = (char*) mmap( NULL, (size_t) info.st_size, PROT_READ,
+                MAP_PRIVATE, file, 0 );
+            if ( data == (char*) MAP_FAILED )
+            {
+                log->error = "the file could not be mapped into memory";
+            }
+            else
+            {
+                posix_madvise( data + start, (size_t) ( end - start ),
+                    start == 0 ? POSIX_MADV_SEQUENTIAL : POSIX_MADV_WILLNEED );
+                if ( info.st_size >= BINLOG_MAGIC_LEN &&
+                     memcmp( data, BINLOG_MAGIC, BINLOG_MAGIC_LEN ) == 0 )
+                {
+                    _parse_binary( log, fileName, start, end );
+                }
+                else
+                {
+                    _parse_text( log, data + start, data + end, settings );
+                }
+                munmap( data, (size_t) info.st_size );
+            }
+        }
+    }
+
+    if ( file >= 0 )
+    {
+        close( file );
+    }
+
+    return log;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteParsedLog                                                  *
+ * Imports: pointer to a parsed log                                           *
+ * Exports: none                                                              *
+ * Purpose: frees a parsed log along with its games and turns                 *
+ ******************************************************************************/
+void deleteParsedLog( ParsedLog *log )
+{
+    freeArray( log->games );
+    freeArray( log->turns );
+    free( log );
+}
+
+
+
+/******************************************************************************
+ * Function: _parse_text                                                      *
+ * Imports: log - the log to add the games to                                 *
+ *          next - the first character of the text                            *
+ *          end - one past the last character of the text                     *
+ *          settings - the settings of the games until the text gives its     *
+ *                     own, NULL if it gives them before the first game       *
+ * Exports: the games and turns of the text in log, and the first error       *
+ * Purpose: reads the text line by line. Every line is one of:                *
+ *          - a banner: a line of '#' or '-', or a line with "GAME" and the   *
+ *            number of the game, which starts a new game                     *
+ *          - "SETTINGS:", followed by the M:, N: and K: lines. Before the    *
+ *            first banner these are the settings of every game, after a      *
+ *            banner (Editor logs) they are the settings of that game only    *
+ *          - "Turn:", "Player:" and "Location:", which make up one turn      *
+ *          - a blank line                                                    *
+ *          A turn before any banner starts a game of its own.                *
+ ******************************************************************************/
+static void _parse_text( ParsedLog *log, char *next, char *end,
+    Settings *settings )
+{
+    Settings session, *target;
+    ParsedGame *game;
+    TurnLog turn;
+    char *error;
+    char name[2], lead;
+    int value, parts;
+
+    memset( &session, 0, sizeof(Settings) );
+    session.tableSize = DEFAULT_TABLE_SIZE;
+    if ( settings != NULL )
+    {
+        session = *settings;
+    }
+    target = NULL;
+    game = NULL;
+    parts = 0;
+    error = NULL;
+    name[1] = '\0';
+
+    while ( error == NULL && next < end )
+    {
+        log->errorLine++;
+
+        /* skip the indent, then only try the tokens that start with the
+         * first letter of the line */
+        while ( next < end && *next == ' ' )
+        {
+            next++;
+        }
+        lead = next < end ? *next : '\n';
+
+        if ( lead == 'T' && _word( &next, end, "Turn:" ) )
+        {
+            if ( parts != 0 )
+            {
+                error = "a turn is missing its player or location";
+            }
+            else if ( !_number( &next, end, &turn.turnNum ) )
+            {
+                error = "the turn number is missing";
+            }
+            else if ( game == NULL )
+            {
+                game = _new_game( log, &session, log->games->size + 1 );
+            }
+            target = NULL;
+            parts = 1;
+        }
+        else if ( lead == 'P' && _word( &next, end, "Player:" ) )
+        {
+            if ( parts != 1 )
+            {
+                error = "a player is not part of a turn";
+            }
+            else if ( _word( &next, end, "X" ) )
+            {
+                turn.player = TicTacX;
+            }
+            else if ( _word( &next, end, "O" ) )
+            {
+                turn.player = TicTacO;
+            }
+            else
+            {
+                error = "the player is not X or O";
+            }
+            parts = 2;
+        }
+        else if ( lead == 'L' && _word( &next, end, "Location:" ) )
+        {
+            if ( parts != 2 )
+            {
+                error = "a location is not part of a turn";
+            }
+            else if ( !_number( &next, end, &turn.location.x ) ||
+                      !_word( &next, end, "," ) ||
+                      !_number( &next, end, &turn.location.y ) )
+            {
+                error = "the location is not two numbers";
+            }
+            else if ( game->settings.width == 0 )
+            {
+                error = "a game has turns but no settings";
+            }
+            else if ( arrayAppend( log->turns, &turn ) == NULL )
+            {
+                error = "the log has more turns than can be held in memory";
+            }
+            else
+            {
+                game->count++;
+            }
+            parts = 0;
+        }
+        else if ( lead == 'S' && _word( &next, end, "SETTINGS:" ) )
+        {
+            if ( game != NULL && game->count > 0 )
+            {
+                error = "the settings of a game come after its turns";
+            }
+            target = game != NULL ? &game->settings : &session;
+        }
+        else if ( _word( &next, end, "M:" ) || _word( &next, end, "N:" ) ||
+                  _word( &next, end, "K:" ) )
+        {
+            /* the letter of the setting is just before the colon */
+            name[0] = next[-2];
+            if ( target == NULL )
+            {
+                error = "a setting is not part of a SETTINGS block";
+            }
+            else if ( !_number( &next, end, &value ) ||
+                      !validSetting( name, value ) )
+            {
+                error = "a setting is missing or out of range";
+            }
+            else if ( name[0] == 'M' )
+            {
+                target->width = value;
+            }
+            else if ( name[0] == 'N' )
+            {
+                target->height = value;
+            }
+            else
+            {
+                target->matches = value;
+            }
+        }
+        else if ( ( lead == 'G' && _word( &next, end, "GAME:" ) ) ||
+                  ( lead == '#' && _banner( &next, end ) ) )
+        {
+            if ( parts != 0 )
+            {
+                error = "the last turn of a game is incomplete";
+            }
+            else if ( !_number( &next, end, &value ) )
+            {
+                error = "the game number is missing";
+            }
+            else
+            {
+                game = _new_game( log, &session, value );
+                target = NULL;
+            }
+            _skip_line( &next, end );
+        }
+        else if ( lead == '#' || lead == '-' )
+        {
+            _skip_line( &next, end );
+        }
+
+        if ( error == NULL && !_line_end( &next, end ) )
+        {
+            error = memchr( next, '\n', end - next ) == NULL ?
+                "the log ends part way through a line" :
+                "the line is not part of a game log";
+        }
+    }
+
+    /* a log cut off part way through a turn is truncated */
+    if ( error == NULL && parts != 0 )
+    {
+        error = "the log ends part way through a turn";
+    }
+
+    log->error = error;
+    if ( error == NULL )
+    {
+        log->errorLine = 0;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _parse_binary                                                    *
+ * Imports: log - the log to add the games to                                 *
+ *          fileName - name of the binary log file                            *
+ *          start - the offset of the first game to read, 0 for the first     *
+ *          end - the offset to stop reading games at                         *
+ * Exports: the games and turns of the file in log, and any error             *
+ * Purpose: reads a binary log one game at a time and copies each game into   *
+ *          the flat arrays of the parsed log                                 *
+ ******************************************************************************/
+static void _parse_binary( ParsedLog *log, char *fileName, long start,
+    long end )
+{
+    FILE *file;
+    LogReader *reader;
+    GameLog gameLog;
+    Settings settings;
+    ParsedGame *game;
+    Arena *arena;
+    long i;
+
+    file = fopen( fileName, "rb" );
+    if ( file == NULL )
+    {
+        log->error = "the file could not be opened";
+    }
+    else
+    {
+        reader = createLogReader( file );
+        if ( start > 0 && !reader->error )
+        {
+            seekLogReader( reader, start );
+        }
+
+        arena = createArena( ARENA_BLOCK_SIZE );
+        while ( log->error == NULL && reader->start + reader->next < end &&
+                readGameLog( reader, &gameLog, &settings, arena ) )
+        {
+            game = _new_game( log, &settings, (int) reader->games );
+            for ( i = 0; i < gameLog.turnList->size && log->error == NULL;
+                  i++ )
+            {
+                if ( arrayAppend( log->turns,
+                         arrayGet( gameLog.turnList, i ) ) == NULL )
+                {
+                    log->error =
+                        "the log has more turns than can be held in memory";
+                }
+                else
+                {
+                    game->count++;
+                }
+            }
+            arenaReset( arena );
+        }
+
+        if ( log->error == NULL && reader->error )
+        {
+            log->error = "the binary log is damaged or truncated";
+        }
+
+        deleteArena( arena );
+        deleteLogReader( reader );
+        fclose( file );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _new_game                                                        *
+ * Imports: log - the log to add the game to                                  *
+ *          settings - the settings of the log, which the game starts with    *
+ *          number - the number of the game                                   *
+ * Returns: pointer to the new game, inside the log's array of games          *
+ * Purpose: adds an empty game that starts at the end of the turns so far     *
+ ******************************************************************************/
+static ParsedGame *_new_game( ParsedLog *log, Settings *settings, int number )
+{
+    ParsedGame game;
+
+    game.settings = *settings;
+    game.number = number;
+    game.first = log->turns->size;
+    game.count = 0;
+
+    return (ParsedGame*) arrayAppend( log->games, &game );
+}
+
+
+
+/******************************************************************************
+ * Function: _banner                                                          *
+ * Imports: next - the position in the text, end - the end of the text        *
+ * Returns: TRUE if the line is a banner with "GAME" in it                    *
+ * Exports: next - just past "GAME" if it was found, unchanged otherwise      *
+ * Purpose: recognises the "###   GAME  1  ###" line of a game banner         *
+ ******************************************************************************/
+static BOOL _banner( char **next, char *end )
+{
+    BOOL found;
+    char *text;
+
+    text = *next;
+    while ( text < end && ( *text == '#' || *text == ' ' ) )
+    {
+        text++;
+    }
+
+    found = text > *next && _word( &text, end, "GAME" );
+    if ( found )
+    {
+        *next = text;
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _word                                                            *
+ * Imports: next - the position in the text, end - the end of the text,       *
+ *          word - the word to look for                                       *
+ * Returns: TRUE if word comes next, after any spaces                         *
+ * Exports: next - just past the word if it was found, unchanged otherwise    *
+ * Purpose: matches a fixed token in place                                    *
+ ******************************************************************************/
+static BOOL _word( char **next, char *end, char *word )
+{
+    char *text;
+
+    text = *next;
+    while ( text < end && ( *text == ' ' || *text == '\t' ) )
+    {
+        text++;
+    }
+
+    /* compared by hand, the words are too short to be worth a call to
+     * strlen and memcmp on every line */
+    while ( text < end && *word != '\0' && *text == *word )
+    {
+        text++;
+        word++;
+    }
+    if ( *word == '\0' )
+    {
+        *next = text;
+    }
+
+    return *word == '\0';
+}
+
+
+
+/******************************************************************************
+ * Function: _number                                                          *
+ * Imports: next - the position in the text, end - the end of the text        *
+ * Returns: TRUE if a number of up to 9 digits comes next, after any spaces   *
+ * Exports: next - just past the number                                       *
+ *          value - the number                                                *
+ * Purpose: reads a number in place, without copying it out first             *
+ ******************************************************************************/
+static BOOL _number( char **next, char *end, int *value )
+{
+    char *text, *start;
+
+    text = *next;
+    while ( text < end && *text == ' ' )
+    {
+        text++;
+    }
+
+    start = text;
+    *value = 0;
+    while ( text < end && *text >= '0' && *text <= '9' && text - start < 9 )
+    {
+        *value = *value * 10 + ( *text - '0' );
+        text++;
+    }
+    *next = text;
+
+    return text > start && ( text == end || *text < '0' || *text > '9' );
+}
+
+
+
+/******************************************************************************
+ * Function: _line_end                                                        *
+ * Imports: next - the position in the text, end - the end of the text        *
+ * Returns: TRUE if nothing but spaces is left on the line                    *
+ * Exports: next - the start of the next line                                 *
+ * Purpose: finishes a line, which may end in "\r\n" as well as "\n"          *
+ ******************************************************************************/
+static BOOL _line_end( char **next, char *end )
+{
+    BOOL found;
+    char *text;
+
+    text = *next;
+    while ( text < end && ( *text == ' ' || *text == '\t' || *text == '\r' ) )
+    {
+        text++;
+    }
+
+    found = text == end || *text == '\n';
+    if ( found && text < end )
+    {
+        text++;
+    }
+    *next = text;
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _skip_line                                                       *
+ * Imports: next - the position in the text, end - the end of the text        *
+ * Exports: next - the end of the line                                        *
+ * Purpose: passes over the rest of a line that holds nothing to parse        *
+ ******************************************************************************/
+static void _skip_line( char **next, char *end )
+{
+    char *text;
+
+    text = (char*) memchr( *next, '\n', end - *next );
+    *next = text != NULL ? text : end;
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * File:---- logParser.h                                                      *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a parsed game log: every game of a log file with the     *
+ *           turns of all of them in one flat array.                          *
+ *           Declares functions that read logs written by saveLog, in either  *
+ *           format, into a parsed log, on several threads at once if need    *
+ *           be, and free it again.                                           *
+ ******************************************************************************/
+
+#ifndef LOGPARSER_H
+#define LOGPARSER_H
+
+#include "game.h"
+
+
+/******************************************************************************
+ * ParsedGame: A struct that holds one game of a parsed log.                  *
+ * Consists of:                                                               *
+ *     settings - the settings the game was played with                       *
+ *     number - the number of the game in its log, from 1                     *
+ *     first - index of the game's first turn in the log's turns array        *
+ *     count - the number of turns logged for the game                        *
+ ******************************************************************************/
+typedef struct
+{
+    Settings settings;
+    int number;
+    long first;
+    int count;
+} ParsedGame;
+
+
+
+/******************************************************************************
+ * ParsedLog: A struct that holds a parsed log file.                          *
+ * Consists of:                                                               *
+ *     games - a chunked array of ParsedGame structs, in the order of the log *
+ *     turns - a chunked array of the TurnLog structs of every game, one game *
+ *             after another                                                  *
+ *     bytes - the size of the log file                                       *
+ *     error - what is wrong with the log, NULL if nothing is                 *
+ *     errorLine - the line of the log the error was found on, 0 for binary   *
+ *                 logs                                                       *
+ * Notes: parsing stops at the first error, and everything read up to it is   *
+ *        kept, so a damaged log still gives back its earlier games.          *
+ ******************************************************************************/
+typedef struct
+{
+    ChunkedArray *games;
+    ChunkedArray *turns;
+    long bytes;
+    char *error;
+    long errorLine;
+} ParsedLog;
+
+
+
+/* Function Prototypes */
+ParsedLog *parseLog( char* );
+ParsedLog **parseLogs( char**, int, int );
+ParsedLog *parseLogRange( char*, long, long, Settings* );
+void deleteParsedLog( ParsedLog* );
+
+#endif
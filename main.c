@@ -6,45 +6,526 @@
  * Purpose:- the main program of the m-n-k tic-tac-toe game                   *
  ******************************************************************************/
 
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "fileIO.h"
 #include "interface.h"
+#include "player.h"
+#include "simulate.h"
+#include "solve.h"
+#include "replay.h"
+#include "moves.h"
+#include "stats.h"
+#include "rollingLog.h"
+
+
+/******************************************************************************
+ * Options: A struct that holds the command-line options of the program.      *
+ * Consists of:                                                               *
+ *     settingsFile - name of the settings file                               *
+ *     players - names of the move sources of each player, by TicTacTile      *
+ *     simulate - number of games to simulate, 0 to play interactively        *
+ *     threads - number of threads to simulate games with, or to search with  *
+ *               in an interactive game                                       *
+ *     player - the options the move sources are created with                 *
+ *     solve - TRUE to solve the game instead of playing it                   *
+ *     checkpoint - name of the solver's checkpoint file, NULL if none        *
+ *     log - how game logs are saved: their format, whether every game is     *
+ *           saved as soon as it is over, whether saves append to a rolling   *
+ *           log and the size it is rotated at                                *
+ *     replay - name of a log to replay, NULL to play instead                 *
+ *     game - the only game of the log to replay, from 1, 0 for all of them   *
+ *     verify - names of the logs to verify, NULL to play instead             *
+ *     numVerify - the number of logs to verify                               *
+ *     stats - names of the logs to gather statistics over, NULL to play      *
+ *             instead                                                        *
+ *     numStats - the number of logs to gather statistics over                *
+ *     moves - name of a file of moves to play games from, "-" for standard   *
+ *             input, NULL to play interactively                              *
+ *     script - name of the file the "scripted" player's moves are read       *
+ *              from, "-" for standard input, NULL for none                   *
+ ******************************************************************************/
+typedef struct
+{
+    char *settingsFile;
+    char *players[TicTacTotal];
+    long simulate;
+    int threads;
+    PlayerOptions player;
+    BOOL solve;
+    char *checkpoint;
+    LogOptions log;
+    char *replay;
+    long game;
+    char **verify;
+    int numVerify;
+    char **stats;
+    int numStats;
+    char *moves;
+    char *script;
+} Options;
+
+
+/******************************************************************************
+ * DEFAULT_BUDGET: the time the "ai" player takes per move unless --budget is *
+ *                 given, in milliseconds                                     *
+ ******************************************************************************/
+#define DEFAULT_BUDGET 100
+
+
+
+static BOOL _parse_options( int, char**, Options* );
+static BOOL _parse_players( char*, Options* );
+static BOOL _parse_count( char*, long, long* );
+static void _usage( void );
+
 
 int main( int argc, char **argv )
 {
     BOOL error;
     Settings   *gameSettings;
+    Options options;
 
     gameSettings = (Settings*) malloc( sizeof(Settings) );
 
     /* ensure proper usage */
-    if ( argc != 2 )
+    error = _parse_options( argc, argv, &options );
+    if ( error )
+    {
+        _usage( );
+    }
+    else if ( options.script != NULL &&
+              readScript( options.script, &options.player ) )
     {
-        printf( "usage: TicTacToe settings\n" );
         error = TRUE;
     }
+    else if ( options.replay != NULL && options.game > 0 )
+    {
+        error = lookupGame( options.replay, options.game );
+    }
+    else if ( options.replay != NULL )
+    {
+        error = replayLog( options.replay );
+    }
+    else if ( options.verify != NULL )
+    {
+        error = verifyLogs( options.verify, options.numVerify,
+            options.threads );
+    }
+    else if ( options.stats != NULL )
+    {
+        error = archiveStats( options.stats, options.numStats,
+            options.threads );
+    }
     else
     {
         /* try to get settings from the file */
-        error = getSettings( argv[1], gameSettings );
+        error = getSettings( options.settingsFile, gameSettings );
 
-        if ( !error )
+        if ( error )
         {
-            /* print a welcome message and enter the main game loop */
-            welcomeMessage( );
-            gameLoop( gameSettings );
+            printf( "The settings file is invalid, exiting\n" );
+            if ( options.simulate == 0 && options.moves == NULL )
+            {
+                enterToContinue( );
+            }
+        }
+        else if ( options.solve && isSparse( gameSettings ) )
+        {
+            printErr( "Boards this large cannot be solved" );
+            error = TRUE;
+        }
+        else if ( options.moves != NULL )
+        {
+            error = playMoves( gameSettings, options.moves, &options.log );
+        }
+        else if ( denseOnlyPlayers( gameSettings, options.players[TicTacX],
+                      options.players[TicTacO] ) )
+        {
+            error = TRUE;
+        }
+        else if ( options.solve )
+        {
+            error = solveGame( gameSettings, options.checkpoint );
+        }
+        else if ( options.simulate > 0 )
+        {
+            error = simulateGames( gameSettings, options.players,
+                &options.player, options.simulate, options.threads,
+                &options.log );
         }
         else
         {
-            printf( "The settings file is invalid, exiting\n" );
-            enterToContinue( );
+            MoveSource *players[TicTacTotal];
+            int i;
+
+            players[TicTacNone] = NULL;
+            for ( i = TicTacX; i < TicTacTotal; i++ )
+            {
+                options.player.seed = (unsigned long) i;
+                players[i] = createMoveSource( options.players[i],
+                    &options.player );
+            }
+
+            /* print a welcome message and enter the main game loop */
+            welcomeMessage( );
+            error = gameLoop( gameSettings, players, &options.log );
+
+            for ( i = TicTacX; i < TicTacTotal; i++ )
+            {
+                deleteMoveSource( players[i] );
+            }
         }
     }
 
     /* clean up */
+    free( options.player.script );
     free( gameSettings );
 
     return (int) error;
 }
+
+
+
+/******************************************************************************
+ * Function: _parse_options                                                   *
+ * Imports: argument count and argument strings from main                     *
+ * Returns: TRUE if the arguments are invalid, FALSE otherwise                *
+ * Exports: options - the parsed options, with defaults for missing ones      *
+ * Purpose: reads the command-line options. Exactly one argument that is not  *
+ *          an option is expected, which is the name of the settings file,    *
+ *          unless logs are being replayed, verified or analysed. --verify    *
+ *          and --stats take every argument after them as the name of a log.  *
+ ******************************************************************************/
+static BOOL _parse_options( int argc, char **argv, Options *options )
+{
+    BOOL error;
+    BOOL customPlayers;
+    long count;
+    int i;
+
+    error = FALSE;
+    customPlayers = FALSE;
+    count = 0;
+    options->settingsFile = NULL;
+    options->simulate = 0;
+    options->solve = FALSE;
+    options->checkpoint = NULL;
+    options->log.format = LogText;
+    options->log.background = FALSE;
+    options->log.append = FALSE;
+    options->log.maxBytes = (long) LOG_ROTATE_MB << 20;
+    options->replay = NULL;
+    options->game = 0;
+    options->verify = NULL;
+    options->numVerify = 0;
+    options->stats = NULL;
+    options->numStats = 0;
+    options->moves = NULL;
+    options->script = NULL;
+    options->player.script = NULL;
+    options->player.scriptLength = 0;
+    options->player.seed = 0;
+    options->player.budget = DEFAULT_BUDGET;
+    options->player.iterations = 0;
+    options->threads = (int) sysconf( _SC_NPROCESSORS_ONLN );
+    if ( options->threads < 1 )
+    {
+        options->threads = 1;
+    }
+
+    i = 1;
+    while ( !error && i < argc )
+    {
+        if ( strcmp( argv[i], "--simulate" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            error = _parse_count( argv[i], LONG_MAX, &options->simulate );
+        }
+        else if ( strcmp( argv[i], "--threads" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            error = _parse_count( argv[i], INT_MAX, &count );
+            options->threads = (int) count;
+        }
+        else if ( strcmp( argv[i], "--solve" ) == 0 )
+        {
+            options->solve = TRUE;
+        }
+        else if ( strcmp( argv[i], "--checkpoint" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            options->checkpoint = argv[i];
+        }
+        else if ( strcmp( argv[i], "--budget" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            error = _parse_count( argv[i], INT_MAX, &count );
+            options->player.budget = (int) count;
+        }
+        else if ( strcmp( argv[i], "--iterations" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            error = _parse_count( argv[i], LONG_MAX,
+                &options->player.iterations );
+        }
+        else if ( strcmp( argv[i], "--log-format" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            options->log.format = strcmp( argv[i], "binary" ) == 0 ?
+                LogBinary : LogText;
+            error = options->log.format == LogText &&
+                strcmp( argv[i], "text" ) != 0;
+        }
+        #ifndef Secret
+        else if ( strcmp( argv[i], "--save-logs" ) == 0 )
+        {
+            options->log.background = TRUE;
+        }
+        else if ( strcmp( argv[i], "--append-logs" ) == 0 )
+        {
+            options->log.append = TRUE;
+        }
+        else if ( strcmp( argv[i], "--log-size" ) == 0 && i + 1 < argc )
+        {
+            long megabytes;
+            char *end;
+
+            i++;
+            megabytes = strtol( argv[i], &end, 10 );
+            error = *end != '\0' || argv[i][0] < '0' || argv[i][0] > '9' ||
+                megabytes > LONG_MAX >> 20;
+            if ( !error )
+            {
+                options->log.maxBytes = megabytes << 20;
+            }
+        }
+        #endif
+        else if ( strcmp( argv[i], "--replay" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            options->replay = argv[i];
+        }
+        else if ( strcmp( argv[i], "--game" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            error = _parse_count( argv[i], LONG_MAX, &options->game );
+        }
+        else if ( strcmp( argv[i], "--verify" ) == 0 && i + 1 < argc )
+        {
+            options->verify = &argv[i + 1];
+            options->numVerify = argc - i - 1;
+            i = argc;
+        }
+        else if ( strcmp( argv[i], "--stats" ) == 0 && i + 1 < argc )
+        {
+            options->stats = &argv[i + 1];
+            options->numStats = argc - i - 1;
+            i = argc;
+        }
+        else if ( strcmp( argv[i], "--moves" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            options->moves = argv[i];
+        }
+        else if ( strcmp( argv[i], "--script" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            options->script = argv[i];
+        }
+        else if ( strcmp( argv[i], "--players" ) == 0 && i + 1 < argc )
+        {
+            i++;
+            error = _parse_players( argv[i], options );
+            customPlayers = TRUE;
+        }
+        else if ( argv[i][0] != '-' && options->settingsFile == NULL )
+        {
+            options->settingsFile = argv[i];
+        }
+        else
+        {
+            error = TRUE;
+        }
+        i++;
+    }
+
+    if ( options->settingsFile == NULL && options->replay == NULL &&
+         options->verify == NULL && options->stats == NULL )
+    {
+        error = TRUE;
+    }
+    options->player.threads = options->threads;
+
+    /* people play interactive games, the computer plays simulated ones */
+    if ( !error && !customPlayers )
+    {
+        options->players[TicTacNone] = NULL;
+        for ( i = TicTacX; i < TicTacTotal; i++ )
+        {
+            options->players[i] = options->simulate > 0 ? "random" : "human";
+        }
+    }
+
+    if ( !error && options->simulate > 0 )
+    {
+        for ( i = TicTacX; i < TicTacTotal; i++ )
+        {
+            if ( strcmp( options->players[i], "human" ) == 0 )
+            {
+                printErr( "Simulated games cannot have human players" );
+                error = TRUE;
+            }
+        }
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _parse_players                                                   *
+ * Imports: comma separated list of move source names, one per player         *
+ * Returns: TRUE if the list is invalid, FALSE otherwise                      *
+ * Exports: the player names in options                                       *
+ * Purpose: splits the list in place and checks that every name is known.     *
+ ******************************************************************************/
+static BOOL _parse_players( char *list, Options *options )
+{
+    BOOL error;
+    MoveSource *source;
+    char *name;
+    int i;
+
+    error = FALSE;
+    options->players[TicTacNone] = NULL;
+    name = list;
+    i = TicTacX;
+    while ( !error && i < TicTacTotal )
+    {
+        options->players[i] = name;
+        name = strchr( name, ',' );
+
+        /* every player but the last is followed by a comma */
+        if ( ( name == NULL ) != ( i == TicTacTotal - 1 ) )
+        {
+            error = TRUE;
+        }
+        else if ( name != NULL )
+        {
+            *name = '\0';
+            name++;
+        }
+
+        if ( !error )
+        {
+            source = createMoveSource( options->players[i],
+                &options->player );
+            if ( source == NULL )
+            {
+                printErr( "Unknown player type" );
+                error = TRUE;
+            }
+            else
+            {
+                deleteMoveSource( source );
+            }
+        }
+        i++;
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _parse_count                                                     *
+ * Imports: text - the argument of an option                                  *
+ *          max - the largest value the option can hold                       *
+ * Returns: TRUE if the text is not a whole number from 1 to max, FALSE       *
+ *          otherwise                                                         *
+ * Exports: value - the number, left alone if the text is not valid           *
+ * Purpose: reads a count such as the number of games or threads. Anything    *
+ *          after the digits, e.g. "10k", makes the whole argument invalid    *
+ *          rather than being dropped.                                        *
+ ******************************************************************************/
+static BOOL _parse_count( char *text, long max, long *value )
+{
+    long number;
+    char *end;
+    BOOL error;
+
+    errno = 0;
+    number = strtol( text, &end, 10 );
+    error = *end != '\0' || text[0] < '0' || text[0] > '9' ||
+        errno == ERANGE || number <= 0 || number > max;
+    if ( !error )
+    {
+        *value = number;
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _usage                                                           *
+ * Imports: none                                                              *
+ * Exports: none                                                              *
+ * Purpose: prints how the program is meant to be run                         *
+ ******************************************************************************/
+static void _usage( void )
+{
+    printf( "usage: TicTacToe [options] settings\n"
+            "       TicTacToe --replay LOG [--game N]\n"
+            "       TicTacToe [--threads T] --verify LOG...\n"
+            "       TicTacToe [--threads T] --stats LOG...\n"
+            "options:\n"
+            "  --players P1,P2  who makes the moves of each player:\n"
+            "                   human, random, scripted, ai or mcts\n"
+            "  --budget MS      time the ai and mcts players may take per\n"
+            "                   move, defaults to 100 ms\n"
+            "  --iterations N   playouts the mcts player runs per move\n"
+            "                   instead of using its time budget\n" );
+    printf( "  --simulate N     play N games without the user interface\n"
+            "  --threads T      number of threads used to simulate games\n"
+            "                   or by the mcts player, defaults to the\n"
+            "                   number of processors\n" );
+    printf( "  --moves FILE     play games from FILE, or from standard input\n"
+            "                   if FILE is -, one x,y move per line and a\n"
+            "                   blank line after any unfinished game\n"
+            "  --script FILE    moves of the scripted player, read like\n"
+            "                   --moves up to the first blank line\n" );
+    printf( "  --solve          prove whether the game is a win or a draw\n"
+            "  --checkpoint F   save the solve to F as it goes, and carry\n"
+            "                   on from F if it already exists\n" );
+    printf( "  --log-format F   save logs as text (the default) or binary\n" );
+    #ifndef Secret
+    printf( "  --save-logs      save every game to a log as soon as it is\n"
+            "                   over, from a writer thread of its own\n"
+            "  --append-logs    make Save Game Log add only the games played\n"
+            "                   since the last save to one rolling log\n"
+            "  --log-size MB    start a new file once a rolling log reaches\n"
+            "                   MB megabytes, defaults to 64, 0 for never\n" );
+    #endif
+    printf( "  --replay LOG     print the games of a text or binary log and\n"
+            "                   replay them to find how each one ended\n"
+            "  --game N         only replay game N, found through the log's\n"
+            "                   index without reading the games before it\n"
+            "  --verify LOG...  replay every game of the logs on all\n"
+            "                   processors and report any that break the\n"
+            "                   rules or were cut short\n" );
+    printf( "  --stats LOG...   report win rates, game lengths, heatmaps\n"
+            "                   and the most common openings of the logs\n"
+            "                   for each M, N and K, on all processors\n" );
+}
@@ -0,0 +1,603 @@
+/******************************************************************************
+ * File:---- mcts.c                                                           *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the "mcts" move source: Monte Carlo Tree Search with  *
+ *           UCT selection. Several threads grow one shared tree at once      *
+ *           (tree parallelism), kept apart from each other by virtual loss.  *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "mcts.h"
+#include "timer.h"
+#include "bits.h"
+#include "workerPool.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * The parts of the search, only used by mctsMove                             *
+ ******************************************************************************/
+static void _set_up( MctsState*, Settings* );
+static void _free_workers( MctsState* );
+static void *_mcts_worker( void* );
+static void _playout( MctsWorker* );
+static long _visit( MctsWorker*, int, int );
+static BOOL _expand( MctsWorker*, int );
+static int  _select( MctsTree*, int );
+static TicTacTile _rollout( MctsWorker*, TicTacTile );
+static void _backup( MctsWorker*, int, TicTacTile );
+
+
+/******************************************************************************
+ * Function: createMcts                                                       *
+ * Imports: pointer to the options of the source                              *
+ * Returns: pointer to a new MctsState                                        *
+ * Purpose: allocates the state of an "mcts" move source. The tree and the    *
+ *          workers are set up on the first move, once the settings are       *
+ *          known.                                                            *
+ ******************************************************************************/
+MctsState *createMcts( PlayerOptions *options )
+{
+    MctsState *mcts;
+
+    mcts = (MctsState*) calloc( sizeof(MctsState), 1 );
+    mcts->budget = options->budget;
+    mcts->iterations = options->iterations;
+    mcts->threads = options->threads > 0 ? options->threads : 1;
+    mcts->seed = options->seed;
+
+    return mcts;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteMcts                                                       *
+ * Imports: pointer to an MctsState                                           *
+ * Exports: none                                                              *
+ * Purpose: frees the MctsState, its tree and its workers                     *
+ ******************************************************************************/
+void deleteMcts( void *state )
+{
+    MctsState *mcts;
+
+    mcts = (MctsState*) state;
+    _free_workers( mcts );
+    free( mcts->tree.nodes );
+    free( mcts );
+}
+
+
+
+/******************************************************************************
+ * Function: mctsMove                                                         *
+ * Imports: pointer to the game board, player to move, MctsState              *
+ * Returns: the coordinates of the chosen cell                                *
+ * Purpose: starts a new tree at the current position and runs playouts on    *
+ *          every thread until the iteration count or the time budget is used *
+ *          up, then plays the child of the root with the most playouts.      *
+ *          The first worker runs on the calling thread.                      *
+ ******************************************************************************/
+Coordinates mctsMove( GameBoard *board, TicTacTile player, void *state )
+{
+    MctsState *mcts;
+    MctsTree *tree;
+    MctsNode *root, *child;
+    Coordinates move;
+    double start;
+    int i, best;
+
+    mcts = (MctsState*) state;
+    start = wallTime( );
+    _set_up( mcts, board->settings );
+
+    tree = &mcts->tree;
+    tree->used = 1;
+    tree->started = 0;
+    tree->iterations = mcts->iterations;
+    tree->deadline = start + mcts->budget / 1000.0;
+    tree->root = board;
+    tree->player = player;
+    memset( &tree->nodes[0], 0, sizeof(MctsNode) );
+    tree->nodes[0].move = -1;
+
+    runWorkers( mcts->workers, sizeof(MctsWorker), mcts->threads,
+        &_mcts_worker );
+
+    mcts->playouts = 0;
+    for ( i = 0; i < mcts->threads; i++ )
+    {
+        mcts->playouts += mcts->workers[i].playouts;
+    }
+
+    /* the most visited move is the one the search trusts the most */
+    root = &tree->nodes[0];
+    best = -1;
+    for ( i = 0; root->state == MctsExpanded && i < root->count; i++ )
+    {
+        child = &tree->nodes[root->first + i];
+        if ( best < 0 || child->visits > tree->nodes[best].visits )
+        {
+            best = root->first + i;
+        }
+    }
+
+    /* an unexpanded root only happens with no time at all: play nearby */
+    if ( best < 0 )
+    {
+        if ( nearCells( board, MCTS_REACH, mcts->workers[0].cells ) > 0 )
+        {
+            move.x = mcts->workers[0].cells[0] % board->settings->width;
+            move.y = mcts->workers[0].cells[0] / board->settings->width;
+        }
+        else
+        {
+            move.x = board->settings->width / 2;
+            move.y = board->settings->height / 2;
+        }
+        mcts->winRate = 0.0;
+    }
+    else
+    {
+        move.x = tree->nodes[best].move % board->settings->width;
+        move.y = tree->nodes[best].move / board->settings->width;
+        mcts->winRate = tree->nodes[best].visits > 0 ?
+            tree->nodes[best].score / ( 2.0 * tree->nodes[best].visits ) :
+            0.0;
+    }
+
+    mcts->seconds = wallTime( ) - start;
+    mcts->totalPlayouts += mcts->playouts;
+    mcts->totalSeconds += mcts->seconds;
+
+    return move;
+}
+
+
+
+/******************************************************************************
+ * Function: printMctsStats                                                   *
+ * Imports: output stream, MctsState                                          *
+ * Exports: none                                                              *
+ * Purpose: prints how many playouts the last move took and how fast they     *
+ *          ran, along with the throughput over every move made so far.       *
+ ******************************************************************************/
+void printMctsStats( FILE *stream, void *state )
+{
+    MctsState *mcts;
+
+    mcts = (MctsState*) state;
+    fprintf( stream, "Ran %ld playouts on %d threads in %.1f ms "
+        "(%.0f playouts/sec, %.0f over the game)\n",
+        mcts->playouts, mcts->threads, mcts->seconds * 1000.0,
+        mcts->seconds > 0.0 ? mcts->playouts / mcts->seconds : 0.0,
+        mcts->totalSeconds > 0.0 ?
+            mcts->totalPlayouts / mcts->totalSeconds : 0.0 );
+    fprintf( stream, "Search tree: %ld of %ld nodes, the chosen move won "
+        "%.1f%% of its playouts\n",
+        mcts->tree.used < mcts->tree.capacity ?
+            mcts->tree.used : mcts->tree.capacity,
+        mcts->tree.capacity, 100.0 * mcts->winRate );
+}
+
+
+
+/******************************************************************************
+ * Function: _set_up                                                          *
+ * Imports: MctsState, the settings of the board about to be searched         *
+ * Exports: the node pool and workers of the MctsState                        *
+ * Purpose: sizes the node pool from the table size in the settings and gives *
+ *          each worker a scratch board and buffers for that board size.      *
+ *          Nothing is allocated again until the settings change.             *
+ ******************************************************************************/
+static void _set_up( MctsState *mcts, Settings *settings )
+{
+    MctsWorker *worker;
+    int i, area;
+
+    if ( mcts->workers == NULL ||
+        mcts->settings.width != settings->width ||
+        mcts->settings.height != settings->height ||
+        mcts->settings.matches != settings->matches ||
+        mcts->settings.tableSize != settings->tableSize )
+    {
+        _free_workers( mcts );
+        free( mcts->tree.nodes );
+
+        mcts->settings = *settings;
+        mcts->tree.capacity =
+            ( (long) settings->tableSize << 20 ) / sizeof(MctsNode);
+        mcts->tree.nodes = (MctsNode*) malloc(
+            mcts->tree.capacity * sizeof(MctsNode) );
+
+        area = settings->width * settings->height;
+        mcts->workers = (MctsWorker*) calloc( sizeof(MctsWorker),
+            mcts->threads );
+        for ( i = 0; i < mcts->threads; i++ )
+        {
+            worker = &mcts->workers[i];
+            worker->tree = &mcts->tree;
+            worker->board = (GameBoard*) malloc( sizeof(GameBoard) );
+            boardInit( worker->board, &mcts->settings );
+            worker->cells = (int*) malloc( area * sizeof(int) );
+            worker->path = (int*) malloc( ( area + 1 ) * sizeof(int) );
+
+            /* the generator must never be seeded with zero */
+            worker->random = ( mcts->seed * mcts->threads + i ) *
+                0x9E3779B97F4A7C15UL + 1;
+            if ( worker->random == 0 )
+            {
+                worker->random = 1;
+            }
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _free_workers                                                    *
+ * Imports: MctsState                                                         *
+ * Exports: frees the workers and their scratch boards, if there are any      *
+ ******************************************************************************/
+static void _free_workers( MctsState *mcts )
+{
+    int i;
+
+    if ( mcts->workers != NULL )
+    {
+        for ( i = 0; i < mcts->threads; i++ )
+        {
+            deleteGameBoard( mcts->workers[i].board );
+            free( mcts->workers[i].cells );
+            free( mcts->workers[i].path );
+        }
+        free( mcts->workers );
+        mcts->workers = NULL;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _mcts_worker                                                     *
+ * Imports: pointer to an MctsWorker struct                                   *
+ * Returns: NULL                                                              *
+ * Exports: the number of playouts run in the worker                          *
+ * Purpose: the body of a search thread. Runs playouts until the shared       *
+ *          iteration count is used up or the deadline has passed.            *
+ ******************************************************************************/
+static void *_mcts_worker( void *data )
+{
+    MctsWorker *worker;
+    MctsTree *tree;
+    BOOL searching;
+
+    worker = (MctsWorker*) data;
+    tree = worker->tree;
+    worker->playouts = 0;
+
+    searching = TRUE;
+    while ( searching )
+    {
+        if ( tree->iterations > 0 )
+        {
+            searching =
+                __sync_fetch_and_add( &tree->started, 1 ) < tree->iterations;
+        }
+        else if ( ( worker->playouts & MCTS_CHECK_PLAYOUTS ) == 0 )
+        {
+            searching = wallTime( ) < tree->deadline;
+        }
+
+        if ( searching )
+        {
+            _playout( worker );
+            worker->playouts++;
+        }
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: _playout                                                         *
+ * Imports: pointer to an MctsWorker                                          *
+ * Exports: the result of one playout, added to every node on its path        *
+ * Purpose: one iteration of the search. Walks down the tree from the root    *
+ *          choosing children with UCT, expands the first node that has not   *
+ *          been visited yet, finishes the game with random moves and then    *
+ *          updates the nodes on the way back up. Moves are played on the     *
+ *          worker's scratch board, so the shared board is never changed.     *
+ ******************************************************************************/
+static void _playout( MctsWorker *worker )
+{
+    MctsTree *tree;
+    GameBoard *board;
+    TicTacTile player, winner;
+    int node, length, x, y;
+    BOOL over, fresh;
+
+    tree = worker->tree;
+    board = worker->board;
+    boardCopy( board, tree->root );
+    player = tree->player;
+    winner = TicTacNone;
+    over = FALSE;
+    fresh = FALSE;
+
+    node = 0;
+    length = 0;
+    _visit( worker, node, length );
+    length++;
+
+    while ( !over && !fresh && _expand( worker, node ) )
+    {
+        node = _select( tree, node );
+        fresh = _visit( worker, node, length ) == 0;
+        length++;
+
+        x = tree->nodes[node].move % board->settings->width;
+        y = tree->nodes[node].move / board->settings->width;
+        placeTile( board, player, x, y );
+        if ( checkWin( board, player, x, y ) )
+        {
+            winner = player;
+            over = TRUE;
+        }
+        else if ( board->emptyCount == 0 )
+        {
+            over = TRUE;
+        }
+        changePlayer( &player );
+    }
+
+    if ( !over )
+    {
+        winner = _rollout( worker, player );
+    }
+
+    _backup( worker, length, winner );
+}
+
+
+
+/******************************************************************************
+ * Function: _visit                                                           *
+ * Imports: pointer to an MctsWorker, index of a node, its depth in the path  *
+ * Returns: the number of visits the node had before this one                 *
+ * Exports: the node is added to the worker's path and charged with a virtual *
+ *          loss until the playout is backed up                               *
+ ******************************************************************************/
+static long _visit( MctsWorker *worker, int node, int depth )
+{
+    worker->path[depth] = node;
+
+    return __sync_fetch_and_add( &worker->tree->nodes[node].visits,
+        MCTS_VIRTUAL_LOSS );
+}
+
+
+
+/******************************************************************************
+ * Function: _expand                                                          *
+ * Imports: pointer to an MctsWorker, index of a node                         *
+ * Returns: TRUE if the node has children to choose from, FALSE otherwise     *
+ * Purpose: adds a child for every empty cell within MCTS_REACH of a tile, or *
+ *          for the centre cell on an empty board. Only one thread expands a  *
+ *          node; the others treat it as a leaf until it is done. The         *
+ *          children take one block of the pool, claimed with an atomic add,  *
+ *          and are filled in before count and state make them visible.       *
+ ******************************************************************************/
+static BOOL _expand( MctsWorker *worker, int node )
+{
+    MctsTree *tree;
+    MctsNode *parent, *child;
+    GameBoard *board;
+    long first;
+    int count, i;
+
+    tree = worker->tree;
+    board = worker->board;
+    parent = &tree->nodes[node];
+
+    if ( parent->state == MctsLeaf &&
+         __sync_bool_compare_and_swap( &parent->state, MctsLeaf, MctsBusy ) )
+    {
+        count = nearCells( board, MCTS_REACH, worker->cells );
+        if ( count == 0 )
+        {
+            worker->cells[0] = ( board->settings->height / 2 ) *
+                board->settings->width + board->settings->width / 2;
+            count = 1;
+        }
+
+        first = __sync_fetch_and_add( &tree->used, count );
+        if ( first + count > tree->capacity )
+        {
+            parent->state = MctsFull;
+        }
+        else
+        {
+            for ( i = 0; i < count; i++ )
+            {
+                child = &tree->nodes[first + i];
+                child->visits = 0;
+                child->score = 0;
+                child->move = worker->cells[i];
+                child->first = 0;
+                child->count = 0;
+                child->state = MctsLeaf;
+            }
+
+            parent->first = (int) first;
+            parent->count = count;
+            __sync_synchronize( );
+            parent->state = MctsExpanded;
+        }
+    }
+
+    return parent->state == MctsExpanded;
+}
+
+
+
+/******************************************************************************
+ * Function: _select                                                          *
+ * Imports: pointer to the search tree, index of an expanded node             *
+ * Returns: index of the child with the highest UCT value                     *
+ * Purpose: balances the children that have won the most playouts against     *
+ *          the ones that have had the fewest. A child nobody has visited     *
+ *          yet is always taken first. Virtual losses count as visits with    *
+ *          no score, which steers other threads away from busy children.     *
+ *                                                                            *
+ * Based on information from:                                                 *
+ *      https://en.wikipedia.org/wiki/Monte_Carlo_tree_search                 *
+ ******************************************************************************/
+static int _select( MctsTree *tree, int node )
+{
+    MctsNode *parent, *child;
+    double logVisits, value, bestValue;
+    long visits;
+    int i, best;
+
+    parent = &tree->nodes[node];
+    logVisits = log( (double) ( parent->visits > 1 ? parent->visits : 1 ) );
+    best = parent->first;
+    bestValue = -1.0;
+
+    for ( i = 0; i < parent->count && bestValue < HUGE_VAL; i++ )
+    {
+        child = &tree->nodes[parent->first + i];
+        visits = child->visits;
+        if ( visits == 0 )
+        {
+            value = HUGE_VAL;
+        }
+        else
+        {
+            value = child->score / ( 2.0 * visits ) +
+                MCTS_EXPLORE * sqrt( logVisits / visits );
+        }
+
+        if ( value > bestValue )
+        {
+            bestValue = value;
+            best = parent->first + i;
+        }
+    }
+
+    return best;
+}
+
+
+
+/******************************************************************************
+ * Function: _rollout                                                         *
+ * Imports: pointer to an MctsWorker, player to move on its scratch board     *
+ * Returns: the winner of the game, or TicTacNone if it was a draw            *
+ * Purpose: plays uniformly random moves until the game is over. The empty    *
+ *          cells are listed once, and each move swaps its cell out of the    *
+ *          list, so every move takes constant time. The game stops as a draw *
+ *          once neither player has a window left that they could complete.   *
+ ******************************************************************************/
+static TicTacTile _rollout( MctsWorker *worker, TicTacTile player )
+{
+    GameBoard *board;
+    TicTacTile winner;
+    BitWord empty;
+    int count, width, x, y, w, pick, cell;
+    BOOL over;
+
+    board = worker->board;
+    width = board->settings->width;
+
+    count = 0;
+    for ( y = 0; y < board->settings->height; y++ )
+    {
+        for ( w = 0; w < board->rowWords; w++ )
+        {
+            empty = ~board->occupied[y * board->rowWords + w];
+            if ( w == board->rowWords - 1 && width % WORD_BITS != 0 )
+            {
+                empty &= BIT_MASK( width ) - 1;
+            }
+
+            while ( empty != 0 )
+            {
+                x = w * WORD_BITS + LOWEST_BIT( empty );
+                empty &= empty - 1;
+                worker->cells[count] = y * width + x;
+                count++;
+            }
+        }
+    }
+
+    winner = TicTacNone;
+    over = board->openLines[TicTacX] == 0 && board->openLines[TicTacO] == 0;
+    while ( !over && count > 0 )
+    {
+        pick = (int) ( ( nextRandom( &worker->random ) >> 32 ) % count );
+        cell = worker->cells[pick];
+        count--;
+        worker->cells[pick] = worker->cells[count];
+
+        placeTile( board, player, cell % width, cell / width );
+        if ( checkWin( board, player, cell % width, cell / width ) )
+        {
+            winner = player;
+            over = TRUE;
+        }
+        else
+        {
+            over = board->openLines[TicTacX] == 0 &&
+                board->openLines[TicTacO] == 0;
+        }
+        changePlayer( &player );
+    }
+
+    return winner;
+}
+
+
+
+/******************************************************************************
+ * Function: _backup                                                          *
+ * Imports: pointer to an MctsWorker, length of its path, winner of the       *
+ *          playout (TicTacNone for a draw)                                   *
+ * Exports: every node on the path swaps its virtual loss for the real result *
+ * Purpose: each node is scored for the player who moved into it. The root    *
+ *          was moved into by the opponent of the player to move.             *
+ ******************************************************************************/
+static void _backup( MctsWorker *worker, int length, TicTacTile winner )
+{
+    MctsNode *node;
+    TicTacTile mover;
+    int i;
+
+    mover = worker->tree->player;
+    changePlayer( &mover );
+    for ( i = 0; i < length; i++ )
+    {
+        node = &worker->tree->nodes[worker->path[i]];
+        __sync_fetch_and_add( &node->visits, 1 - MCTS_VIRTUAL_LOSS );
+        if ( winner == TicTacNone )
+        {
+            __sync_fetch_and_add( &node->score, 1 );
+        }
+        else if ( winner == mover )
+        {
+            __sync_fetch_and_add( &node->score, 2 );
+        }
+        changePlayer( &mover );
+    }
+}
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * File:---- mcts.h                                                           *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the state of the "mcts" move source, a Monte Carlo Tree  *
+ *           Search that plays random games from the current position and     *
+ *           grows a tree towards the moves that win most often.              *
+ *           Declares the functions that create, run and report on it.        *
+ ******************************************************************************/
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <stdio.h>
+#include "game.h"
+#include "player.h"
+
+
+/******************************************************************************
+ * MCTS_EXPLORE: the exploration constant of UCT. Higher values spread the    *
+ *               playouts more evenly, lower ones follow the best move sooner *
+ * MCTS_VIRTUAL_LOSS: the number of lost playouts a node is charged with      *
+ *                    while a thread is searching below it, so that other     *
+ *                    threads try other moves in the meantime                 *
+ * MCTS_REACH: only empty cells within this many cells of a tile get a node   *
+ * MCTS_CHECK_PLAYOUTS: the clock is read once every MCTS_CHECK_PLAYOUTS + 1  *
+ *                      playouts                                              *
+ ******************************************************************************/
+#define MCTS_EXPLORE 1.0
+#define MCTS_VIRTUAL_LOSS 3
+#define MCTS_REACH 2
+#define MCTS_CHECK_PLAYOUTS 63
+
+
+
+/******************************************************************************
+ * MctsNodeState: how far a node of the tree has been expanded.               *
+ *     MctsLeaf - the node has no children yet                                *
+ *     MctsBusy - a thread is adding the node's children                      *
+ *     MctsExpanded - the children are in place and can be searched           *
+ *     MctsFull - the tree ran out of room, so the node stays a leaf          *
+ ******************************************************************************/
+typedef enum
+{
+    MctsLeaf,
+    MctsBusy,
+    MctsExpanded,
+    MctsFull
+} MctsNodeState;
+
+
+
+/******************************************************************************
+ * MctsNode: A struct that holds one position in the search tree.             *
+ * Consists of:                                                               *
+ *     visits - the number of playouts through the node, including the        *
+ *              virtual losses of playouts that are still running             *
+ *     score - 2 for every playout won by the player who moved into the node, *
+ *             1 for every drawn playout                                      *
+ *     move - the cell (y * width + x) played to reach the node               *
+ *     first - index of the first child, the children are next to each other  *
+ *     count - the number of children, set once the node is MctsExpanded      *
+ *     state - the MctsNodeState of the node                                  *
+ * Notes: visits and score are only changed with atomic adds, and are read    *
+ *        without locks. A slightly stale value only costs a little accuracy  *
+ *        in the choice of child.                                             *
+ ******************************************************************************/
+typedef struct
+{
+    volatile long visits;
+    volatile long score;
+    int move;
+    int first;
+    volatile int count;
+    volatile int state;
+} MctsNode;
+
+
+
+/******************************************************************************
+ * MctsTree: A struct that holds the part of the search shared by all of the  *
+ *           threads searching one move.                                      *
+ * Consists of:                                                               *
+ *     nodes - the pool the tree is built in, nodes[0] is the root            *
+ *     capacity - the number of nodes in the pool                             *
+ *     used - the number of nodes handed out so far                           *
+ *     started - the number of playouts claimed so far                        *
+ *     iterations - the number of playouts to run, 0 to use deadline instead  *
+ *     deadline - the wall time at which the search has to stop               *
+ *     root - the board of the position being searched, never changed         *
+ *     player - the player to move on the root board                          *
+ ******************************************************************************/
+typedef struct
+{
+    MctsNode *nodes;
+    long capacity;
+    volatile long used;
+    volatile long started;
+    long iterations;
+    double deadline;
+    GameBoard *root;
+    TicTacTile player;
+} MctsTree;
+
+
+
+/******************************************************************************
+ * MctsWorker: A struct that holds everything a single search thread needs.   *
+ * Consists of:                                                               *
+ *     tree - the shared search tree                                          *
+ *     board - the thread's scratch board. Each playout copies the root board *
+ *             into it and plays on the copy                                  *
+ *     cells - room for one cell per board cell: the children of a node being *
+ *             expanded, or the empty cells left in a playout                 *
+ *     path - the nodes visited by the current playout, root first            *
+ *     random - state of the thread's random number generator                 *
+ *     playouts - the number of playouts the thread ran for the last move     *
+ *     padding - keeps the counters of neighbouring workers out of each       *
+ *               other's cache lines                                          *
+ * Notes: everything a playout writes to belongs to the worker, so playouts   *
+ *        never allocate memory.                                              *
+ ******************************************************************************/
+typedef struct
+{
+    MctsTree *tree;
+    GameBoard *board;
+    int *cells;
+    int *path;
+    unsigned long random;
+    long playouts;
+    char padding[64];
+} MctsWorker;
+
+
+
+/******************************************************************************
+ * MctsState: the state of an "mcts" move source.                             *
+ * Consists of:                                                               *
+ *     budget - the time allowed for each move, in milliseconds               *
+ *     iterations - the playouts run for each move, 0 to use budget instead   *
+ *     threads - the number of threads that search the tree                   *
+ *     seed - seed of the workers' random number generators                   *
+ *     settings - a copy of the settings the tree and workers were set up     *
+ *                for, so that both can be redone if the settings change      *
+ *     tree - the search tree, rebuilt from the root on every move            *
+ *     workers - one MctsWorker per thread                                    *
+ *     playouts - the number of playouts run for the last move                *
+ *     seconds - the time taken to choose the last move                       *
+ *     winRate - the share of playouts through the chosen move that it won,   *
+ *               counting draws as half a win                                 *
+ *     totalPlayouts, totalSeconds - the same over all moves made so far      *
+ ******************************************************************************/
+typedef struct
+{
+    int budget;
+    long iterations;
+    int threads;
+    unsigned long seed;
+    Settings settings;
+    MctsTree tree;
+    MctsWorker *workers;
+    long playouts;
+    double seconds;
+    double winRate;
+    long totalPlayouts;
+    double totalSeconds;
+} MctsState;
+
+
+
+/* Function Prototypes */
+MctsState *createMcts( PlayerOptions* );
+void deleteMcts( void* );
+Coordinates mctsMove( GameBoard*, TicTacTile, void* );
+void printMctsStats( FILE*, void* );
+
+#endif
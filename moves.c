@@ -0,0 +1,602 @@
+/******************************************************************************
+ * File:---- moves.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the --moves option, which plays games from a file of  *
+ *           moves, or from standard input, one after another on one board.   *
+ *           The moves are read in large blocks and parsed by hand, where     *
+ *           getCoordinates would take an fgets, a strtol and a prompt for    *
+ *           every move. The format of the stream is:                         *
+ *                                                                            *
+ *               [ws] x [ws] comma [ws] y [ws] newline                        *
+ *                                                                            *
+ *           one move per line, in the same coordinates as the game prompt.   *
+ *           X makes the first move of each game and the players take turns.  *
+ *           A game ends when it is won or drawn, or at a blank line, and the *
+ *           next move starts a new one. Lines starting with # are skipped.   *
+ *           Also implements the --script option, which reads the first game  *
+ *           of such a file as the moves of the "scripted" player.            *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "moves.h"
+#include "replay.h"
+#include "asyncLog.h"
+#include "interface.h"
+#include "timer.h"
+
+
+/******************************************************************************
+ * MoveLine: An enumeration of the kinds of line in a move stream.            *
+ *     MoveRead - a move                                                      *
+ *     MoveBlank - a blank line, which ends the current game                  *
+ *     MoveComment - a line starting with #                                   *
+ *     MoveBad - a line that is none of the above                             *
+ *     MoveEnd - the end of the stream                                        *
+ ******************************************************************************/
+typedef enum
+{
+    MoveRead,
+    MoveBlank,
+    MoveComment,
+    MoveBad,
+    MoveEnd
+} MoveLine;
+
+
+
+/******************************************************************************
+ * MoveReader: A struct that holds a move stream being read.                  *
+ * Consists of:                                                               *
+ *     file - the stream                                                      *
+ *     buffer - the block of the stream being parsed                          *
+ *     next - the next byte of the block to parse                             *
+ *     end - the end of the bytes read into the block                         *
+ *     line - the number of the line being parsed, from 1                     *
+ ******************************************************************************/
+typedef struct
+{
+    FILE *file;
+    char buffer[MOVES_BUFFER];
+    char *next;
+    char *end;
+    long line;
+} MoveReader;
+
+
+
+/******************************************************************************
+ * MoveSession: A struct that holds the games played from a move stream.      *
+ * Consists of:                                                               *
+ *     board - the board every game is played on                              *
+ *     autoSave - the background writer that finished games are saved with,   *
+ *                NULL if they are not saved                                  *
+ *     gameLog - the log of the current game, NULL if it is not saved         *
+ *     result - how the current game has gone so far                          *
+ *     player - the player to make the next move                              *
+ *     playing - TRUE while a game is being played                            *
+ *     skipping - TRUE while the rest of a bad game is being skipped          *
+ *     games - the number of games played                                     *
+ *     counts - the number of games that turned out each way, by status       *
+ *     turns - the number of turns played over all games                      *
+ *     badLines - the number of lines that are not moves                      *
+ ******************************************************************************/
+typedef struct
+{
+    GameBoard *board;
+    AsyncLog *autoSave;
+    GameLog *gameLog;
+    VerifyResult result;
+    TicTacTile player;
+    BOOL playing;
+    BOOL skipping;
+    long games;
+    long counts[VerifyUnreadable + 1];
+    long turns;
+    long badLines;
+} MoveSession;
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Parse the lines of a move stream, play their moves and report the games    *
+ ******************************************************************************/
+static int _peek( MoveReader* );
+static MoveLine _read_move( MoveReader*, Coordinates* );
+static BOOL _read_number( MoveReader*, int* );
+static void _skip_blanks( MoveReader* );
+static void _skip_line( MoveReader* );
+static void _play( MoveSession*, Coordinates );
+static void _end_game( MoveSession* );
+static void _report( MoveSession*, char*, double );
+
+
+/******************************************************************************
+ * Function: playMoves                                                        *
+ * Imports: settings - the settings every game is played with                 *
+ *          fileName - name of the file of moves, "-" for standard input      *
+ *          logOptions - how game logs are saved                              *
+ * Returns: TRUE if the stream could not be read, or holds a line that is     *
+ *          not a move or a game that was not played out by the rules, or if  *
+ *          the games could not all be saved                                  *
+ * Purpose: plays every game of a move stream and prints how each of them     *
+ *          ended, then a summary. Nothing is asked of the user. With         *
+ *          --save-logs the games that were won or drawn are saved as they    *
+ *          finish, as in simulateGames.                                      *
+ ******************************************************************************/
+BOOL playMoves( Settings *settings, char *fileName, LogOptions *logOptions )
+{
+    BOOL error;
+    MoveReader *reader;
+    MoveSession session;
+    Coordinates move;
+    MoveLine line;
+    double start;
+    long number;
+
+    reader = (MoveReader*) malloc( sizeof(MoveReader) );
+    reader->file = strcmp( fileName, "-" ) == 0 ? stdin :
+        fopen( fileName, "rb" );
+    error = reader->file == NULL;
+
+    if ( error )
+    {
+        printErr( "Failed to open the file of moves" );
+    }
+    else
+    {
+        memset( &session, 0, sizeof(MoveSession) );
+        session.board = (GameBoard*) malloc( sizeof(GameBoard) );
+        boardInit( session.board, settings );
+        #ifndef Secret
+        if ( logOptions->background )
+        {
+            session.autoSave = createAsyncLog( settings, logOptions,
+                &deleteGameLog );
+        }
+        #endif
+
+        reader->next = reader->buffer;
+        reader->end = reader->buffer;
+        reader->line = 1;
+        start = wallTime( );
+        do
+        {
+            number = reader->line;
+            line = _read_move( reader, &move );
+            if ( line == MoveRead && !session.skipping )
+            {
+                _play( &session, move );
+            }
+            else if ( line == MoveBad )
+            {
+                printf( "line %ld: expected a move such as 1,2\n", number );
+                session.badLines++;
+                if ( session.playing )
+                {
+                    session.result.status = VerifyUnreadable;
+                    session.result.turn++;
+                    _end_game( &session );
+                }
+                session.skipping = TRUE;
+            }
+            else if ( line == MoveBlank || line == MoveEnd )
+            {
+                if ( session.playing )
+                {
+                    _end_game( &session );
+                }
+                session.skipping = FALSE;
+            }
+        }
+        while ( line != MoveEnd );
+
+        error = ferror( reader->file ) != 0;
+        if ( error )
+        {
+            printErr( "Failed to read the file of moves" );
+        }
+        _report( &session, fileName, wallTime( ) - start );
+        error = error || session.badLines > 0 ||
+            session.counts[VerifyWon] + session.counts[VerifyDrawn] <
+            session.games;
+
+        /* clean up */
+        if ( session.autoSave != NULL )
+        {
+            error = closeAsyncLog( session.autoSave ) || error;
+        }
+        deleteGameBoard( session.board );
+        if ( reader->file != stdin )
+        {
+            fclose( reader->file );
+        }
+    }
+
+    free( reader );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: readScript                                                       *
+ * Imports: fileName - name of the file of moves, "-" for standard input      *
+ * Returns: TRUE if the file could not be read, or its first game holds a     *
+ *          line that is not a move                                           *
+ * Exports: options - the moves of the first game of the file as the script   *
+ *                    of the "scripted" player, in a new array that belongs   *
+ *                    to the caller                                           *
+ * Purpose: reads a script in the format of --moves, up to the first blank    *
+ *          line or the end of the file. The moves are not played, so that    *
+ *          they can be checked against the board of each game as it goes,    *
+ *          see ScriptState.                                                  *
+ ******************************************************************************/
+BOOL readScript( char *fileName, PlayerOptions *options )
+{
+    BOOL error;
+    MoveReader *reader;
+    Coordinates move;
+    MoveLine line;
+    int capacity;
+    long number;
+
+    options->script = NULL;
+    options->scriptLength = 0;
+    reader = (MoveReader*) malloc( sizeof(MoveReader) );
+    reader->file = strcmp( fileName, "-" ) == 0 ? stdin :
+        fopen( fileName, "rb" );
+    error = reader->file == NULL;
+
+    if ( error )
+    {
+        printErr( "Failed to open the script" );
+    }
+    else
+    {
+        reader->next = reader->buffer;
+        reader->end = reader->buffer;
+        reader->line = 1;
+        capacity = 0;
+        do
+        {
+            number = reader->line;
+            line = _read_move( reader, &move );
+            if ( line == MoveRead )
+            {
+                /* the script grows by doubling, as a game can be as long
+                 * as the board is big */
+                if ( options->scriptLength == capacity )
+                {
+                    capacity = capacity == 0 ? 16 : capacity * 2;
+                    options->script = (Coordinates*) realloc(
+                        options->script, capacity * sizeof(Coordinates) );
+                }
+                options->script[options->scriptLength] = move;
+                options->scriptLength++;
+            }
+            else if ( line == MoveBad )
+            {
+                printf( "line %ld: expected a move such as 1,2\n", number );
+                error = TRUE;
+            }
+        }
+        while ( !error && line != MoveBlank && line != MoveEnd );
+
+        if ( ferror( reader->file ) != 0 )
+        {
+            printErr( "Failed to read the script" );
+            error = TRUE;
+        }
+        if ( reader->file != stdin )
+        {
+            fclose( reader->file );
+        }
+    }
+
+    if ( error )
+    {
+        free( options->script );
+        options->script = NULL;
+        options->scriptLength = 0;
+    }
+    free( reader );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _peek                                                            *
+ * Imports: pointer to a move reader                                          *
+ * Returns: the next byte of the stream, EOF at its end                       *
+ * Purpose: looks at the next byte without taking it, reading the next block  *
+ *          of the stream once the last one has been parsed                   *
+ ******************************************************************************/
+static int _peek( MoveReader *reader )
+{
+    if ( reader->next == reader->end )
+    {
+        reader->next = reader->buffer;
+        reader->end = reader->buffer +
+            fread( reader->buffer, 1, MOVES_BUFFER, reader->file );
+    }
+
+    return reader->next < reader->end ? (unsigned char) *reader->next : EOF;
+}
+
+
+
+/******************************************************************************
+ * Function: _read_move                                                       *
+ * Imports: pointer to a move reader                                          *
+ * Returns: the kind of line that was read, a MoveLine                        *
+ * Exports: move - the move on the line, if it holds one                      *
+ * Purpose: parses the next line of the stream, and moves past all of it      *
+ ******************************************************************************/
+static MoveLine _read_move( MoveReader *reader, Coordinates *move )
+{
+    MoveLine line;
+    int ch;
+
+    _skip_blanks( reader );
+    ch = _peek( reader );
+    if ( ch == EOF )
+    {
+        line = MoveEnd;
+    }
+    else if ( ch == '\n' )
+    {
+        line = MoveBlank;
+    }
+    else if ( ch == '#' )
+    {
+        line = MoveComment;
+    }
+    else
+    {
+        line = MoveBad;
+        if ( _read_number( reader, &move->x ) )
+        {
+            _skip_blanks( reader );
+            if ( _peek( reader ) == ',' )
+            {
+                reader->next++;
+                _skip_blanks( reader );
+                if ( _read_number( reader, &move->y ) )
+                {
+                    _skip_blanks( reader );
+                    ch = _peek( reader );
+                    if ( ch == '\n' || ch == EOF )
+                    {
+                        line = MoveRead;
+                    }
+                }
+            }
+        }
+    }
+    _skip_line( reader );
+
+    return line;
+}
+
+
+
+/******************************************************************************
+ * Function: _read_number                                                     *
+ * Imports: pointer to a move reader                                          *
+ * Returns: TRUE if a number was read, FALSE if there are no digits to read   *
+ * Exports: value - the number, or a number past MAX_DIMENSION if it is any   *
+ *                  bigger than that, so that it is off every board           *
+ * Purpose: reads the digits of a coordinate                                  *
+ ******************************************************************************/
+static BOOL _read_number( MoveReader *reader, int *value )
+{
+    BOOL found;
+    int ch;
+
+    found = FALSE;
+    *value = 0;
+    ch = _peek( reader );
+    while ( ch >= '0' && ch <= '9' )
+    {
+        if ( *value <= MAX_DIMENSION )
+        {
+            *value = *value * 10 + ( ch - '0' );
+        }
+        found = TRUE;
+        reader->next++;
+        ch = _peek( reader );
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _skip_blanks                                                     *
+ * Imports: pointer to a move reader                                          *
+ * Exports: none                                                              *
+ * Purpose: moves past spaces, tabs and carriage returns, so that files with  *
+ *          DOS line endings read the same as others                          *
+ ******************************************************************************/
+static void _skip_blanks( MoveReader *reader )
+{
+    int ch;
+
+    ch = _peek( reader );
+    while ( ch == ' ' || ch == '\t' || ch == '\r' )
+    {
+        reader->next++;
+        ch = _peek( reader );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _skip_line                                                       *
+ * Imports: pointer to a move reader                                          *
+ * Exports: none                                                              *
+ * Purpose: moves past the rest of the line, including its newline, a block   *
+ *          at a time                                                         *
+ ******************************************************************************/
+static void _skip_line( MoveReader *reader )
+{
+    char *newline;
+    BOOL found;
+
+    found = FALSE;
+    while ( !found && _peek( reader ) != EOF )
+    {
+        newline = (char*) memchr( reader->next, '\n',
+            (size_t) ( reader->end - reader->next ) );
+        found = newline != NULL;
+        reader->next = found ? newline + 1 : reader->end;
+    }
+
+    if ( found )
+    {
+        reader->line++;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _play                                                            *
+ * Imports: session - the games being played                                  *
+ *          move - the next move                                              *
+ * Exports: none                                                              *
+ * Purpose: makes the move for the player whose turn it is, starting a new    *
+ *          game first if there is none. The game logic is the same as in     *
+ *          verifyGame: a move onto a taken cell or off the board ends the    *
+ *          game as illegal and the rest of it is skipped.                    *
+ ******************************************************************************/
+static void _play( MoveSession *session, Coordinates move )
+{
+    TurnLog turn;
+
+    if ( !session->playing )
+    {
+        boardReset( session->board );
+        session->result.status = VerifyUnfinished;
+        session->result.winner = TicTacNone;
+        session->result.turn = 0;
+        session->player = TicTacX;
+        session->playing = TRUE;
+        if ( session->autoSave != NULL )
+        {
+            session->gameLog = (GameLog*) malloc( sizeof(GameLog) );
+            session->gameLog->turnList = createArray( sizeof(TurnLog), NULL );
+            #ifdef Editor
+            session->gameLog->settings = *session->board->settings;
+            #endif
+        }
+    }
+
+    session->result.turn++;
+    if ( !placeTile( session->board, session->player, move.x, move.y ) )
+    {
+        session->result.status = VerifyIllegal;
+        session->skipping = TRUE;
+        _end_game( session );
+    }
+    else
+    {
+        if ( session->gameLog != NULL )
+        {
+            turn.turnNum = session->result.turn;
+            turn.player = session->player;
+            turn.location = move;
+            arrayAppend( session->gameLog->turnList, &turn );
+        }
+
+        if ( checkWin( session->board, session->player, move.x, move.y ) )
+        {
+            session->result.status = VerifyWon;
+            session->result.winner = session->player;
+            _end_game( session );
+        }
+        else if ( checkDraw( session->board ) )
+        {
+            session->result.status = VerifyDrawn;
+            _end_game( session );
+        }
+        changePlayer( &session->player );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _end_game                                                        *
+ * Imports: pointer to the games being played                                 *
+ * Exports: none                                                              *
+ * Purpose: prints how the current game ended and counts it. A game that was  *
+ *          won or drawn is handed to the background writer, if there is one, *
+ *          and any other is thrown away.                                     *
+ ******************************************************************************/
+static void _end_game( MoveSession *session )
+{
+    VerifyResult *result;
+
+    result = &session->result;
+    session->games++;
+    session->counts[result->status]++;
+    session->turns += result->status >= VerifyIllegal ? result->turn - 1 :
+        result->turn;
+    printf( "game %ld: ", session->games );
+    printVerifyResult( stdout, result );
+
+    if ( session->gameLog != NULL && result->status <= VerifyDrawn )
+    {
+        session->gameLog->winner = result->winner;
+        asyncLogGame( session->autoSave, session->gameLog );
+    }
+    else if ( session->gameLog != NULL )
+    {
+        deleteGameLog( session->gameLog );
+    }
+    session->gameLog = NULL;
+    session->playing = FALSE;
+}
+
+
+
+/******************************************************************************
+ * Function: _report                                                          *
+ * Imports: session - the games that were played                              *
+ *          fileName - name of the file of moves                              *
+ *          seconds - the time taken to play them                             *
+ * Exports: none                                                              *
+ * Purpose: prints how many games ended each way, and how fast they were      *
+ *          played                                                            *
+ ******************************************************************************/
+static void _report( MoveSession *session, char *fileName, double seconds )
+{
+    printf( "\nPlayed %ld games from %s in %.3f s (%.0f moves/sec)\n\n",
+        session->games, strcmp( fileName, "-" ) == 0 ? "standard input" :
+        fileName, seconds, seconds > 0.0 ? session->turns / seconds : 0.0 );
+    printf( "  Won:        %10ld\n"
+            "  Drawn:      %10ld\n"
+            "  Unfinished: %10ld\n"
+            "  Illegal:    %10ld\n"
+            "  Unreadable: %10ld\n"
+            "  Bad lines:  %10ld\n"
+            "  Turns:      %10ld\n\n",
+            session->counts[VerifyWon], session->counts[VerifyDrawn],
+            session->counts[VerifyUnfinished],
+            session->counts[VerifyIllegal],
+            session->counts[VerifyUnreadable], session->badLines,
+            session->turns );
+}
@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File:---- moves.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Declares the function behind the --moves option, which plays     *
+ *           games from a stream of moves without the terminal user           *
+ *           interface: no prompts, no screen clears and no waiting for       *
+ *           ENTER, so thousands of recorded games can be played again from   *
+ *           a file or a pipe, and the one behind --script, which reads the   *
+ *           moves of the "scripted" player from the same kind of file.       *
+ ******************************************************************************/
+
+#ifndef MOVES_H
+#define MOVES_H
+
+#include "game.h"
+#include "player.h"
+
+
+/******************************************************************************
+ * MOVES_BUFFER: the number of bytes read from the move stream at a time      *
+ ******************************************************************************/
+#define MOVES_BUFFER 65536
+
+
+
+/* Function Prototypes */
+BOOL playMoves( Settings*, char*, LogOptions* );
+BOOL readScript( char*, PlayerOptions* );
+
+#endif
@@ -0,0 +1,381 @@
+/******************************************************************************
+ * File:---- player.c                                                         *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the move sources that can play a game:                *
+ *               human - asks the user for coordinates                        *
+ *               random - plays a uniformly random empty cell                 *
+ *               scripted - replays a recorded list of moves, see --script    *
+ *               ai - searches the game tree, see ai.c                        *
+ *               mcts - plays random games to find the best move, see mcts.c  *
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "player.h"
+#include "interface.h"
+#include "ai.h"
+#include "mcts.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * The move functions of each source, only reachable through a MoveSource     *
+ ******************************************************************************/
+static Coordinates _human_move( GameBoard*, TicTacTile, void* );
+static Coordinates _random_move( GameBoard*, TicTacTile, void* );
+static Coordinates _scripted_move( GameBoard*, TicTacTile, void* );
+static Coordinates _first_empty( GameBoard* );
+
+
+/******************************************************************************
+ * Function: createMoveSource                                                 *
+ * Imports: name of the source: "human", "random", "scripted", "ai" or "mcts" *
+ *          pointer to the options of the source                              *
+ * Returns: pointer to a new move source, NULL if the name is not recognised  *
+ * Purpose: allocates a move source and its state.                            *
+ *          Every source owns its state, so sources can be used by several    *
+ *          threads at once as long as each thread creates its own.           *
+ ******************************************************************************/
+MoveSource *createMoveSource( char *name, PlayerOptions *options )
+{
+    MoveSource *source;
+
+    source = (MoveSource*) malloc( sizeof(MoveSource) );
+    source->name = name;
+    source->state = NULL;
+    source->deleteState = &free;
+    source->printStats = NULL;
+
+    if ( strcmp( name, "human" ) == 0 )
+    {
+        HumanState *human;
+
+        human = (HumanState*) malloc( sizeof(HumanState) );
+        human->view = NULL;
+
+        source->getMove = &_human_move;
+        source->state = human;
+    }
+    else if ( strcmp( name, "random" ) == 0 )
+    {
+        unsigned long *random;
+
+        /* the generator must never be seeded with zero */
+        random = (unsigned long*) malloc( sizeof(unsigned long) );
+        *random = options->seed * 0x9E3779B97F4A7C15UL + 1;
+        if ( *random == 0 )
+        {
+            *random = 1;
+        }
+
+        source->getMove = &_random_move;
+        source->state = random;
+    }
+    else if ( strcmp( name, "scripted" ) == 0 )
+    {
+        ScriptState *script;
+
+        script = (ScriptState*) malloc( sizeof(ScriptState) );
+        script->moves = options->script;
+        script->count = options->scriptLength;
+
+        source->getMove = &_scripted_move;
+        source->state = script;
+    }
+    else if ( strcmp( name, "ai" ) == 0 )
+    {
+        source->getMove = &aiMove;
+        source->state = createAi( options->budget );
+        source->deleteState = &deleteAi;
+        source->printStats = &printAiStats;
+    }
+    else if ( strcmp( name, "mcts" ) == 0 )
+    {
+        source->getMove = &mctsMove;
+        source->state = createMcts( options );
+        source->deleteState = &deleteMcts;
+        source->printStats = &printMctsStats;
+    }
+    else
+    {
+        free( source );
+        source = NULL;
+    }
+
+    return source;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteMoveSource                                                 *
+ * Imports: pointer to a move source                                          *
+ * Exports: none                                                              *
+ * Purpose: frees the memory allocated for a move source and its state        *
+ * Notes: the moves of a scripted source belong to the caller                 *
+ ******************************************************************************/
+void deleteMoveSource( MoveSource *source )
+{
+    source->deleteState( source->state );
+    free( source );
+}
+
+
+
+/******************************************************************************
+ * Function: isHuman                                                          *
+ * Imports: pointer to a move source                                          *
+ * Returns: TRUE if the source asks the user for moves, FALSE otherwise       *
+ ******************************************************************************/
+BOOL isHuman( MoveSource *source )
+{
+    return source->getMove == &_human_move;
+}
+
+
+
+/******************************************************************************
+ * Function: needsDenseBoard                                                  *
+ * Imports: name of a move source                                             *
+ * Returns: TRUE if the source cannot play on a sparse board, FALSE otherwise *
+ * Purpose: the "ai" and "mcts" sources search with the window counts and     *
+ *          bitboards that only boards that are not sparse have, see isSparse *
+ ******************************************************************************/
+BOOL needsDenseBoard( char *name )
+{
+    return strcmp( name, "ai" ) == 0 || strcmp( name, "mcts" ) == 0;
+}
+
+
+
+/******************************************************************************
+ * Function: denseOnlyPlayers                                                 *
+ * Imports: settings - the settings of the games about to be played           *
+ *          first, second - the names of the move sources of the players      *
+ * Returns: TRUE if a source cannot play on a board with the settings, FALSE  *
+ *          otherwise                                                         *
+ * Purpose: tells the user before a game starts that the computer players     *
+ *          cannot play on a sparse board                                     *
+ ******************************************************************************/
+BOOL denseOnlyPlayers( Settings *settings, char *first, char *second )
+{
+    char message[64];
+    BOOL denseOnly;
+
+    denseOnly = isSparse( settings ) &&
+        ( needsDenseBoard( first ) || needsDenseBoard( second ) );
+    if ( denseOnly )
+    {
+        sprintf( message, "The ai and mcts players need M, N and K up to %d",
+            DENSE_DIMENSION );
+        printErr( message );
+    }
+
+    return denseOnly;
+}
+
+
+
+/******************************************************************************
+ * Function: setBoardView                                                     *
+ * Imports: source - a move source                                            *
+ *          view - the view the board of a game is shown through, NULL once   *
+ *                 the game is over                                           *
+ * Exports: none                                                              *
+ * Purpose: lets a human scroll a board too big for the terminal while they   *
+ *          choose a move. Sources that are not human ignore the view.        *
+ ******************************************************************************/
+void setBoardView( MoveSource *source, BoardView *view )
+{
+    if ( isHuman( source ) )
+    {
+        ( (HumanState*) source->state )->view = view;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: nextRandom                                                       *
+ * Imports: pointer to the state of the generator                             *
+ * Returns: the next pseudo-random number                                     *
+ * Exports: advances the state of the generator                               *
+ * Purpose: a small xorshift* generator. Unlike rand( ), every caller keeps   *
+ *          its own state, so it is safe to use from several threads.         *
+ * Assertions: the state is not zero and unsigned long is 64 bits wide        *
+ *                                                                            *
+ * Based on information from:                                                 *
+ *      https://en.wikipedia.org/wiki/Xorshift#xorshift*                      *
+ ******************************************************************************/
+unsigned long nextRandom( unsigned long *state )
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 2685821657736338717UL;
+}
+
+
+
+/******************************************************************************
+ * Function: _human_move                                                      *
+ * Imports: pointer to the game board, current player, human state            *
+ * Returns: the coordinates entered by the user                               *
+ * Purpose: prompts the user for a tile until coordinates on the board are    *
+ *          entered. The cell may still be taken, which the caller checks.    *
+ *          While the board is shown through a view, the user can scroll it.  *
+ ******************************************************************************/
+static Coordinates _human_move( GameBoard *board, TicTacTile player,
+    void *state )
+{
+    Coordinates move;
+    HumanState *human;
+
+    human = (HumanState*) state;
+    if ( human->view != NULL )
+    {
+        move = getBoardMove( "Place a tile (x,y): ", human->view, board );
+    }
+    else
+    {
+        move = getCoordinates( "Place a tile (x,y): ",
+            board->settings->width, board->settings->height );
+    }
+
+    return move;
+}
+
+
+
+/******************************************************************************
+ * Function: _random_move                                                     *
+ * Imports: pointer to the game board, current player, random state           *
+ * Returns: the coordinates of a random empty cell                            *
+ * Purpose: picks random cells until an empty one is found. On average this   *
+ *          takes area / emptyCount tries, which stays small because games    *
+ *          rarely fill the whole board.                                      *
+ * Assertions: there is at least one empty cell on the board                  *
+ ******************************************************************************/
+static Coordinates _random_move( GameBoard *board, TicTacTile player,
+    void *state )
+{
+    Coordinates move;
+    unsigned long value;
+
+    do
+    {
+        value = nextRandom( (unsigned long*) state );
+        move.x = (int) ( ( value >> 32 ) % board->settings->width );
+        move.y = (int) ( ( value & 0xFFFFFFFFUL ) % board->settings->height );
+    }
+    while ( getTile( board, move.x, move.y ) != TicTacNone );
+
+    return move;
+}
+
+
+
+/******************************************************************************
+ * Function: _scripted_move                                                   *
+ * Imports: pointer to the game board, current player, script state           *
+ * Returns: the next move from the script                                     *
+ * Purpose: works out the current turn from the number of empty cells and     *
+ *          plays the matching move of the script. Falls back to the first    *
+ *          empty cell once the script is used up or the move is not legal.   *
+ ******************************************************************************/
+static Coordinates _scripted_move( GameBoard *board, TicTacTile player,
+    void *state )
+{
+    ScriptState *script;
+    Coordinates move;
+    int turn;
+
+    script = (ScriptState*) state;
+    turn = board->settings->width * board->settings->height -
+        board->emptyCount;
+
+    if ( turn < script->count &&
+         script->moves[turn].x >= 0 &&
+         script->moves[turn].x < board->settings->width &&
+         script->moves[turn].y >= 0 &&
+         script->moves[turn].y < board->settings->height &&
+         getTile( board, script->moves[turn].x, script->moves[turn].y )
+            == TicTacNone )
+    {
+        move = script->moves[turn];
+    }
+    else
+    {
+        move = _first_empty( board );
+    }
+
+    return move;
+}
+
+
+
+/******************************************************************************
+ * Function: _first_empty                                                     *
+ * Imports: pointer to the game board                                         *
+ * Returns: the first empty cell in row order                                 *
+ * Purpose: skips over full words of the occupied bitboard, then finds the    *
+ *          lowest clear bit in the first word that has one. On a sparse      *
+ *          board, looks the cells up one by one instead.                     *
+ * Assertions: there is at least one empty cell on the board                  *
+ ******************************************************************************/
+static Coordinates _first_empty( GameBoard *board )
+{
+    Coordinates move;
+    BitWord *row;
+    int word, cell;
+    BOOL found;
+
+    found = FALSE;
+    move.y = 0;
+    move.x = 0;
+    if ( board->sparse )
+    {
+        /* only cells with tiles are skipped, so this looks at no more than
+         * one cell more than there are tiles */
+        cell = 0;
+        while ( getTile( board, cell % board->settings->width,
+                         cell / board->settings->width ) != TicTacNone )
+        {
+            cell++;
+        }
+        move.x = cell % board->settings->width;
+        move.y = cell / board->settings->width;
+    }
+
+    while ( !found && !board->sparse && move.y < board->settings->height )
+    {
+        row = board->occupied + move.y * board->rowWords;
+        word = 0;
+        while ( !found && word < board->rowWords )
+        {
+            /* padding bits are zero, so they need to be skipped below */
+            if ( row[word] != ~( (BitWord) 0 ) )
+            {
+                move.x = word * WORD_BITS;
+                while ( row[word] & BIT_MASK( move.x ) )
+                {
+                    move.x++;
+                }
+                found = move.x < board->settings->width;
+            }
+            word++;
+        }
+
+        if ( !found )
+        {
+            move.y++;
+        }
+    }
+
+    return move;
+}
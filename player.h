@@ -0,0 +1,84 @@
+/******************************************************************************
+ * File:---- player.h                                                         *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the state of the move sources that need one.             *
+ *           Declares functions for creating and deleting the move sources    *
+ *           (see MoveSource in game.h) that can play a game.                 *
+ ******************************************************************************/
+
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include "game.h"
+#include "interface.h"
+
+
+/******************************************************************************
+ * ScriptState: the state of a "scripted" move source.                        *
+ * Consists of:                                                               *
+ *     moves - the moves of a recorded game, in turn order                    *
+ *     count - the number of moves in the array                               *
+ * Notes: the source plays moves[turn - 1] on each turn. Once the script runs *
+ *        out, or if the scripted cell is taken, it plays the first empty     *
+ *        cell in row order instead.                                          *
+ *        The moves are shared with the PlayerOptions the source was created  *
+ *        with, and belong to the caller.                                     *
+ ******************************************************************************/
+typedef struct
+{
+    Coordinates *moves;
+    int count;
+} ScriptState;
+
+
+
+/******************************************************************************
+ * HumanState: the state of a "human" move source.                            *
+ * Consists of:                                                               *
+ *     view - the view the board is shown through while a game is played,     *
+ *            NULL between games. See setBoardView.                           *
+ ******************************************************************************/
+typedef struct
+{
+    BoardView *view;
+} HumanState;
+
+
+
+/******************************************************************************
+ * PlayerOptions: the options that move sources are created with.             *
+ * Consists of:                                                               *
+ *     seed - seed for sources that make random choices                       *
+ *     budget - the time the "ai" and "mcts" sources may take per move, in    *
+ *              milliseconds                                                  *
+ *     iterations - the playouts the "mcts" source runs per move instead of   *
+ *                  using up its budget, 0 to use the budget                  *
+ *     threads - the number of threads the "mcts" source searches with        *
+ *     script - the moves the "scripted" source plays, NULL for none. See     *
+ *              readScript                                                    *
+ *     scriptLength - the number of moves in script                           *
+ ******************************************************************************/
+typedef struct
+{
+    unsigned long seed;
+    int budget;
+    long iterations;
+    int threads;
+    Coordinates *script;
+    int scriptLength;
+} PlayerOptions;
+
+
+
+/* Function Prototypes */
+MoveSource *createMoveSource( char*, PlayerOptions* );
+void deleteMoveSource( MoveSource* );
+BOOL isHuman( MoveSource* );
+BOOL needsDenseBoard( char* );
+BOOL denseOnlyPlayers( Settings*, char*, char* );
+void setBoardView( MoveSource*, BoardView* );
+unsigned long nextRandom( unsigned long* );
+
+#endif
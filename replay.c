@@ -0,0 +1,706 @@
+/******************************************************************************
+ * File:---- replay.c                                                         *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the --replay option, which prints the games of a      *
+ *           saved log in either format and plays each of them again to find  *
+ *           out how it ended, or only one of them found through the log's    *
+ *           index with --game, and the --verify option, which replays every  *
+ *           game of a set of logs on all processors and reports the games    *
+ *           that break the rules.                                            *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "replay.h"
+#include "binaryLog.h"
+#include "logIndex.h"
+#include "interface.h"
+#include "timer.h"
+#include "workerPool.h"
+
+
+/******************************************************************************
+ * VerifyJob: A struct that names one game to verify.                         *
+ * Consists of:                                                               *
+ *     log - the parsed log the game is in                                    *
+ *     game - the game                                                        *
+ ******************************************************************************/
+typedef struct
+{
+    ParsedLog *log;
+    ParsedGame *game;
+} VerifyJob;
+
+
+
+/******************************************************************************
+ * VerifyWorker: A struct that holds everything a verifier thread needs.      *
+ * Consists of:                                                               *
+ *     fileNames - the shared (read-only) names of the logs                   *
+ *     logs - the shared (read-only) parsed logs, see parseLogs               *
+ *     numFiles - the number of logs                                          *
+ *     jobs - the shared (read-only) games to verify, in report order         *
+ *     results - the shared results, each written by the thread that          *
+ *               verified the game with the same index                        *
+ *     numJobs - the number of games                                          *
+ *     next - the shared counter of games that have been claimed              *
+ *     settings - the settings this worker's board was made for               *
+ *     board - this worker's board, remade only when the settings change      *
+ *     padding - keeps neighbouring workers out of each other's cache lines   *
+ * Notes: as in simulate.c, the only shared value written by more than one    *
+ *        thread is next, which is updated with an atomic add. Results go     *
+ *        into a slot per game, so the report does not depend on which        *
+ *        thread verified which game.                                         *
+ ******************************************************************************/
+typedef struct
+{
+    char **fileNames;
+    ParsedLog **logs;
+    int numFiles;
+    VerifyJob *jobs;
+    VerifyResult *results;
+    long numJobs;
+    long *next;
+    Settings settings;
+    GameBoard *board;
+    char padding[64];
+} VerifyWorker;
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Replay each kind of log, print and replay a single game, and share the     *
+ * work of verifying logs between threads                                     *
+ ******************************************************************************/
+static BOOL _replay_binary( FILE* );
+static BOOL _replay_text( char* );
+static void _replay_game( ParsedGame*, ChunkedArray*, Arena* );
+static void *_verify_worker( void* );
+static VerifyJob *_list_jobs( ParsedLog**, int, long* );
+static BOOL _report( VerifyWorker*, double, int );
+
+
+/******************************************************************************
+ * Function: replayLog                                                        *
+ * Imports: name of a log file                                                *
+ * Returns: TRUE if the file could not be read, FALSE otherwise               *
+ * Purpose: prints the games of a log in the same layout as the View Log      *
+ *          menu, each followed by the outcome found by playing its moves     *
+ *          again on a board. Binary logs are told apart from text logs by    *
+ *          the magic at their start.                                         *
+ ******************************************************************************/
+BOOL replayLog( char *fileName )
+{
+    BOOL error;
+    FILE *file;
+    char magic[BINLOG_MAGIC_LEN];
+
+    file = fopen( fileName, "rb" );
+    error = file == NULL;
+    if ( error )
+    {
+        printErr( "Failed to open the log file" );
+    }
+    else if ( fread( magic, 1, BINLOG_MAGIC_LEN, file ) == BINLOG_MAGIC_LEN &&
+              memcmp( magic, BINLOG_MAGIC, BINLOG_MAGIC_LEN ) == 0 )
+    {
+        rewind( file );
+        error = _replay_binary( file );
+        fclose( file );
+    }
+    else
+    {
+        fclose( file );
+        error = _replay_text( fileName );
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: lookupGame                                                       *
+ * Imports: fileName - name of a log file                                     *
+ *          number - the place of the game in the log, from 1                 *
+ * Returns: TRUE if the game could not be found or read, FALSE otherwise      *
+ * Purpose: prints one game of a log and replays it, like replayLog. If the   *
+ *          log has an index, the game's record gives where it starts and the *
+ *          next record where it ends, so only the bytes of that one game are *
+ *          read however long the log is. A log without an index is parsed    *
+ *          in full to find the game.                                         *
+ ******************************************************************************/
+BOOL lookupGame( char *fileName, long number )
+{
+    BOOL error, indexed;
+    FILE *index;
+    IndexEntry entry, next;
+    ParsedLog *log;
+    ParsedGame *game;
+    Arena *arena;
+    long numGames, end;
+
+    log = NULL;
+    game = NULL;
+    end = -1;
+    index = openIndexFile( fileName, &numGames );
+    indexed = index != NULL;
+    if ( indexed )
+    {
+        if ( readIndexEntry( index, number - 1, &entry ) )
+        {
+            if ( readIndexEntry( index, number, &next ) )
+            {
+                end = next.offset;
+            }
+            log = parseLogRange( fileName, entry.offset, end,
+                &entry.settings );
+        }
+        fclose( index );
+    }
+    else
+    {
+        log = parseLog( fileName );
+        numGames = log != NULL ? log->games->size : 0;
+    }
+
+    if ( log != NULL && log->error == NULL )
+    {
+        if ( indexed && log->games->size == 1 )
+        {
+            game = (ParsedGame*) arrayGet( log->games, 0 );
+        }
+        else if ( !indexed && number >= 1 && number <= numGames )
+        {
+            game = (ParsedGame*) arrayGet( log->games, (int) number - 1 );
+        }
+    }
+
+    error = game == NULL;
+    if ( !indexed && log == NULL )
+    {
+        printErr( "Failed to open the log file" );
+    }
+    else if ( number < 1 || number > numGames )
+    {
+        fprintf( stderr, "The log has %ld games\n", numGames );
+        printErr( "There is no such game in the log" );
+    }
+    else if ( error )
+    {
+        printErr( "The game could not be read from the log" );
+    }
+    else
+    {
+        arena = createArena( ARENA_BLOCK_SIZE );
+        game->number = (int) number;
+        _replay_game( game, log->turns, arena );
+        deleteArena( arena );
+
+        if ( indexed )
+        {
+            printf( "Game %ld of %ld, read %ld of %ld bytes through the "
+                    "index\n", number, numGames,
+                    ( end < 0 ? log->bytes : end ) - entry.offset,
+                    log->bytes );
+        }
+        else
+        {
+            printf( "Game %ld of %ld, found by parsing the whole log as it "
+                    "has no index\n", number, numGames );
+        }
+    }
+
+    if ( log != NULL )
+    {
+        deleteParsedLog( log );
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _replay_binary                                                   *
+ * Imports: an open binary log file                                           *
+ * Returns: TRUE if the log is damaged, FALSE otherwise                       *
+ * Purpose: streams the games of a binary log through a LogReader, so only    *
+ *          one game is held in memory at a time                              *
+ ******************************************************************************/
+static BOOL _replay_binary( FILE *file )
+{
+    BOOL error;
+    LogReader *reader;
+    GameLog gameLog;
+    ParsedGame game;
+    Arena *arena;
+
+    reader = createLogReader( file );
+    arena = createArena( ARENA_BLOCK_SIZE );
+
+    while ( readGameLog( reader, &gameLog, &game.settings, arena ) )
+    {
+        game.number = (int) reader->games;
+        game.first = 0;
+        game.count = gameLog.turnList->size;
+        _replay_game( &game, gameLog.turnList, arena );
+
+        /* the turns and board of a game are not needed after it */
+        arenaReset( arena );
+    }
+
+    error = reader->error || ferror( file );
+    if ( error )
+    {
+        printErr( "The log file is not a valid binary log" );
+    }
+    printf( "%ld games replayed\n", reader->games );
+
+    deleteArena( arena );
+    deleteLogReader( reader );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _replay_text                                                     *
+ * Imports: name of a text log file                                           *
+ * Returns: TRUE if the file could not be read or is damaged                  *
+ * Purpose: parses a whole text log and replays its games one by one. The     *
+ *          games before a damaged line are still replayed.                   *
+ ******************************************************************************/
+static BOOL _replay_text( char *fileName )
+{
+    BOOL error;
+    ParsedLog *log;
+    ParsedGame *game;
+    Arena *arena;
+    int i;
+
+    log = parseLog( fileName );
+    error = log == NULL;
+    if ( error )
+    {
+        printErr( "Failed to open the log file" );
+    }
+    else
+    {
+        arena = createArena( ARENA_BLOCK_SIZE );
+        for ( i = 0; i < log->games->size; i++ )
+        {
+            game = (ParsedGame*) arrayGet( log->games, i );
+            _replay_game( game, log->turns, arena );
+            arenaReset( arena );
+        }
+
+        error = log->error != NULL;
+        if ( error )
+        {
+            fprintf( stderr, "line %ld: %s\n", log->errorLine, log->error );
+            printErr( "The log file is not a valid text log" );
+        }
+        printf( "%ld games replayed\n", log->games->size );
+
+        deleteArena( arena );
+        deleteParsedLog( log );
+    }
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _replay_game                                                     *
+ * Imports: game - the game to replay                                         *
+ *          turns - the array of turns that holds those of the game           *
+ *          arena - arena to allocate the board from                          *
+ * Exports: none                                                              *
+ * Purpose: prints a game, plays its turns on an empty board and prints how   *
+ *          it ended                                                          *
+ ******************************************************************************/
+static void _replay_game( ParsedGame *game, ChunkedArray *turns, Arena *arena )
+{
+    VerifyResult result;
+    long i;
+
+    printf( "##################\n"
+            "###   GAME %2d  ###\n"
+            "##################\n", game->number );
+    printf( "SETTINGS:\n"
+            "  M: %d\n"
+            "  N: %d\n"
+            "  K: %d\n\n",
+            game->settings.width, game->settings.height,
+            game->settings.matches );
+    for ( i = game->first; i < game->first + game->count; i++ )
+    {
+        printTurnLog( stdout, arrayGet( turns, i ) );
+    }
+
+    verifyGame( boardCreate( &game->settings, arena ), turns, game, &result );
+    printf( "Result: " );
+    printVerifyResult( stdout, &result );
+    printf( "\n" );
+}
+
+
+
+/******************************************************************************
+ * Function: verifyGame                                                       *
+ * Imports: board - an empty board made with the settings of the game         *
+ *          turns - the array of turns that holds those of the game           *
+ *          game - the game to verify                                         *
+ * Exports: result - how the game turned out                                  *
+ * Purpose: plays the turns of a logged game through placeTile, checkWin and  *
+ *          checkDraw, the same way playGame does, and stops at the first     *
+ *          turn that breaks the rules. X always moves first and the players  *
+ *          take turns, numbered from 1.                                      *
+ ******************************************************************************/
+void verifyGame( GameBoard *board, ChunkedArray *turns, ParsedGame *game,
+    VerifyResult *result )
+{
+    TurnLog *turn;
+    TicTacTile player;
+    int i;
+
+    result->status = VerifyUnfinished;
+    result->winner = TicTacNone;
+    result->turn = 0;
+    player = TicTacX;
+    i = 0;
+    while ( i < game->count && result->status < VerifyIllegal )
+    {
+        turn = (TurnLog*) arrayGet( turns, game->first + i );
+        result->turn = i + 1;
+
+        if ( result->status == VerifyWon )
+        {
+            result->status = VerifyAfterWin;
+        }
+        else if ( turn->player != player || turn->turnNum != i + 1 )
+        {
+            result->status = VerifyOutOfTurn;
+        }
+        else if ( !placeTile( board, player, turn->location.x,
+                  turn->location.y ) )
+        {
+            result->status = VerifyIllegal;
+        }
+        else if ( checkWin( board, player, turn->location.x,
+                  turn->location.y ) )
+        {
+            result->status = VerifyWon;
+            result->winner = player;
+        }
+        changePlayer( &player );
+        i++;
+    }
+
+    if ( result->status == VerifyUnfinished && checkDraw( board ) )
+    {
+        result->status = VerifyDrawn;
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: printVerifyResult                                                *
+ * Imports: output stream, pointer to the result of a game                    *
+ * Exports: none                                                              *
+ * Purpose: describes how a game turned out, on a line of its own             *
+ ******************************************************************************/
+void printVerifyResult( FILE *stream, VerifyResult *result )
+{
+    switch ( result->status )
+    {
+        case VerifyWon:
+            fprintf( stream, "player %d won on turn %d\n",
+                (int) result->winner, result->turn );
+            break;
+        case VerifyDrawn:
+            fprintf( stream, "draw after %d turns\n", result->turn );
+            break;
+        case VerifyUnfinished:
+            fprintf( stream, "unfinished after %d turns\n", result->turn );
+            break;
+        case VerifyIllegal:
+            fprintf( stream, "turn %d is off the board or on a taken cell\n",
+                result->turn );
+            break;
+        case VerifyOutOfTurn:
+            fprintf( stream, "turn %d is out of turn\n", result->turn );
+            break;
+        case VerifyAfterWin:
+            fprintf( stream, "turn %d comes after the game was won\n",
+                result->turn );
+            break;
+        default:
+            fprintf( stream, "turn %d is not a move\n", result->turn );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: verifyLogs                                                       *
+ * Imports: fileNames - names of the logs to verify, in either format         *
+ *          numFiles - the number of logs                                     *
+ *          numThreads - the number of threads to verify them with            *
+ * Returns: TRUE if any log could not be read or holds a bad game             *
+ * Purpose: parses the logs, one thread per log at a time, then replays all   *
+ *          of their games, sharing the games out between the threads in      *
+ *          batches. The report lists every problem in the order of the       *
+ *          files and games, so it is the same whatever the thread count.     *
+ ******************************************************************************/
+BOOL verifyLogs( char **fileNames, int numFiles, int numThreads )
+{
+    VerifyWorker *workers;
+    ParsedLog **logs;
+    VerifyJob *jobs;
+    VerifyResult *results;
+    long numJobs, next;
+    double start;
+    BOOL error;
+    int i;
+
+    workers = (VerifyWorker*) malloc( numThreads * sizeof(VerifyWorker) );
+
+    start = wallTime( );
+    logs = parseLogs( fileNames, numFiles, numThreads );
+
+    /* every game of every log, in the order they are reported in */
+    jobs = _list_jobs( logs, numFiles, &numJobs );
+    results = (VerifyResult*) malloc( ( numJobs + 1 ) * sizeof(VerifyResult) );
+
+    next = 0;
+    for ( i = 0; i < numThreads; i++ )
+    {
+        memset( &workers[i], 0, sizeof(VerifyWorker) );
+        workers[i].fileNames = fileNames;
+        workers[i].logs = logs;
+        workers[i].numFiles = numFiles;
+        workers[i].jobs = jobs;
+        workers[i].results = results;
+        workers[i].numJobs = numJobs;
+        workers[i].next = &next;
+    }
+    runWorkers( workers, sizeof(VerifyWorker), numThreads, &_verify_worker );
+
+    error = _report( workers, wallTime( ) - start, numThreads );
+
+    /* clean up */
+    for ( i = 0; i < numThreads; i++ )
+    {
+        if ( workers[i].board != NULL )
+        {
+            deleteGameBoard( workers[i].board );
+        }
+    }
+    for ( i = 0; i < numFiles; i++ )
+    {
+        if ( logs[i] != NULL )
+        {
+            deleteParsedLog( logs[i] );
+        }
+    }
+    free( results );
+    free( jobs );
+    free( logs );
+    free( workers );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _verify_worker                                                   *
+ * Imports: pointer to a VerifyWorker struct                                  *
+ * Returns: NULL                                                              *
+ * Exports: the results of the games claimed by the worker                    *
+ * Purpose: the body of a thread while games are being verified. Claims       *
+ *          batches of games from the shared counter and replays each on the  *
+ *          worker's board, which is only made again when a game has other    *
+ *          settings than the last, as setting up a board costs far more than *
+ *          clearing it.                                                      *
+ ******************************************************************************/
+static void *_verify_worker( void *data )
+{
+    VerifyWorker *worker;
+    Settings *settings;
+    long first, last, i;
+
+    worker = (VerifyWorker*) data;
+    first = __sync_fetch_and_add( worker->next, VERIFY_BATCH );
+    while ( first < worker->numJobs )
+    {
+        last = first + VERIFY_BATCH;
+        if ( last > worker->numJobs )
+        {
+            last = worker->numJobs;
+        }
+
+        for ( i = first; i < last; i++ )
+        {
+            settings = &worker->jobs[i].game->settings;
+            if ( worker->board != NULL &&
+                 settings->width == worker->settings.width &&
+                 settings->height == worker->settings.height &&
+                 settings->matches == worker->settings.matches )
+            {
+                boardReset( worker->board );
+            }
+            else
+            {
+                if ( worker->board != NULL )
+                {
+                    deleteGameBoard( worker->board );
+                }
+                worker->settings = *settings;
+                worker->board = (GameBoard*) malloc( sizeof(GameBoard) );
+                boardInit( worker->board, &worker->settings );
+            }
+
+            verifyGame( worker->board, worker->jobs[i].log->turns,
+                worker->jobs[i].game, &worker->results[i] );
+        }
+
+        first = __sync_fetch_and_add( worker->next, VERIFY_BATCH );
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: _list_jobs                                                       *
+ * Imports: logs - the parsed logs, NULL for any that could not be opened     *
+ *          numFiles - the number of logs                                     *
+ * Returns: an array with a VerifyJob for every game of every log             *
+ * Exports: numJobs - the number of games                                     *
+ * Purpose: flattens the games of all logs into one list, so that the games   *
+ *          can be shared out evenly however they are spread over the logs    *
+ ******************************************************************************/
+static VerifyJob *_list_jobs( ParsedLog **logs, int numFiles, long *numJobs )
+{
+    VerifyJob *jobs;
+    long count;
+    int f, g;
+
+    count = 0;
+    for ( f = 0; f < numFiles; f++ )
+    {
+        count += logs[f] != NULL ? logs[f]->games->size : 0;
+    }
+
+    jobs = (VerifyJob*) malloc( ( count + 1 ) * sizeof(VerifyJob) );
+    count = 0;
+    for ( f = 0; f < numFiles; f++ )
+    {
+        for ( g = 0; logs[f] != NULL && g < logs[f]->games->size; g++ )
+        {
+            jobs[count].log = logs[f];
+            jobs[count].game = (ParsedGame*) arrayGet( logs[f]->games, g );
+            count++;
+        }
+    }
+    *numJobs = count;
+
+    return jobs;
+}
+
+
+
+/******************************************************************************
+ * Function: _report                                                          *
+ * Imports: workers - the workers, all finished, which share every result     *
+ *          seconds - the time taken to parse and verify the logs             *
+ *          numThreads - the number of threads used                           *
+ * Returns: TRUE if any log could not be read or holds a bad game             *
+ * Purpose: prints one line per problem, file by file and game by game, then  *
+ *          a summary. Empty files count as a problem, since a log is only    *
+ *          saved once there are games to save.                               *
+ ******************************************************************************/
+static BOOL _report( VerifyWorker *workers, double seconds, int numThreads )
+{
+    ParsedLog *log;
+    VerifyResult *result;
+    long counts[VerifyUnreadable + 1], turns, job, bad;
+    int f, g, badFiles;
+    char *name;
+
+    memset( counts, 0, sizeof(counts) );
+    turns = 0;
+    bad = 0;
+    badFiles = 0;
+    job = 0;
+    for ( f = 0; f < workers->numFiles; f++ )
+    {
+        log = workers->logs[f];
+        name = workers->fileNames[f];
+        if ( log == NULL )
+        {
+            printf( "%s: the file could not be opened\n", name );
+        }
+        else if ( log->bytes == 0 )
+        {
+            printf( "%s: the file is empty\n", name );
+        }
+
+        for ( g = 0; log != NULL && g < log->games->size; g++ )
+        {
+            result = &workers->results[job];
+            counts[result->status]++;
+            turns += workers->jobs[job].game->count;
+            if ( result->status >= VerifyUnfinished )
+            {
+                printf( "%s: game %d: ", name,
+                    workers->jobs[job].game->number );
+                printVerifyResult( stdout, result );
+                bad++;
+            }
+            job++;
+        }
+
+        if ( log != NULL && log->error != NULL && log->errorLine > 0 )
+        {
+            printf( "%s: line %ld: %s\n", name, log->errorLine, log->error );
+        }
+        else if ( log != NULL && log->error != NULL )
+        {
+            printf( "%s: %s\n", name, log->error );
+        }
+
+        if ( log == NULL || log->bytes == 0 || log->error != NULL )
+        {
+            badFiles++;
+        }
+    }
+
+    printf( "\nVerified %ld games in %d files in %.3f s (%.0f games/sec)\n\n",
+        job, workers->numFiles, seconds, seconds > 0.0 ? job / seconds : 0.0 );
+    printf( "  Won:        %10ld\n"
+            "  Drawn:      %10ld\n"
+            "  Unfinished: %10ld\n"
+            "  Illegal:    %10ld\n",
+            counts[VerifyWon], counts[VerifyDrawn], counts[VerifyUnfinished],
+            counts[VerifyIllegal] + counts[VerifyOutOfTurn] +
+            counts[VerifyAfterWin] );
+    printf( "  Bad files:  %10d\n"
+            "  Turns:      %10ld\n"
+            "  Threads:    %10d\n\n", badFiles, turns, numThreads );
+
+    return bad > 0 || badFiles > 0;
+}
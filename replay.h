@@ -0,0 +1,79 @@
+/******************************************************************************
+ * File:---- replay.h                                                         *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the outcome of playing a logged game again.              *
+ *           Declares the functions that read saved game logs back in, play   *
+ *           their games again on a board, look up single games and check     *
+ *           that every game was played by the rules.                         *
+ ******************************************************************************/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game.h"
+#include "logParser.h"
+
+
+/******************************************************************************
+ * VERIFY_BATCH: the number of games a verifier thread claims from the shared *
+ *               game counter at a time                                       *
+ ******************************************************************************/
+#define VERIFY_BATCH 64
+
+
+
+/******************************************************************************
+ * VerifyStatus: An enumeration of the ways a logged game can turn out.       *
+ *     VerifyWon - the last turn won the game                                 *
+ *     VerifyDrawn - the game ended with nobody able to win                   *
+ *     VerifyUnfinished - the log stops before the game was over, e.g. when   *
+ *                        the file was cut short                              *
+ *     VerifyIllegal - a tile was placed off the board or on a taken cell     *
+ *     VerifyOutOfTurn - a turn was played by the wrong player, or has the    *
+ *                       wrong turn number                                    *
+ *     VerifyAfterWin - the game carries on after a player has won            *
+ *     VerifyUnreadable - a line of the game is not a move at all. Only       *
+ *                        streams of moves read by --moves have such lines,   *
+ *                        logs that cannot be parsed are reported by the      *
+ *                        parser instead.                                     *
+ * Notes: the last four are problems with the log, the rest are not.          *
+ ******************************************************************************/
+typedef enum
+{
+    VerifyWon,
+    VerifyDrawn,
+    VerifyUnfinished,
+    VerifyIllegal,
+    VerifyOutOfTurn,
+    VerifyAfterWin,
+    VerifyUnreadable
+} VerifyStatus;
+
+
+
+/******************************************************************************
+ * VerifyResult: A struct that holds the outcome of replaying one game.       *
+ * Consists of:                                                               *
+ *     status - how the game turned out, a VerifyStatus                       *
+ *     turn - the turn the game was decided on, or the first bad turn         *
+ *     winner - the player who won, TicTacNone if nobody did                  *
+ ******************************************************************************/
+typedef struct
+{
+    VerifyStatus status;
+    int turn;
+    TicTacTile winner;
+} VerifyResult;
+
+
+
+/* Function Prototypes */
+BOOL replayLog( char* );
+BOOL lookupGame( char*, long );
+BOOL verifyLogs( char**, int, int );
+void verifyGame( GameBoard*, ChunkedArray*, ParsedGame*, VerifyResult* );
+void printVerifyResult( FILE*, VerifyResult* );
+
+#endif
@@ -0,0 +1,268 @@
+/******************************************************************************
+ * File:---- rollingLog.c                                                     *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the rolling log declared in rollingLog.h. Games are   *
+ *           written straight after the ones before them, so saving a         *
+ *           session again only costs as much as the games played since.      *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "rollingLog.h"
+#include "logIndex.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Start and finish the files the log rolls over                              *
+ ******************************************************************************/
+static void _open_file( RollingLog* );
+static void _close_file( RollingLog* );
+
+
+/******************************************************************************
+ * Function: createRollingLog                                                 *
+ * Imports: settings - the settings of the session                            *
+ *          format - the format to write the games in                         *
+ *          maxBytes - the size a file may reach before the log is rotated,   *
+ *                     0 to never rotate                                      *
+ * Returns: pointer to a new rolling log                                      *
+ * Purpose: sets up a rolling log. No file is created until the first game    *
+ *          is written, so a session that saves nothing leaves no empty log.  *
+ ******************************************************************************/
+RollingLog *createRollingLog( Settings *settings, LogFormat format,
+    long maxBytes )
+{
+    RollingLog *log;
+
+    log = (RollingLog*) malloc( sizeof(RollingLog) );
+    memset( log, 0, sizeof(RollingLog) );
+    log->format = format;
+    log->settings = *settings;
+    log->maxBytes = maxBytes;
+
+    return log;
+}
+
+
+
+/******************************************************************************
+ * Function: rollingLogGame                                                   *
+ * Imports: log - the rolling log                                             *
+ *          gameLog - the game to write                                       *
+ * Returns: TRUE if writing to the file has failed, FALSE otherwise           *
+ * Purpose: appends a game to the current file, in the same layout saveLog    *
+ *          uses, and its record to the file's index. If the file has reached *
+ *          its size limit it is closed first and the game starts a new one.  *
+ *          Games are numbered from 1 in each file, so that the banner of a   *
+ *          game matches its place in the index.                              *
+ ******************************************************************************/
+BOOL rollingLogGame( RollingLog *log, GameLog *gameLog )
+{
+    IndexEntry entry;
+
+    if ( log->file != NULL && log->maxBytes > 0 &&
+         log->bytes >= log->maxBytes )
+    {
+        _close_file( log );
+    }
+    if ( log->file == NULL )
+    {
+        _open_file( log );
+    }
+
+    if ( log->file != NULL )
+    {
+        entry.offset = log->bytes;
+        if ( log->writer != NULL )
+        {
+            log->error = writeGameLog( log->writer, gameLog ) || log->error;
+            log->bytes = log->writer->bytes;
+        }
+        else
+        {
+            printGame( log->file, gameLog, log->fileGames );
+            log->bytes = ftell( log->file );
+            log->error = ferror( log->file ) || log->error;
+        }
+        log->games++;
+        log->fileGames++;
+
+        if ( log->index != NULL )
+        {
+            #ifdef Editor
+            entry.settings = gameLog->settings;
+            #else
+            entry.settings = log->settings;
+            #endif
+            entry.turns = gameLog->turnList->size;
+            entry.winner = gameLog->winner;
+            log->error = writeIndexEntry( log->index, &entry ) ||
+                log->error;
+        }
+    }
+
+    return log->error;
+}
+
+
+
+/******************************************************************************
+ * Function: appendGameLogs                                                   *
+ * Imports: log - the rolling log                                             *
+ *          gameLogs - the session's array of game logs                       *
+ * Returns: TRUE if writing to the file has failed, FALSE otherwise           *
+ * Purpose: writes the games of the session that have not been saved yet and  *
+ *          syncs them to the disk. The array only ever grows, so the games   *
+ *          already saved are skipped over by index rather than written again.*
+ ******************************************************************************/
+BOOL appendGameLogs( RollingLog *log, ChunkedArray *gameLogs )
+{
+    while ( log->saved < gameLogs->size )
+    {
+        rollingLogGame( log, (GameLog*) arrayGet( gameLogs, log->saved ) );
+        log->saved++;
+    }
+
+    return flushRollingLog( log, TRUE );
+}
+
+
+
+/******************************************************************************
+ * Function: flushRollingLog                                                  *
+ * Imports: log - the rolling log                                             *
+ *          sync - TRUE to also wait until the file is on the disk            *
+ * Returns: TRUE if writing to the file has failed, FALSE otherwise           *
+ * Purpose: writes out everything buffered for the current file and its       *
+ *          index, so that every game so far can be read back from them       *
+ ******************************************************************************/
+BOOL flushRollingLog( RollingLog *log, BOOL sync )
+{
+    if ( log->file != NULL )
+    {
+        if ( log->writer != NULL && flushLogWriter( log->writer ) )
+        {
+            log->error = TRUE;
+        }
+        if ( fflush( log->file ) != 0 ||
+             ( sync && fsync( fileno( log->file ) ) != 0 ) )
+        {
+            log->error = TRUE;
+        }
+        if ( log->index != NULL && fflush( log->index ) != 0 )
+        {
+            log->error = TRUE;
+        }
+    }
+
+    return log->error;
+}
+
+
+
+/******************************************************************************
+ * Function: closeRollingLog                                                  *
+ * Imports: pointer to a rolling log                                          *
+ * Returns: TRUE if writing to any of the files failed, FALSE otherwise       *
+ * Purpose: syncs and closes the current file and frees the log               *
+ ******************************************************************************/
+BOOL closeRollingLog( RollingLog *log )
+{
+    BOOL error;
+
+    if ( log->file != NULL )
+    {
+        _close_file( log );
+    }
+    error = log->error;
+    free( log );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _open_file                                                       *
+ * Imports: pointer to a rolling log                                          *
+ * Exports: none                                                              *
+ * Purpose: creates the next file of the log, with a name of its own even     *
+ *          within the same minute, and its index, and writes its header: the *
+ *          binary header or the session's settings for a text log            *
+ ******************************************************************************/
+static void _open_file( RollingLog *log )
+{
+    log->file = createLogFile( &log->settings, log->fileName, log->format );
+    log->bytes = 0;
+    log->fileGames = 0;
+
+    if ( log->file == NULL )
+    {
+        log->error = TRUE;
+    }
+    else
+    {
+        setvbuf( log->file, NULL, _IOFBF, LOG_BUFFER );
+        log->files++;
+        if ( log->format == LogBinary )
+        {
+            log->writer = createLogWriter( log->file, &log->settings );
+            log->bytes = log->writer->bytes;
+        }
+        #ifndef Editor
+        else
+        {
+            fprintf( log->file, "SETTINGS:\n"
+                                "  M: %d\n"
+                                "  N: %d\n"
+                                "  K: %d\n\n",
+                                log->settings.width, log->settings.height,
+                                log->settings.matches );
+            log->bytes = ftell( log->file );
+        }
+        #endif
+
+        /* the log can still be read without its index, by scanning it */
+        log->index = createIndexFile( log->fileName );
+        if ( log->index != NULL )
+        {
+            setvbuf( log->index, NULL, _IOFBF, LOG_BUFFER );
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _close_file                                                      *
+ * Imports: pointer to a rolling log                                          *
+ * Exports: none                                                              *
+ * Purpose: syncs the current file to the disk and closes it. The file name   *
+ *          is kept so that the last file can still be reported.              *
+ ******************************************************************************/
+static void _close_file( RollingLog *log )
+{
+    flushRollingLog( log, TRUE );
+    if ( log->writer != NULL )
+    {
+        deleteLogWriter( log->writer );
+        log->writer = NULL;
+    }
+    if ( fclose( log->file ) != 0 )
+    {
+        log->error = TRUE;
+    }
+    if ( log->index != NULL && fclose( log->index ) != 0 )
+    {
+        log->error = TRUE;
+    }
+    log->file = NULL;
+    log->index = NULL;
+}
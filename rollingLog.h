@@ -0,0 +1,82 @@
+/******************************************************************************
+ * File:---- rollingLog.h                                                     *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a rolling log: a log file that games are appended to one *
+ *           at a time for as long as the session lasts, and that is rotated  *
+ *           to a new file once it grows past a size limit.                   *
+ *           Every file gets an index next to it, see logIndex.h.             *
+ *           Declares functions to append games, flush them to the disk and   *
+ *           close the log.                                                   *
+ ******************************************************************************/
+
+#ifndef ROLLINGLOG_H
+#define ROLLINGLOG_H
+
+#include <stdio.h>
+#include "game.h"
+#include "binaryLog.h"
+#include "fileIO.h"
+
+
+/******************************************************************************
+ * LOG_ROTATE_MB: the size a rolling log grows to before it is rotated unless *
+ *                --log-size is given, in megabytes                           *
+ * LOG_BUFFER: the size of each file's buffer, so that games reach the disk   *
+ *             in large writes rather than one write per game                 *
+ ******************************************************************************/
+#define LOG_ROTATE_MB 64
+#define LOG_BUFFER ( 1 << 20 )
+
+
+
+/******************************************************************************
+ * RollingLog: A struct that holds the state of a rolling log.                *
+ * Consists of:                                                               *
+ *     file - the file games are being appended to, NULL until the first game *
+ *            and again after the log has been rotated                        *
+ *     index - the index of the current file, NULL if it could not be created *
+ *     fileName - the name of the current (or last) file                      *
+ *     format - the format the games are written in                           *
+ *     settings - the settings of the session, for each file's header         *
+ *     writer - the binary writer of the current file, NULL for text          *
+ *     maxBytes - the size a file may reach before the next game goes to a    *
+ *                new one, 0 to never rotate                                  *
+ *     bytes - the size of the current file                                   *
+ *     games - the number of games written, over all files                    *
+ *     fileGames - the number of games written to the current file            *
+ *     saved - the number of games of the session's log array written so far, *
+ *             so that saving again only writes the games after them          *
+ *     files - the number of files written                                    *
+ *     error - TRUE once a write to any of the files has failed               *
+ * Notes: files are only rotated between games, so every file can be read     *
+ *        back on its own.                                                    *
+ ******************************************************************************/
+typedef struct
+{
+    FILE *file;
+    FILE *index;
+    char fileName[LOG_NAME_LEN];
+    LogFormat format;
+    Settings settings;
+    LogWriter *writer;
+    long maxBytes;
+    long bytes;
+    long games;
+    long fileGames;
+    int saved;
+    int files;
+    BOOL error;
+} RollingLog;
+
+
+
+/* Function Prototypes */
+RollingLog *createRollingLog( Settings*, LogFormat, long );
+BOOL rollingLogGame( RollingLog*, GameLog* );
+BOOL appendGameLogs( RollingLog*, ChunkedArray* );
+BOOL flushRollingLog( RollingLog*, BOOL );
+BOOL closeRollingLog( RollingLog* );
+
+#endif
@@ -0,0 +1,318 @@
+/******************************************************************************
+ * File:---- simulate.c                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the headless simulation mode, which plays a batch of  *
+ *           games between two move sources without drawing anything and      *
+ *           reports how fast the games were played and how they ended.       *
+ *           Games are shared out between a number of worker threads.         *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "simulate.h"
+#include "player.h"
+#include "asyncLog.h"
+#include "timer.h"
+#include "workerPool.h"
+
+
+/******************************************************************************
+ * SimWorker: A struct that holds everything a single worker thread needs.    *
+ * Consists of:                                                               *
+ *     settings - the shared (read-only) game settings                        *
+ *     names - the shared (read-only) names of the move sources               *
+ *     options - the shared (read-only) options of the move sources           *
+ *     numGames - the total number of games to play                           *
+ *     nextGame - the shared counter of games that have been claimed          *
+ *     seed - the seed of this worker's move sources                          *
+ *     autoSave - the shared background writer every game is queued for, NULL *
+ *                when the games are not saved                                *
+ *     stats - this worker's own results, merged once all threads are done    *
+ *     padding - keeps the stats of neighbouring workers out of each other's  *
+ *               cache lines                                                  *
+ * Notes: every worker owns its board, move sources and results, so the only  *
+ *        shared values that are written to are nextGame, which is updated    *
+ *        with an atomic add, and the writer's queue, which is lock-free. No  *
+ *        locks are taken while games are played.                             *
+ ******************************************************************************/
+typedef struct
+{
+    Settings *settings;
+    char **names;
+    PlayerOptions *options;
+    long numGames;
+    long *nextGame;
+    unsigned long seed;
+    AsyncLog *autoSave;
+    SimStats stats;
+    char padding[64];
+} SimWorker;
+
+
+static void *_sim_worker( void* );
+
+
+/******************************************************************************
+ * Function: simulateGames                                                    *
+ * Imports: pointer to the game settings                                      *
+ *          names of the move sources of both players, indexed by TicTacTile  *
+ *          options of the move sources                                       *
+ *          number of games to play                                           *
+ *          number of worker threads to use                                   *
+ *          how the games are saved                                           *
+ * Returns: TRUE if the games could not all be saved, FALSE otherwise         *
+ * Purpose: starts the worker threads, waits for all games to be played,      *
+ *          then adds up the results of every worker and prints a summary.    *
+ *          The first worker runs on the calling thread.                      *
+ *          When games are saved in the background, the writer thread is      *
+ *          started first and stopped once every game has been queued, and    *
+ *          the time it takes to finish writing is not counted.               *
+ ******************************************************************************/
+BOOL simulateGames( Settings *settings, char **names, PlayerOptions *options,
+    long numGames, int numThreads, LogOptions *logOptions )
+{
+    AsyncLog *autoSave;
+    SimWorker *workers;
+    SimStats stats;
+    long nextGame;
+    double start;
+    int i, p;
+    BOOL error;
+
+    workers = (SimWorker*) malloc( numThreads * sizeof(SimWorker) );
+    nextGame = 0;
+
+    /* the games are malloced by the workers, and freed by the writer */
+    autoSave = NULL;
+    #ifndef Secret
+    if ( logOptions->background )
+    {
+        autoSave = createAsyncLog( settings, logOptions, &deleteGameLog );
+    }
+    #endif
+
+    for ( i = 0; i < numThreads; i++ )
+    {
+        workers[i].settings = settings;
+        workers[i].names = names;
+        workers[i].options = options;
+        workers[i].numGames = numGames;
+        workers[i].nextGame = &nextGame;
+        workers[i].seed = (unsigned long) i * TicTacTotal;
+        workers[i].autoSave = autoSave;
+    }
+
+    start = wallTime( );
+    runWorkers( workers, sizeof(SimWorker), numThreads, &_sim_worker );
+
+    /* merge the results of every worker */
+    memset( &stats, 0, sizeof(SimStats) );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        stats.games += workers[i].stats.games;
+        stats.moves += workers[i].stats.moves;
+        for ( p = TicTacNone; p < TicTacTotal; p++ )
+        {
+            stats.results[p] += workers[i].stats.results[p];
+        }
+    }
+
+    printSimStats( settings, &stats, wallTime( ) - start );
+    printf( "  Threads: %d\n\n", numThreads );
+
+    error = FALSE;
+    if ( autoSave != NULL )
+    {
+        error = closeAsyncLog( autoSave );
+    }
+
+    /* clean up */
+    free( workers );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _sim_worker                                                      *
+ * Imports: pointer to a SimWorker struct                                     *
+ * Returns: NULL                                                              *
+ * Exports: the results of the worker's games in its stats                    *
+ * Purpose: the body of a worker thread. Claims batches of games from the     *
+ *          shared counter and plays them on a single reused board until all  *
+ *          games have been claimed. Each game is queued for the background   *
+ *          writer as soon as it is over, if there is one.                    *
+ ******************************************************************************/
+static void *_sim_worker( void *data )
+{
+    SimWorker *worker;
+    GameBoard *board;
+    MoveSource *players[TicTacTotal];
+    PlayerOptions options;
+    GameLog *gameLog;
+    TicTacTile winner;
+    long first, last, i;
+    int p, moves;
+
+    worker = (SimWorker*) data;
+    memset( &worker->stats, 0, sizeof(SimStats) );
+
+    board = (GameBoard*) malloc( sizeof(GameBoard) );
+    boardInit( board, worker->settings );
+
+    players[TicTacNone] = NULL;
+    for ( p = TicTacX; p < TicTacTotal; p++ )
+    {
+        /* the games already keep every processor busy */
+        options = *worker->options;
+        options.seed = worker->seed + p;
+        options.threads = 1;
+        players[p] = createMoveSource( worker->names[p], &options );
+    }
+
+    first = __sync_fetch_and_add( worker->nextGame, SIM_BATCH );
+    while ( first < worker->numGames )
+    {
+        last = first + SIM_BATCH;
+        if ( last > worker->numGames )
+        {
+            last = worker->numGames;
+        }
+
+        for ( i = first; i < last; i++ )
+        {
+            gameLog = NULL;
+            if ( worker->autoSave != NULL )
+            {
+                gameLog = (GameLog*) malloc( sizeof(GameLog) );
+                gameLog->turnList = createArray( sizeof(TurnLog), NULL );
+                #ifdef Editor
+                gameLog->settings = *worker->settings;
+                #endif
+            }
+
+            boardReset( board );
+            winner = playHeadless( board, players, &moves,
+                gameLog != NULL ? gameLog->turnList : NULL );
+            worker->stats.results[winner]++;
+            worker->stats.moves += moves;
+            worker->stats.games++;
+
+            if ( gameLog != NULL )
+            {
+                gameLog->winner = winner;
+                asyncLogGame( worker->autoSave, gameLog );
+            }
+        }
+
+        first = __sync_fetch_and_add( worker->nextGame, SIM_BATCH );
+    }
+
+    /* clean up */
+    for ( p = TicTacX; p < TicTacTotal; p++ )
+    {
+        deleteMoveSource( players[p] );
+    }
+    deleteGameBoard( board );
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: playHeadless                                                     *
+ * Imports: pointer to an empty game board                                    *
+ *          array of move sources, indexed by TicTacTile                      *
+ *          array to log the turns of the game to, NULL to not log them       *
+ * Returns: the winning player, or TicTacNone if the game was a draw          *
+ * Exports: numMoves - the number of moves made in the game                   *
+ * Purpose: plays a single game to the end without any terminal output.       *
+ *          The game logic is the same as in playGame.                        *
+ ******************************************************************************/
+TicTacTile playHeadless( GameBoard *board, MoveSource **players,
+    int *numMoves, ChunkedArray *turns )
+{
+    TicTacTile currentPlayer, winner;
+    Coordinates move;
+    TurnLog turn;
+    BOOL finished;
+
+    currentPlayer = TicTacX;
+    winner = TicTacNone;
+    finished = FALSE;
+    *numMoves = 0;
+
+    while ( !finished )
+    {
+        move = players[currentPlayer]->getMove( board, currentPlayer,
+            players[currentPlayer]->state );
+
+        if ( placeTile( board, currentPlayer, move.x, move.y ) )
+        {
+            ( *numMoves )++;
+            if ( turns != NULL )
+            {
+                turn.turnNum = *numMoves;
+                turn.player = currentPlayer;
+                turn.location = move;
+                arrayAppend( turns, &turn );
+            }
+
+            if ( checkWin( board, currentPlayer, move.x, move.y ) )
+            {
+                finished = TRUE;
+                winner = currentPlayer;
+            }
+            else if ( checkDraw( board ) )
+            {
+                finished = TRUE;
+            }
+            changePlayer( &currentPlayer );
+        }
+    }
+
+    return winner;
+}
+
+
+
+/******************************************************************************
+ * Function: printSimStats                                                    *
+ * Imports: pointer to the game settings                                      *
+ *          pointer to the simulation results                                 *
+ *          time taken to play the games, in seconds                          *
+ * Exports: none                                                              *
+ * Purpose: prints the throughput, the split of results and the average game  *
+ *          length of a batch of simulated games.                             *
+ ******************************************************************************/
+void printSimStats( Settings *settings, SimStats *stats, double seconds )
+{
+    int p;
+    double games;
+
+    games = stats->games > 0 ? (double) stats->games : 1.0;
+
+    printf( "\nSimulated %ld games of %dx%d, K=%d in %.3f s "
+            "(%.0f games/sec)\n\n",
+            stats->games, settings->width, settings->height,
+            settings->matches, seconds,
+            seconds > 0.0 ? stats->games / seconds : 0.0 );
+
+    for ( p = TicTacX; p < TicTacTotal; p++ )
+    {
+        printf( "  Player %d wins: %10ld (%5.1f%%)\n", p,
+            stats->results[p], 100.0 * stats->results[p] / games );
+    }
+    printf( "  Draws:         %10ld (%5.1f%%)\n",
+        stats->results[TicTacNone],
+        100.0 * stats->results[TicTacNone] / games );
+    printf( "  Average game length: %.2f moves\n\n", stats->moves / games );
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * File:---- simulate.h                                                       *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the statistics gathered while simulating games.          *
+ *           Declares functions that play games without the terminal user     *
+ *           interface, for measuring engine throughput and for trying out    *
+ *           rule variants in bulk.                                           *
+ ******************************************************************************/
+
+#ifndef SIMULATE_H
+#define SIMULATE_H
+
+#include "game.h"
+#include "player.h"
+
+
+/******************************************************************************
+ * SimStats: A struct that holds the results of a batch of simulated games.   *
+ * Consists of:                                                               *
+ *     games - the number of games played                                     *
+ *     results - the number of games won by each player, indexed by           *
+ *               TicTacTile. results[TicTacNone] counts the draws             *
+ *     moves - the total number of moves made over all games                  *
+ ******************************************************************************/
+typedef struct
+{
+    long games;
+    long results[TicTacTotal];
+    long moves;
+} SimStats;
+
+
+
+/******************************************************************************
+ * SIM_BATCH: the number of games a worker thread claims from the shared      *
+ *            game counter at a time. Claiming games in batches keeps the     *
+ *            threads from fighting over the counter's cache line.            *
+ ******************************************************************************/
+#define SIM_BATCH 64
+
+
+
+/* Function Prototypes */
+BOOL simulateGames( Settings*, char**, PlayerOptions*, long, int,
+    LogOptions* );
+TicTacTile playHeadless( GameBoard*, MoveSource**, int*, ChunkedArray* );
+void printSimStats( Settings*, SimStats*, double );
+
+#endif
@@ -0,0 +1,801 @@
+/******************************************************************************
+ * File:---- solve.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the --solve mode, a depth-first proof-number search   *
+ *           (df-pn) that proves the value of an M,N,K game. The search keeps *
+ *           everything it knows in a table of proof and disproof numbers,    *
+ *           which can be saved to a checkpoint file and loaded again to      *
+ *           carry on with a long solve.                                      *
+ * References: Nagai A. (2002). Df-pn algorithm for searching AND/OR trees    *
+ *             and its applications. PhD thesis, University of Tokyo          *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "solve.h"
+#include "interface.h"
+#include "timer.h"
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * The parts of the proof-number search, only used by solveGame               *
+ ******************************************************************************/
+static void _mid( Solver*, GameBoard*, TicTacTile, unsigned long,
+    unsigned long, int, unsigned long*, unsigned long* );
+static int  _expand( Solver*, GameBoard*, TicTacTile, int, unsigned long*,
+    unsigned long* );
+static BOOL _live_cell( GameBoard*, int, int );
+static void _gather( Solver*, GameBoard*, TicTacTile, int, int,
+    unsigned long*, unsigned long*, int*, unsigned long* );
+static long _table_bytes( Settings* );
+static unsigned long _position_key( Solver*, GameBoard*, TicTacTile, int );
+static ProofEntry *_lookup( Solver*, unsigned long );
+static void _store( Solver*, unsigned long, unsigned long, unsigned long,
+    unsigned long );
+static void _print_pv( Solver*, GameBoard*, TicTacTile );
+static BOOL _save_checkpoint( Solver*, GameBoard* );
+static BOOL _load_checkpoint( Solver*, GameBoard* );
+
+
+/******************************************************************************
+ * Function: solveGame                                                        *
+ * Imports: pointer to the game settings                                      *
+ *          name of the checkpoint file, NULL to solve without one            *
+ * Returns: TRUE if the checkpoint could not be used, FALSE otherwise         *
+ * Purpose: first proves or disproves that the first player can force a win.  *
+ *          If it cannot, the same is done for the second player, and if      *
+ *          neither can the game is a draw. Prints the result, a principal    *
+ *          variation and the number of nodes searched.                       *
+ *          If the checkpoint file exists the solve carries on from it, and   *
+ *          it is written every SOLVE_SAVE_SECONDS and once each side has     *
+ *          been solved.                                                      *
+ ******************************************************************************/
+BOOL solveGame( Settings *settings, char *checkpoint )
+{
+    Solver solver;
+    GameBoard *board;
+    TicTacTile winner;
+    unsigned long buckets, proof, disproof;
+    double start, seconds;
+    long resumed;
+    BOOL error, finished;
+
+    buckets = 1;
+    while ( buckets * 2 * SOLVE_WAYS * sizeof(ProofEntry) <=
+        (unsigned long) _table_bytes( settings ) )
+    {
+        buckets *= 2;
+    }
+
+    /* settle for a smaller table if the memory is not there */
+    solver.entries = (ProofEntry*) calloc(
+        buckets * SOLVE_WAYS, sizeof(ProofEntry) );
+    while ( solver.entries == NULL && buckets > 1 )
+    {
+        buckets /= 2;
+        solver.entries = (ProofEntry*) calloc(
+            buckets * SOLVE_WAYS, sizeof(ProofEntry) );
+    }
+    solver.mask = buckets - 1;
+    solver.attacker = TicTacX;
+    solver.nodes = 0;
+    solver.capacity = 0;
+    solver.moves = NULL;
+    solver.checkpoint = checkpoint;
+
+    board = (GameBoard*) malloc( sizeof(GameBoard) );
+    boardInit( board, settings );
+
+    printf( "\nSolving %dx%d, K=%d with a %.0f MB proof table\n",
+        settings->width, settings->height, settings->matches,
+        buckets * SOLVE_WAYS * sizeof(ProofEntry) / 1048576.0 );
+
+    error = FALSE;
+    if ( checkpoint != NULL )
+    {
+        error = _load_checkpoint( &solver, board );
+    }
+
+    winner = TicTacNone;
+    finished = error;
+    resumed = solver.nodes;
+    start = wallTime( );
+    solver.lastSave = start;
+    while ( !finished )
+    {
+        _mid( &solver, board, TicTacX, PN_INF, PN_INF, 0, &proof, &disproof );
+        printf( "  Player %d %s force a win (%ld nodes so far)\n",
+            (int) solver.attacker, proof == 0 ? "can" : "cannot",
+            solver.nodes );
+
+        if ( proof == 0 )
+        {
+            winner = solver.attacker;
+            finished = TRUE;
+        }
+        else if ( solver.attacker == TicTacX )
+        {
+            solver.attacker = TicTacO;
+        }
+        else
+        {
+            finished = TRUE;
+        }
+
+        if ( checkpoint != NULL )
+        {
+            _save_checkpoint( &solver, board );
+        }
+    }
+
+    if ( !error )
+    {
+        seconds = wallTime( ) - start;
+        if ( winner == TicTacNone )
+        {
+            printf( "\nResult: draw\n" );
+        }
+        else
+        {
+            printf( "\nResult: player %d wins\n", (int) winner );
+        }
+
+        _print_pv( &solver, board, winner );
+        printf( "Nodes: %ld, %ld of them in %.3f s (%.0f nodes/sec)\n\n",
+            solver.nodes, solver.nodes - resumed, seconds,
+            seconds > 0.0 ? ( solver.nodes - resumed ) / seconds : 0.0 );
+    }
+
+    /* clean up */
+    deleteGameBoard( board );
+    free( solver.entries );
+    free( solver.moves );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _mid                                                             *
+ * Imports: the solver, pointer to the game board, player to move,            *
+ *          proof and disproof thresholds, top of the move stack              *
+ * Exports: proof, disproof - the numbers of the position when it returns     *
+ * Purpose: the df-pn search. Keeps searching the most-proving child of the   *
+ *          position until its proof or disproof number reaches a threshold,  *
+ *          which means a sibling or an ancestor has become more promising.   *
+ *          The attacker's positions take the smallest proof number of their  *
+ *          children and the sum of their disproof numbers; the defender's    *
+ *          positions the other way round. Children get their thresholds      *
+ *          from the second-best child, raised by a quarter so that the       *
+ *          search does not keep switching between two close children.        *
+ ******************************************************************************/
+static void _mid( Solver *solver, GameBoard *board, TicTacTile player,
+    unsigned long thProof, unsigned long thDisproof, int top,
+    unsigned long *proof, unsigned long *disproof )
+{
+    TicTacTile opponent;
+    ProofEntry *entry;
+    unsigned long second, childProof, childDisproof, work;
+    unsigned long childThProof, childThDisproof;
+    int count, best, cell;
+    BOOL attacking, searching;
+
+    solver->nodes++;
+    if ( solver->checkpoint != NULL && ( solver->nodes & 0xFFFF ) == 0 &&
+         wallTime( ) - solver->lastSave > SOLVE_SAVE_SECONDS )
+    {
+        if ( !_save_checkpoint( solver, board ) )
+        {
+            printf( "  %ld nodes, checkpoint written\n", solver->nodes );
+        }
+    }
+
+    work = solver->nodes;
+    opponent = player;
+    changePlayer( &opponent );
+    attacking = player == solver->attacker;
+
+    count = _expand( solver, board, player, top, proof, disproof );
+    searching = count > 0;
+    while ( searching )
+    {
+        _gather( solver, board, player, top, count, proof, disproof, &best,
+            &second );
+
+        searching = *proof < thProof && *disproof < thDisproof;
+        if ( searching )
+        {
+            cell = solver->moves[top + best];
+            entry = _lookup( solver,
+                _position_key( solver, board, player, cell ) );
+            childProof = entry != NULL ? entry->proof : 1;
+            childDisproof = entry != NULL ? entry->disproof : 1;
+
+            second += second / 4 + 1;
+            if ( attacking )
+            {
+                childThProof = second < thProof ? second : thProof;
+                childThDisproof = thDisproof - *disproof + childDisproof;
+            }
+            else
+            {
+                childThProof = thProof - *proof + childProof;
+                childThDisproof = second < thDisproof ? second : thDisproof;
+            }
+
+            placeTile( board, player, cell % board->settings->width,
+                cell / board->settings->width );
+            _mid( solver, board, opponent, childThProof, childThDisproof,
+                top + count, &childProof, &childDisproof );
+            removeTile( board, cell % board->settings->width,
+                cell / board->settings->width );
+        }
+    }
+
+    _store( solver, _position_key( solver, board, player, -1 ), *proof,
+        *disproof, (unsigned long) ( solver->nodes - work ) );
+}
+
+
+
+/******************************************************************************
+ * Function: _expand                                                          *
+ * Imports: the solver, pointer to the game board, player to move,            *
+ *          top of the move stack                                             *
+ * Returns: the number of moves to search, 0 if the position is settled       *
+ * Exports: proof, disproof - the numbers of a settled position               *
+ *          the moves to search, pushed onto the move stack at top            *
+ * Purpose: settles the position if the attacker can no longer complete a     *
+ *          window, or if one side is sure to win on its next move. Otherwise *
+ *          lists the moves that have to be searched: the only cell that      *
+ *          stops the opponent's threat if there is one, every live cell if   *
+ *          there is not.                                                     *
+ ******************************************************************************/
+static int _expand( Solver *solver, GameBoard *board, TicTacTile player,
+    int top, unsigned long *proof, unsigned long *disproof )
+{
+    TicTacTile opponent, winner;
+    int area, count, threats, cell;
+
+    area = board->settings->width * board->settings->height;
+    if ( solver->capacity < top + area + 2 )
+    {
+        solver->capacity = 2 * ( top + area + 2 );
+        solver->moves = (int*) realloc( solver->moves,
+            solver->capacity * sizeof(int) );
+    }
+
+    opponent = player;
+    changePlayer( &opponent );
+    winner = TicTacNone;
+    count = 0;
+
+    if ( board->openLines[solver->attacker] == 0 || board->emptyCount == 0 )
+    {
+        winner = TicTacTotal;
+    }
+    else if ( winningCells( board, player, solver->moves + top, 1 ) > 0 )
+    {
+        winner = player;
+    }
+    else
+    {
+        /* two threats cannot both be blocked */
+        threats = winningCells( board, opponent, solver->moves + top, 2 );
+        if ( threats == 2 )
+        {
+            winner = opponent;
+        }
+        else if ( threats == 1 )
+        {
+            count = 1;
+        }
+        else
+        {
+            for ( cell = 0; cell < area; cell++ )
+            {
+                if ( _live_cell( board, cell % board->settings->width,
+                    cell / board->settings->width ) )
+                {
+                    solver->moves[top + count] = cell;
+                    count++;
+                }
+            }
+        }
+    }
+
+    /* TicTacTotal stands for a game nobody can win any more */
+    if ( winner == solver->attacker )
+    {
+        *proof = 0;
+        *disproof = PN_INF;
+    }
+    else if ( winner != TicTacNone )
+    {
+        *proof = PN_INF;
+        *disproof = 0;
+    }
+
+    return count;
+}
+
+
+
+/******************************************************************************
+ * Function: _live_cell                                                       *
+ * Imports: pointer to the game board, x and y coordinates of a cell          *
+ * Returns: TRUE if the cell is empty and lies in a window that one of the    *
+ *          players could still complete, FALSE otherwise                     *
+ * Purpose: a tile on a dead cell cannot help or hinder anyone, so playing    *
+ *          there is the same as passing, and an extra tile never hurts the   *
+ *          side that places it. Dead cells never have to be searched.        *
+ ******************************************************************************/
+static BOOL _live_cell( GameBoard *board, int x, int y )
+{
+    unsigned char *windows[NUM_DIRECTIONS * DENSE_DIMENSION];
+    int count, i;
+    BOOL live;
+
+    live = FALSE;
+    if ( getTile( board, x, y ) == TicTacNone )
+    {
+        count = cellWindows( board, x, y, windows );
+        for ( i = 0; i < count && !live; i++ )
+        {
+            live = windows[i][TicTacX - 1] == 0 ||
+                windows[i][TicTacO - 1] == 0;
+        }
+    }
+
+    return live;
+}
+
+
+
+/******************************************************************************
+ * Function: _gather                                                          *
+ * Imports: the solver, pointer to the game board, player to move,            *
+ *          start and length of the position's moves on the move stack        *
+ * Exports: proof, disproof - the numbers of the position                     *
+ *          best - index of the child to search next                          *
+ *          second - the proof (attacker) or disproof (defender) number of    *
+ *                   the second-best child                                    *
+ * Purpose: works out the position's numbers from its children in the table.  *
+ *          Children that are not in the table count as 1 and 1. Sums stop    *
+ *          just short of PN_INF, which only a settled child can reach.       *
+ ******************************************************************************/
+static void _gather( Solver *solver, GameBoard *board, TicTacTile player,
+    int top, int count, unsigned long *proof, unsigned long *disproof,
+    int *best, unsigned long *second )
+{
+    ProofEntry *entry;
+    unsigned long minimum, sum, value, other;
+    int i;
+    BOOL attacking, settled;
+
+    attacking = player == solver->attacker;
+    minimum = PN_INF;
+    *second = PN_INF;
+    sum = 0;
+    settled = FALSE;
+    *best = 0;
+
+    for ( i = 0; i < count; i++ )
+    {
+        entry = _lookup( solver,
+            _position_key( solver, board, player, solver->moves[top + i] ) );
+
+        /* the attacker minimises proof numbers, the defender disproof */
+        value = 1;
+        other = 1;
+        if ( entry != NULL )
+        {
+            value = attacking ? entry->proof : entry->disproof;
+            other = attacking ? entry->disproof : entry->proof;
+        }
+
+        if ( value < minimum )
+        {
+            *second = minimum;
+            minimum = value;
+            *best = i;
+        }
+        else if ( value < *second )
+        {
+            *second = value;
+        }
+
+        if ( other >= PN_INF )
+        {
+            settled = TRUE;
+        }
+        sum += other;
+        if ( sum >= PN_INF )
+        {
+            sum = PN_INF - 1;
+        }
+    }
+
+    if ( settled )
+    {
+        sum = PN_INF;
+    }
+
+    *proof = attacking ? minimum : sum;
+    *disproof = attacking ? sum : minimum;
+}
+
+
+
+/******************************************************************************
+ * Function: _table_bytes                                                     *
+ * Imports: pointer to the game settings                                      *
+ * Returns: the largest size the proof table may take up, in bytes            *
+ * Purpose: the T setting sizes the table if the settings file gives it.      *
+ *          Otherwise the solver takes SOLVE_TABLE_SIZE, far more than the    *
+ *          ai player's default, as boards of 5x5 and up thrash a smaller     *
+ *          table. It is capped at half of the machine's memory.              *
+ ******************************************************************************/
+static long _table_bytes( Settings *settings )
+{
+    long bytes, pages, pageSize;
+
+    if ( settings->tableSet )
+    {
+        bytes = (long) settings->tableSize << 20;
+    }
+    else
+    {
+        bytes = (long) SOLVE_TABLE_SIZE << 20;
+#ifdef _SC_PHYS_PAGES
+        pages = sysconf( _SC_PHYS_PAGES );
+        pageSize = sysconf( _SC_PAGESIZE );
+        if ( pages > 0 && pageSize > 0 && pages / 2 < bytes / pageSize )
+        {
+            bytes = pages / 2 * pageSize;
+        }
+#else
+        pages = 0;
+        pageSize = 0;
+#endif
+    }
+
+    return bytes;
+}
+
+
+
+/******************************************************************************
+ * Function: _position_key                                                    *
+ * Imports: the solver, pointer to the game board, player to move,            *
+ *          a cell, or -1 for the position itself                             *
+ * Returns: the key of the position after the player takes the cell           *
+ * Purpose: works the canonical hash of the child out from the board's        *
+ *          symmetric hashes without playing the move, then mixes in the      *
+ *          attacker so that both searches can share the table.               *
+ ******************************************************************************/
+static unsigned long _position_key( Solver *solver, GameBoard *board,
+    TicTacTile player, int cell )
+{
+    unsigned long key, hash;
+    int s, area;
+
+    area = board->settings->width * board->settings->height;
+    key = ~( (unsigned long) 0 );
+    for ( s = 0; s < board->numSymmetries; s++ )
+    {
+        hash = board->hashes[s];
+        if ( cell >= 0 )
+        {
+            hash ^= board->zobrist[( player - 1 ) * area +
+                board->symmetry[s * area + cell]];
+        }
+        if ( hash < key )
+        {
+            key = hash;
+        }
+    }
+
+    return key ^ ( (unsigned long) solver->attacker * SOLVE_GOAL_KEY );
+}
+
+
+
+/******************************************************************************
+ * Function: _lookup                                                          *
+ * Imports: the solver, key of a position                                     *
+ * Returns: the position's entry in the proof table, NULL if there is none    *
+ ******************************************************************************/
+static ProofEntry *_lookup( Solver *solver, unsigned long key )
+{
+    ProofEntry *bucket, *entry;
+    int i;
+
+    bucket = solver->entries + ( key & solver->mask ) * SOLVE_WAYS;
+    entry = NULL;
+    for ( i = 0; i < SOLVE_WAYS && entry == NULL; i++ )
+    {
+        if ( bucket[i].key == key )
+        {
+            entry = &bucket[i];
+        }
+    }
+
+    return entry;
+}
+
+
+
+/******************************************************************************
+ * Function: _store                                                           *
+ * Imports: the solver, key of a position, its proof and disproof numbers,    *
+ *          the work done to find them                                        *
+ * Exports: stores the position in the proof table                            *
+ * Purpose: overwrites the position's own entry if it has one, otherwise the  *
+ *          entry in its bucket that took the least work to find.             *
+ ******************************************************************************/
+static void _store( Solver *solver, unsigned long key, unsigned long proof,
+    unsigned long disproof, unsigned long work )
+{
+    ProofEntry *bucket, *entry;
+    int i;
+
+    bucket = solver->entries + ( key & solver->mask ) * SOLVE_WAYS;
+    entry = &bucket[0];
+    for ( i = 0; i < SOLVE_WAYS && entry->key != key; i++ )
+    {
+        if ( bucket[i].key == key || bucket[i].work < entry->work )
+        {
+            entry = &bucket[i];
+        }
+    }
+
+    entry->key = key;
+    entry->proof = (unsigned int) proof;
+    entry->disproof = (unsigned int) disproof;
+    entry->work = work;
+}
+
+
+
+/******************************************************************************
+ * Function: _print_pv                                                        *
+ * Imports: the solver, pointer to the empty game board, the winner or        *
+ *          TicTacNone for a draw                                             *
+ * Exports: none                                                              *
+ * Purpose: follows the proof from the start of the game and prints the       *
+ *          moves. The winner plays the move that was proven with the least   *
+ *          work and the loser the move that took the most work to refute. In *
+ *          a draw, each side plays the move that shows the other side        *
+ *          cannot win. The line stops early if the table has lost an entry.  *
+ ******************************************************************************/
+static void _print_pv( Solver *solver, GameBoard *board, TicTacTile winner )
+{
+    ProofEntry *entry;
+    TicTacTile player, opponent;
+    unsigned long proof, disproof, bestWork;
+    int *played, numPlayed, count, i, cell, width;
+    BOOL winning, found;
+
+    width = board->settings->width;
+    played = (int*) malloc( board->emptyCount * sizeof(int) );
+    numPlayed = 0;
+    player = TicTacX;
+
+    printf( "Principal variation:" );
+    count = 1;
+    while ( count > 0 )
+    {
+        opponent = player;
+        changePlayer( &opponent );
+
+        /* look at the position through the eyes of the side that can win,
+         * or in a draw, the side that is not to move */
+        solver->attacker = winner != TicTacNone ? winner : opponent;
+        winning = player == solver->attacker;
+
+        count = _expand( solver, board, player, 0, &proof, &disproof );
+        found = FALSE;
+        bestWork = 0;
+        cell = -1;
+        for ( i = 0; i < count; i++ )
+        {
+            entry = _lookup( solver,
+                _position_key( solver, board, player, solver->moves[i] ) );
+
+            /* the loser of a won game has nothing but lost moves */
+            if ( entry != NULL && ( winning ? entry->proof == 0 :
+                 entry->disproof == 0 || winner != TicTacNone ) &&
+                 ( !found || ( winning ? entry->work < bestWork :
+                               entry->work > bestWork ) ) )
+            {
+                found = TRUE;
+                bestWork = entry->work;
+                cell = solver->moves[i];
+            }
+        }
+
+        /* a position settled by threats is played out to the win: the
+         * winner completes a line, the loser blocks one of two threats */
+        if ( count == 0 && winningCells( board, player, &cell, 1 ) > 0 )
+        {
+            found = TRUE;
+        }
+        else if ( count == 0 &&
+                  winningCells( board, opponent, solver->moves, 2 ) == 2 )
+        {
+            found = TRUE;
+            cell = solver->moves[0];
+            count = 1;
+        }
+        else if ( count > 0 && !found )
+        {
+            printf( " ..." );
+            count = 0;
+        }
+
+        if ( found )
+        {
+            printf( " %d,%d", cell % width, cell / width );
+            placeTile( board, player, cell % width, cell / width );
+            played[numPlayed] = cell;
+            numPlayed++;
+            player = opponent;
+        }
+    }
+    printf( "\n" );
+
+    /* take the moves back */
+    for ( i = numPlayed - 1; i >= 0; i-- )
+    {
+        removeTile( board, played[i] % width, played[i] / width );
+    }
+    free( played );
+}
+
+
+
+/******************************************************************************
+ * Function: _save_checkpoint                                                 *
+ * Imports: the solver, pointer to the game board                             *
+ * Returns: TRUE if the file could not be written, FALSE otherwise            *
+ * Purpose: writes every entry of the proof table to a temporary file, then   *
+ *          renames it over the checkpoint, so that a solve stopped while     *
+ *          saving still leaves the previous checkpoint in one piece.         *
+ ******************************************************************************/
+static BOOL _save_checkpoint( Solver *solver, GameBoard *board )
+{
+    CheckpointHeader header;
+    FILE *file;
+    char *tempName;
+    unsigned long i;
+    BOOL error;
+
+    tempName = (char*) malloc( strlen( solver->checkpoint ) + 5 );
+    sprintf( tempName, "%s.tmp", solver->checkpoint );
+
+    memset( &header, 0, sizeof(CheckpointHeader) );
+    memcpy( header.magic, SOLVE_MAGIC, sizeof(header.magic) );
+    header.width = board->settings->width;
+    header.height = board->settings->height;
+    header.matches = board->settings->matches;
+    header.attacker = (int) solver->attacker;
+    header.nodes = solver->nodes;
+    for ( i = 0; i < ( solver->mask + 1 ) * SOLVE_WAYS; i++ )
+    {
+        if ( solver->entries[i].key != 0 )
+        {
+            header.count++;
+        }
+    }
+
+    error = FALSE;
+    file = fopen( tempName, "wb" );
+    if ( file == NULL )
+    {
+        printErr( "Could not write the checkpoint file" );
+        error = TRUE;
+    }
+    else
+    {
+        fwrite( &header, sizeof(CheckpointHeader), 1, file );
+        for ( i = 0; i < ( solver->mask + 1 ) * SOLVE_WAYS; i++ )
+        {
+            if ( solver->entries[i].key != 0 )
+            {
+                fwrite( &solver->entries[i], sizeof(ProofEntry), 1, file );
+            }
+        }
+
+        error = ferror( file ) != 0;
+        fclose( file );
+        if ( error || rename( tempName, solver->checkpoint ) != 0 )
+        {
+            printErr( "Could not write the checkpoint file" );
+            error = TRUE;
+        }
+    }
+
+    solver->lastSave = wallTime( );
+    free( tempName );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _load_checkpoint                                                 *
+ * Imports: the solver, pointer to the game board                             *
+ * Returns: TRUE if the checkpoint is invalid or for other settings,          *
+ *          FALSE if it was loaded or does not exist yet                      *
+ * Exports: the attacker, node count and proof table of the solver            *
+ * Purpose: carries on a solve from where its checkpoint was written. The     *
+ *          entries are stored again, so the table may be a different size.   *
+ ******************************************************************************/
+static BOOL _load_checkpoint( Solver *solver, GameBoard *board )
+{
+    CheckpointHeader header;
+    ProofEntry entry;
+    FILE *file;
+    long i;
+    BOOL error;
+
+    error = FALSE;
+    file = fopen( solver->checkpoint, "rb" );
+    if ( file != NULL )
+    {
+        if ( fread( &header, sizeof(CheckpointHeader), 1, file ) != 1 ||
+             memcmp( header.magic, SOLVE_MAGIC, sizeof(header.magic) ) != 0 )
+        {
+            printErr( "Invalid checkpoint file" );
+            error = TRUE;
+        }
+        else if ( header.width != board->settings->width ||
+                  header.height != board->settings->height ||
+                  header.matches != board->settings->matches )
+        {
+            printErr( "The checkpoint is for different settings" );
+            error = TRUE;
+        }
+        else
+        {
+            solver->attacker = (TicTacTile) header.attacker;
+            solver->nodes = header.nodes;
+            i = 0;
+            while ( !error && i < header.count )
+            {
+                if ( fread( &entry, sizeof(ProofEntry), 1, file ) != 1 )
+                {
+                    printErr( "The checkpoint file is cut short" );
+                    error = TRUE;
+                }
+                else
+                {
+                    _store( solver, entry.key, entry.proof, entry.disproof,
+                        entry.work );
+                }
+                i++;
+            }
+
+            if ( !error )
+            {
+                printf( "  Resumed from %s: %ld entries, %ld nodes\n",
+                    solver->checkpoint, header.count, header.nodes );
+            }
+        }
+
+        fclose( file );
+    }
+
+    return error;
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * File:---- solve.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the state of the solver, which proves whether an M,N,K   *
+ *           game is a win for the first player, the second player or a draw  *
+ *           when both sides play perfectly.                                  *
+ ******************************************************************************/
+
+#ifndef SOLVE_H
+#define SOLVE_H
+
+#include "game.h"
+
+
+/******************************************************************************
+ * PN_INF: the proof or disproof number of a position that is settled         *
+ * SOLVE_WAYS: the number of entries in each bucket of the proof table        *
+ * SOLVE_GOAL_KEY: mixed into the key of a position for each attacker, so     *
+ *                 both searches can share one table                          *
+ * SOLVE_SAVE_SECONDS: how often the checkpoint file is written               *
+ * SOLVE_TABLE_SIZE: proof table size used when the settings file does not    *
+ *                   set T, in megabytes. At most half of the machine's       *
+ *                   memory is taken                                          *
+ * SOLVE_MAGIC: the first bytes of a checkpoint file                          *
+ ******************************************************************************/
+#define PN_INF 0x3FFFFFFFUL
+#define SOLVE_WAYS 4
+#define SOLVE_GOAL_KEY 0x9E3779B97F4A7C15UL
+#define SOLVE_SAVE_SECONDS 60
+#define SOLVE_TABLE_SIZE 1024
+#define SOLVE_MAGIC "MNKSOLV1"
+
+
+
+/******************************************************************************
+ * ProofEntry: A struct that holds what is known about one position.          *
+ * Consists of:                                                               *
+ *     key - the canonical hash of the position mixed with the attacker,      *
+ *           0 if the entry is empty                                          *
+ *     proof - the least number of positions still to be proven won for the   *
+ *             attacker to win, 0 once it is proven                           *
+ *     disproof - the same for the attacker not winning, 0 once disproven     *
+ *     work - the number of nodes searched below the position, used to keep   *
+ *            the entries that took longest to work out                       *
+ ******************************************************************************/
+typedef struct
+{
+    unsigned long key;
+    unsigned int proof;
+    unsigned int disproof;
+    unsigned long work;
+} ProofEntry;
+
+
+
+/******************************************************************************
+ * CheckpointHeader: the start of a checkpoint file, which is followed by     *
+ *                   count ProofEntry structs                                 *
+ * Consists of:                                                               *
+ *     magic - SOLVE_MAGIC                                                    *
+ *     width, height, matches - the settings that were being solved           *
+ *     attacker - the player whose win was being searched for                 *
+ *     nodes - the number of nodes searched so far                            *
+ *     count - the number of entries that follow                              *
+ * Notes: checkpoints are raw structs, so they only load on the same kind of  *
+ *        machine that wrote them.                                            *
+ ******************************************************************************/
+typedef struct
+{
+    char magic[8];
+    int width;
+    int height;
+    int matches;
+    int attacker;
+    long nodes;
+    long count;
+} CheckpointHeader;
+
+
+
+/******************************************************************************
+ * Solver: A struct that holds the state of a solve.                          *
+ * Consists of:                                                               *
+ *     entries - the proof table, SOLVE_WAYS entries per bucket               *
+ *     mask - the number of buckets minus one, which is a power of two        *
+ *     attacker - the player whose win is being searched for. The first       *
+ *                player is tried first; if it cannot win, the second player  *
+ *                is tried, and if neither can the game is a draw             *
+ *     nodes - the number of positions searched                               *
+ *     moves - a stack of candidate cells (y * width + x), one list per ply   *
+ *     capacity - the number of cells the move stack has room for             *
+ *     checkpoint - name of the checkpoint file, NULL if there is none        *
+ *     lastSave - the wall time the checkpoint was last written               *
+ ******************************************************************************/
+typedef struct
+{
+    ProofEntry *entries;
+    unsigned long mask;
+    TicTacTile attacker;
+    long nodes;
+    int *moves;
+    int capacity;
+    char *checkpoint;
+    double lastSave;
+} Solver;
+
+
+
+/* Function Prototypes */
+BOOL solveGame( Settings*, char* );
+
+#endif
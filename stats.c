@@ -0,0 +1,942 @@
+/******************************************************************************
+ * File:---- stats.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the --stats option, which loads the games of a set of *
+ *           logs into a column store and reports, for each variant, how the  *
+ *           games ended, how long they lasted, where they were played and    *
+ *           how they most often opened. Every pass over the columns is       *
+ *           shared out between all processors and each thread keeps its own  *
+ *           counts, which are only added together at the end.                *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stats.h"
+#include "replay.h"
+#include "logParser.h"
+#include "timer.h"
+#include "workerPool.h"
+
+
+/******************************************************************************
+ * STATS_SHADES: the characters the heatmaps are drawn with, from no moves to *
+ *               the most moves on any cell                                   *
+ * STATS_BAR: the length of the longest bar of the length histogram           *
+ * STATS_WIDTH: the width of the screen the report is laid out for            *
+ ******************************************************************************/
+#define STATS_SHADES " .:-=+*#%@"
+#define STATS_BAR 40
+#define STATS_WIDTH 80
+
+
+
+/******************************************************************************
+ * StatsWorker: A struct that holds everything a statistics thread needs.     *
+ * Consists of:                                                               *
+ *     fileNames - the shared (read-only) names of the logs                   *
+ *     logs - the shared parsed logs, see parseLogs                           *
+ *     numFiles - the number of logs                                          *
+ *     archive - the shared column store. Each column is filled by one pass,  *
+ *               and each row of it by a single thread                        *
+ *     fileGame - the shared (read-only) index of each log's first game in    *
+ *                the archive                                                 *
+ *     openings - the shared opening of each game, written like a column      *
+ *     next - the shared counter of logs, games or moves that have been       *
+ *            claimed                                                         *
+ *     stats - this worker's counts, one VariantStats per variant             *
+ *     variant - the variant this worker's board was made for                 *
+ *     board - this worker's board, remade only when the variant changes      *
+ *     padding - keeps neighbouring workers out of each other's cache lines   *
+ * Notes: as in replay.c, the only shared value written by more than one      *
+ *        thread is next, which is updated with an atomic add.                *
+ ******************************************************************************/
+typedef struct
+{
+    char **fileNames;
+    ParsedLog **logs;
+    int numFiles;
+    GameArchive *archive;
+    long *fileGame;
+    Opening *openings;
+    long *next;
+    VariantStats *stats;
+    int variant;
+    GameBoard *board;
+    char padding[64];
+} StatsWorker;
+
+
+/******************************************************************************
+ * Static function prototypes:                                                *
+ * Run the passes over the archive on every thread, lay the archive out, add  *
+ * up the counts of the threads and report them                               *
+ ******************************************************************************/
+static void *_fill_worker( void* );
+static void *_game_worker( void* );
+static void *_move_worker( void* );
+static void _layout( GameArchive*, ParsedLog**, int, long* );
+static int _find_variant( GameArchive*, Settings*, int*, int );
+static VariantStats *_create_stats( GameArchive* );
+static void _delete_stats( VariantStats*, int );
+static VariantStats *_merge( StatsWorker*, int );
+static int _compare_openings( const void*, const void* );
+static BOOL _report( StatsWorker*, VariantStats*, double, int );
+static void _print_variant( GameArchive*, int, VariantStats*, Opening*,
+    long );
+static void _print_heatmaps( Settings*, VariantStats* );
+static char _shade( long, long );
+
+
+/******************************************************************************
+ * Function: archiveStats                                                     *
+ * Imports: fileNames - names of the logs to read, in either format           *
+ *          numFiles - the number of logs                                     *
+ *          numThreads - the number of threads to read them with              *
+ * Returns: TRUE if any log could not be read, FALSE otherwise                *
+ * Purpose: parses the logs, one thread per log at a time, and moves their    *
+ *          games into a GameArchive, replaying each game on the way to find  *
+ *          its winner. The statistics are then gathered by one pass over the *
+ *          game columns and one over the move columns, each shared out       *
+ *          between the threads in batches, and the openings are sorted so    *
+ *          that equal openings sit next to each other.                       *
+ ******************************************************************************/
+BOOL archiveStats( char **fileNames, int numFiles, int numThreads )
+{
+    StatsWorker *workers;
+    GameArchive archive;
+    ParsedLog **logs;
+    VariantStats *totals;
+    Opening *openings;
+    long *fileGame, next;
+    double start;
+    BOOL error;
+    int i;
+
+    workers = (StatsWorker*) malloc( numThreads * sizeof(StatsWorker) );
+    fileGame = (long*) malloc( ( numFiles + 1 ) * sizeof(long) );
+    memset( &archive, 0, sizeof(GameArchive) );
+
+    start = wallTime( );
+    logs = parseLogs( fileNames, numFiles, numThreads );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        memset( &workers[i], 0, sizeof(StatsWorker) );
+        workers[i].fileNames = fileNames;
+        workers[i].logs = logs;
+        workers[i].numFiles = numFiles;
+        workers[i].archive = &archive;
+        workers[i].fileGame = fileGame;
+        workers[i].next = &next;
+    }
+
+    /* the rows of every log, then the columns, log by log */
+    _layout( &archive, logs, numFiles, fileGame );
+    next = 0;
+    runWorkers( workers, sizeof(StatsWorker), numThreads, &_fill_worker );
+
+    /* the counts, game by game and then move by move */
+    openings = (Opening*) malloc( ( archive.numGames + 1 ) * sizeof(Opening) );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        workers[i].stats = _create_stats( &archive );
+        workers[i].openings = openings;
+    }
+    next = 0;
+    runWorkers( workers, sizeof(StatsWorker), numThreads, &_game_worker );
+    next = 0;
+    runWorkers( workers, sizeof(StatsWorker), numThreads, &_move_worker );
+
+    totals = _merge( workers, numThreads );
+    qsort( openings, archive.numGames, sizeof(Opening),
+        &_compare_openings );
+
+    error = _report( workers, totals, wallTime( ) - start, numThreads );
+
+    /* clean up */
+    _delete_stats( totals, archive.numVariants );
+    for ( i = 0; i < numThreads; i++ )
+    {
+        _delete_stats( workers[i].stats, archive.numVariants );
+        if ( workers[i].board != NULL )
+        {
+            deleteGameBoard( workers[i].board );
+        }
+    }
+    for ( i = 0; i < numFiles; i++ )
+    {
+        if ( logs[i] != NULL )
+        {
+            deleteParsedLog( logs[i] );
+        }
+    }
+    free( openings );
+    free( archive.gameFirst );
+    free( archive.gameLength );
+    free( archive.gameVariant );
+    free( archive.gameWinner );
+    free( archive.moveCell );
+    free( archive.movePlayer );
+    free( archive.moveGame );
+    free( archive.variants );
+    free( fileGame );
+    free( logs );
+    free( workers );
+
+    return error;
+}
+
+
+
+/******************************************************************************
+ * Function: _fill_worker                                                     *
+ * Imports: pointer to a StatsWorker struct                                   *
+ * Returns: NULL                                                              *
+ * Exports: the winners and move columns of the logs claimed by the worker    *
+ * Purpose: the body of a thread while the archive is being filled. Claims    *
+ *          one log at a time, replays each of its games with verifyGame to   *
+ *          find the winner and copies its turns into the move columns. The   *
+ *          turns of the log are freed as soon as they have been copied, so   *
+ *          the archive does not need the memory of a second copy of them.    *
+ ******************************************************************************/
+static void *_fill_worker( void *data )
+{
+    StatsWorker *worker;
+    GameArchive *archive;
+    ParsedLog *log;
+    ParsedGame *game;
+    TurnLog *turn;
+    VerifyResult result;
+    Settings *settings;
+    long file, row, move;
+    int g, t, variant;
+
+    worker = (StatsWorker*) data;
+    archive = worker->archive;
+    file = __sync_fetch_and_add( worker->next, 1 );
+    while ( file < worker->numFiles )
+    {
+        log = worker->logs[file];
+        for ( g = 0; log != NULL && g < log->games->size; g++ )
+        {
+            game = (ParsedGame*) arrayGet( log->games, g );
+            row = worker->fileGame[file] + g;
+            variant = archive->gameVariant[row];
+            settings = &archive->variants[variant];
+
+            /* as in replay.c, a board is cleared rather than made again */
+            if ( worker->board != NULL && worker->variant == variant )
+            {
+                boardReset( worker->board );
+            }
+            else
+            {
+                if ( worker->board != NULL )
+                {
+                    deleteGameBoard( worker->board );
+                }
+                worker->variant = variant;
+                worker->board = (GameBoard*) malloc( sizeof(GameBoard) );
+                boardInit( worker->board, settings );
+            }
+
+            verifyGame( worker->board, log->turns, game, &result );
+            if ( result.status == VerifyWon )
+            {
+                archive->gameWinner[row] = (unsigned char) result.winner;
+            }
+            else if ( result.status == VerifyDrawn )
+            {
+                archive->gameWinner[row] = TicTacNone;
+            }
+            else
+            {
+                archive->gameWinner[row] = STATS_UNFINISHED;
+            }
+
+            for ( t = 0; t < game->count; t++ )
+            {
+                turn = (TurnLog*) arrayGet( log->turns, game->first + t );
+                move = archive->gameFirst[row] + t;
+                if ( turn->location.x >= 0 &&
+                     turn->location.x < settings->width &&
+                     turn->location.y >= 0 &&
+                     turn->location.y < settings->height )
+                {
+                    archive->moveCell[move] = turn->location.y *
+                        settings->width + turn->location.x;
+                }
+                else
+                {
+                    archive->moveCell[move] = -1;
+                }
+                archive->movePlayer[move] = (unsigned char) turn->player;
+                archive->moveGame[move] = (int) row;
+            }
+        }
+
+        if ( log != NULL )
+        {
+            freeArray( log->turns );
+            log->turns = createArray( sizeof(TurnLog), NULL );
+        }
+        file = __sync_fetch_and_add( worker->next, 1 );
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: _game_worker                                                     *
+ * Imports: pointer to a StatsWorker struct                                   *
+ * Returns: NULL                                                              *
+ * Exports: the worker's counts of results, lengths and first moves, and the  *
+ *          openings of the games claimed by the worker                       *
+ * Purpose: the body of a thread during the pass over the games. Claims       *
+ *          batches of games from the shared counter and counts each in the   *
+ *          stats of its variant. Only the game columns and the first moves   *
+ *          of each game are read. Games too short to have an opening, or     *
+ *          with a move off the board in it, get the variant -1 so they sort  *
+ *          to the front and are left out of the report.                      *
+ ******************************************************************************/
+static void *_game_worker( void *data )
+{
+    StatsWorker *worker;
+    GameArchive *archive;
+    VariantStats *stats;
+    Opening *opening;
+    Settings *settings;
+    long first, last, i, area, bin;
+    int j, length, cell;
+
+    worker = (StatsWorker*) data;
+    archive = worker->archive;
+    first = __sync_fetch_and_add( worker->next, STATS_BATCH );
+    while ( first < archive->numGames )
+    {
+        last = first + STATS_BATCH;
+        if ( last > archive->numGames )
+        {
+            last = archive->numGames;
+        }
+
+        for ( i = first; i < last; i++ )
+        {
+            stats = &worker->stats[archive->gameVariant[i]];
+            settings = &archive->variants[archive->gameVariant[i]];
+            area = (long) settings->width * settings->height;
+            length = archive->gameLength[i];
+
+            stats->games++;
+            stats->moves += length;
+            stats->results[archive->gameWinner[i]]++;
+            /* bar b holds the lengths up to ( b + 1 ) * area / STATS_BINS */
+            bin = ( (long) length * STATS_BINS + area - 1 ) / area - 1;
+            stats->lengths[bin < 0 ? 0 :
+                ( bin < STATS_BINS ? bin : STATS_BINS - 1 )]++;
+
+            cell = length > 0 ? archive->moveCell[archive->gameFirst[i]] : -1;
+            if ( cell >= 0 && stats->firstMoves != NULL )
+            {
+                stats->firstMoves[cell]++;
+            }
+
+            opening = &worker->openings[i];
+            opening->variant = archive->gameVariant[i];
+            for ( j = 0; j < STATS_OPENING_MOVES; j++ )
+            {
+                opening->cells[j] = j < length ?
+                    archive->moveCell[archive->gameFirst[i] + j] : -1;
+                if ( opening->cells[j] < 0 )
+                {
+                    opening->variant = -1;
+                }
+            }
+        }
+
+        first = __sync_fetch_and_add( worker->next, STATS_BATCH );
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: _move_worker                                                     *
+ * Imports: pointer to a StatsWorker struct                                   *
+ * Returns: NULL                                                              *
+ * Exports: the worker's counts of moves on each cell                         *
+ * Purpose: the body of a thread during the pass over the moves. Claims       *
+ *          batches of moves from the shared counter and counts the cell of   *
+ *          each in the stats of its game's variant, reading only the cell    *
+ *          and game columns.                                                 *
+ ******************************************************************************/
+static void *_move_worker( void *data )
+{
+    StatsWorker *worker;
+    GameArchive *archive;
+    VariantStats *stats;
+    long first, last, i;
+
+    worker = (StatsWorker*) data;
+    archive = worker->archive;
+    first = __sync_fetch_and_add( worker->next, STATS_BATCH );
+    while ( first < archive->numMoves )
+    {
+        last = first + STATS_BATCH;
+        if ( last > archive->numMoves )
+        {
+            last = archive->numMoves;
+        }
+
+        for ( i = first; i < last; i++ )
+        {
+            stats = &worker->stats[archive->gameVariant[archive->moveGame[i]]];
+            if ( archive->moveCell[i] >= 0 && stats->allMoves != NULL )
+            {
+                stats->allMoves[archive->moveCell[i]]++;
+            }
+        }
+
+        first = __sync_fetch_and_add( worker->next, STATS_BATCH );
+    }
+
+    return NULL;
+}
+
+
+
+/******************************************************************************
+ * Function: _layout                                                          *
+ * Imports: archive - an empty archive                                        *
+ *          logs - the parsed logs, NULL for any that could not be opened     *
+ *          numFiles - the number of logs                                     *
+ * Exports: archive - with every column allocated, and the variant, first     *
+ *                    move and length of every game filled in                 *
+ *          fileGame - the index of each log's first game in the archive      *
+ * Purpose: gives every game a row and every move a place in the columns, in  *
+ *          the order of the logs, so that the columns can then be filled one *
+ *          log per thread without any two threads writing the same rows.     *
+ ******************************************************************************/
+static void _layout( GameArchive *archive, ParsedLog **logs, int numFiles,
+    long *fileGame )
+{
+    ParsedGame *game;
+    long row;
+    int f, g, capacity, last;
+
+    archive->numGames = 0;
+    archive->numMoves = 0;
+    for ( f = 0; f < numFiles; f++ )
+    {
+        fileGame[f] = archive->numGames;
+        if ( logs[f] != NULL )
+        {
+            archive->numGames += logs[f]->games->size;
+            archive->numMoves += logs[f]->turns->size;
+        }
+    }
+    fileGame[numFiles] = archive->numGames;
+
+    archive->gameFirst = (long*) malloc(
+        ( archive->numGames + 1 ) * sizeof(long) );
+    archive->gameLength = (int*) malloc(
+        ( archive->numGames + 1 ) * sizeof(int) );
+    archive->gameVariant = (int*) malloc(
+        ( archive->numGames + 1 ) * sizeof(int) );
+    archive->gameWinner = (unsigned char*) malloc( archive->numGames + 1 );
+    archive->moveCell = (int*) malloc(
+        ( archive->numMoves + 1 ) * sizeof(int) );
+    archive->movePlayer = (unsigned char*) malloc( archive->numMoves + 1 );
+    archive->moveGame = (int*) malloc(
+        ( archive->numMoves + 1 ) * sizeof(int) );
+
+    capacity = 0;
+    last = 0;
+    archive->numVariants = 0;
+    archive->variants = NULL;
+    archive->numMoves = 0;
+    row = 0;
+    for ( f = 0; f < numFiles; f++ )
+    {
+        for ( g = 0; logs[f] != NULL && g < logs[f]->games->size; g++ )
+        {
+            game = (ParsedGame*) arrayGet( logs[f]->games, g );
+            last = _find_variant( archive, &game->settings, &capacity, last );
+            archive->gameVariant[row] = last;
+            archive->gameFirst[row] = archive->numMoves;
+            archive->gameLength[row] = game->count;
+            archive->numMoves += game->count;
+            row++;
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _find_variant                                                    *
+ * Imports: archive - the archive being laid out                              *
+ *          settings - the settings of a game                                 *
+ *          capacity - the number of variants there is room for               *
+ *          last - the variant of the game before, tried first since the      *
+ *                 games of a log nearly always share their settings          *
+ * Returns: the index of the variant with the settings                        *
+ * Exports: archive - with the settings added as a new variant if they are    *
+ *                    not one yet, and capacity, if there was no room for it  *
+ * Purpose: gives each different M, N and K a variant of its own              *
+ ******************************************************************************/
+static int _find_variant( GameArchive *archive, Settings *settings,
+    int *capacity, int last )
+{
+    Settings *variant;
+    int found, i;
+
+    found = -1;
+    for ( i = 0; i <= archive->numVariants && found < 0; i++ )
+    {
+        /* the first try is the last variant found, then every variant */
+        variant = &archive->variants[i == 0 ? last : i - 1];
+        if ( ( i > 0 || last < archive->numVariants ) &&
+             variant->width == settings->width &&
+             variant->height == settings->height &&
+             variant->matches == settings->matches )
+        {
+            found = i == 0 ? last : i - 1;
+        }
+    }
+
+    if ( found < 0 )
+    {
+        if ( archive->numVariants == *capacity )
+        {
+            *capacity = *capacity > 0 ? *capacity * 2 : 4;
+            archive->variants = (Settings*) realloc( archive->variants,
+                *capacity * sizeof(Settings) );
+        }
+        found = archive->numVariants;
+        archive->variants[found] = *settings;
+        archive->numVariants++;
+    }
+
+    return found;
+}
+
+
+
+/******************************************************************************
+ * Function: _create_stats                                                    *
+ * Imports: a laid out archive                                                *
+ * Returns: a zeroed VariantStats for each variant of the archive, with a     *
+ *          count per cell of the variant's board                             *
+ * Purpose: sets up the counts of one thread                                  *
+ ******************************************************************************/
+static VariantStats *_create_stats( GameArchive *archive )
+{
+    VariantStats *stats;
+    Settings *settings;
+    int v;
+
+    stats = (VariantStats*) malloc(
+        ( archive->numVariants + 1 ) * sizeof(VariantStats) );
+    memset( stats, 0, ( archive->numVariants + 1 ) * sizeof(VariantStats) );
+    for ( v = 0; v < archive->numVariants; v++ )
+    {
+        settings = &archive->variants[v];
+        if ( !isSparse( settings ) )
+        {
+            stats[v].firstMoves = (long*) calloc(
+                (size_t) settings->width * settings->height, sizeof(long) );
+            stats[v].allMoves = (long*) calloc(
+                (size_t) settings->width * settings->height, sizeof(long) );
+        }
+    }
+
+    return stats;
+}
+
+
+
+/******************************************************************************
+ * Function: _delete_stats                                                    *
+ * Imports: stats - made by _create_stats, numVariants - their number         *
+ * Exports: none                                                              *
+ * Purpose: frees a set of counts                                             *
+ ******************************************************************************/
+static void _delete_stats( VariantStats *stats, int numVariants )
+{
+    int v;
+
+    for ( v = 0; v < numVariants; v++ )
+    {
+        free( stats[v].firstMoves );
+        free( stats[v].allMoves );
+    }
+    free( stats );
+}
+
+
+
+/******************************************************************************
+ * Function: _merge                                                           *
+ * Imports: workers - the workers, all finished                               *
+ *          numThreads - the number of workers                                *
+ * Returns: the counts of all workers added together, one per variant         *
+ * Purpose: the reduction at the end of the passes. Adding up a count per     *
+ *          cell for each thread is far cheaper than having the threads share *
+ *          the counts, which would send the same cache lines back and forth  *
+ *          between processors on every move.                                 *
+ ******************************************************************************/
+static VariantStats *_merge( StatsWorker *workers, int numThreads )
+{
+    VariantStats *totals, *total, *stats;
+    Settings *settings;
+    long area, c;
+    int i, v, r;
+
+    totals = _create_stats( workers->archive );
+    for ( v = 0; v < workers->archive->numVariants; v++ )
+    {
+        settings = &workers->archive->variants[v];
+        area = (long) settings->width * settings->height;
+        total = &totals[v];
+        for ( i = 0; i < numThreads; i++ )
+        {
+            stats = &workers[i].stats[v];
+            total->games += stats->games;
+            total->moves += stats->moves;
+            for ( r = 0; r < STATS_RESULTS; r++ )
+            {
+                total->results[r] += stats->results[r];
+            }
+            for ( r = 0; r < STATS_BINS; r++ )
+            {
+                total->lengths[r] += stats->lengths[r];
+            }
+            for ( c = 0; total->firstMoves != NULL && c < area; c++ )
+            {
+                total->firstMoves[c] += stats->firstMoves[c];
+                total->allMoves[c] += stats->allMoves[c];
+            }
+        }
+    }
+
+    return totals;
+}
+
+
+
+/******************************************************************************
+ * Function: _compare_openings                                                *
+ * Imports: two pointers to Opening structs                                   *
+ * Returns: negative, zero or positive as the first sorts before, with or     *
+ *          after the second                                                  *
+ * Purpose: orders openings by variant, then move by move, so that the games  *
+ *          that opened the same way end up next to each other                *
+ ******************************************************************************/
+static int _compare_openings( const void *a, const void *b )
+{
+    const Opening *first, *second;
+    int order, i;
+
+    first = (const Opening*) a;
+    second = (const Opening*) b;
+    order = first->variant - second->variant;
+    for ( i = 0; i < STATS_OPENING_MOVES && order == 0; i++ )
+    {
+        order = first->cells[i] - second->cells[i];
+    }
+
+    return order;
+}
+
+
+
+/******************************************************************************
+ * Function: _report                                                          *
+ * Imports: workers - the workers, all finished, which share the archive      *
+ *          totals - the counts of every variant                              *
+ *          seconds - the time taken to load the logs and count their games   *
+ *          numThreads - the number of threads used                           *
+ * Returns: TRUE if any log could not be read, FALSE otherwise                *
+ * Purpose: prints one line per log that could not be read in full, as        *
+ *          --verify does, then a summary and the statistics of every         *
+ *          variant in the order they were first found                        *
+ ******************************************************************************/
+static BOOL _report( StatsWorker *workers, VariantStats *totals,
+    double seconds, int numThreads )
+{
+    GameArchive *archive;
+    ParsedLog *log;
+    long first, next;
+    int f, v, badFiles;
+    char *name;
+
+    archive = workers->archive;
+    badFiles = 0;
+    for ( f = 0; f < workers->numFiles; f++ )
+    {
+        log = workers->logs[f];
+        name = workers->fileNames[f];
+        if ( log == NULL )
+        {
+            printf( "%s: the file could not be opened\n", name );
+        }
+        else if ( log->bytes == 0 )
+        {
+            printf( "%s: the file is empty\n", name );
+        }
+        else if ( log->error != NULL && log->errorLine > 0 )
+        {
+            printf( "%s: line %ld: %s\n", name, log->errorLine, log->error );
+        }
+        else if ( log->error != NULL )
+        {
+            printf( "%s: %s\n", name, log->error );
+        }
+
+        if ( log == NULL || log->bytes == 0 || log->error != NULL )
+        {
+            badFiles++;
+        }
+    }
+
+    printf( "\nStatistics of %ld games (%ld moves) in %d files in %.3f s "
+            "(%.0f moves/sec)\n",
+        archive->numGames, archive->numMoves, workers->numFiles, seconds,
+        seconds > 0.0 ? archive->numMoves / seconds : 0.0 );
+    printf( "  Variants:   %10d\n"
+            "  Bad files:  %10d\n"
+            "  Threads:    %10d\n",
+            archive->numVariants, badFiles, numThreads );
+
+    /* the openings are sorted by variant, those left out (-1) first */
+    next = 0;
+    for ( v = 0; v < archive->numVariants; v++ )
+    {
+        while ( next < archive->numGames &&
+                workers->openings[next].variant < v )
+        {
+            next++;
+        }
+        first = next;
+        while ( next < archive->numGames &&
+                workers->openings[next].variant == v )
+        {
+            next++;
+        }
+        _print_variant( archive, v, &totals[v], &workers->openings[first],
+            next - first );
+    }
+    printf( "\n" );
+
+    return badFiles > 0;
+}
+
+
+
+/******************************************************************************
+ * Function: _print_variant                                                   *
+ * Imports: archive - the archive                                             *
+ *          variant - the index of the variant                                *
+ *          stats - the counts of the variant                                 *
+ *          openings - the sorted openings of the variant's games             *
+ *          numOpenings - the number of openings                              *
+ * Exports: none                                                              *
+ * Purpose: prints the results, length histogram, heatmaps and most common    *
+ *          openings of one variant                                           *
+ ******************************************************************************/
+static void _print_variant( GameArchive *archive, int variant,
+    VariantStats *stats, Opening *openings, long numOpenings )
+{
+    Settings *settings;
+    long top[STATS_TOP_OPENINGS], topCount[STATS_TOP_OPENINGS];
+    long area, most, run, i;
+    double games;
+    int b, j, from, to;
+
+    settings = &archive->variants[variant];
+    area = (long) settings->width * settings->height;
+    games = stats->games > 0 ? (double) stats->games : 1.0;
+
+    printf( "\nM=%d N=%d K=%d: %ld games, %.1f moves on average\n",
+        settings->width, settings->height, settings->matches, stats->games,
+        stats->moves / games );
+    printf( "  Player 1 wins: %10ld %5.1f%%\n"
+            "  Player 2 wins: %10ld %5.1f%%\n"
+            "  Draws:         %10ld %5.1f%%\n"
+            "  Unfinished:    %10ld %5.1f%%\n",
+            stats->results[TicTacX], 100.0 * stats->results[TicTacX] / games,
+            stats->results[TicTacO], 100.0 * stats->results[TicTacO] / games,
+            stats->results[TicTacNone],
+            100.0 * stats->results[TicTacNone] / games,
+            stats->results[STATS_UNFINISHED],
+            100.0 * stats->results[STATS_UNFINISHED] / games );
+
+    /* the histogram, each bar scaled to the longest */
+    printf( "\n  Game length:\n" );
+    most = 1;
+    for ( b = 0; b < STATS_BINS; b++ )
+    {
+        most = stats->lengths[b] > most ? stats->lengths[b] : most;
+    }
+    for ( b = 0; b < STATS_BINS; b++ )
+    {
+        from = (int) ( b * area / STATS_BINS ) + 1;
+        to = (int) ( ( b + 1 ) * area / STATS_BINS );
+        if ( to >= from )
+        {
+            printf( "  %5d-%-5d %10ld", from, to, stats->lengths[b] );
+            for ( j = 0; j < STATS_BAR * stats->lengths[b] / most; j++ )
+            {
+                printf( j == 0 ? " #" : "#" );
+            }
+            printf( "\n" );
+        }
+    }
+
+    if ( stats->firstMoves != NULL )
+    {
+        _print_heatmaps( settings, stats );
+    }
+
+    /* each run of equal openings, keeping the longest runs in order */
+    for ( j = 0; j < STATS_TOP_OPENINGS; j++ )
+    {
+        topCount[j] = 0;
+        top[j] = 0;
+    }
+    for ( i = 0; i < numOpenings; i += run )
+    {
+        run = 1;
+        while ( i + run < numOpenings &&
+                _compare_openings( &openings[i], &openings[i + run] ) == 0 )
+        {
+            run++;
+        }
+        for ( j = STATS_TOP_OPENINGS - 1; j >= 0 && run > topCount[j]; j-- )
+        {
+            if ( j + 1 < STATS_TOP_OPENINGS )
+            {
+                topCount[j + 1] = topCount[j];
+                top[j + 1] = top[j];
+            }
+            topCount[j] = run;
+            top[j] = i;
+        }
+    }
+
+    printf( "\n  Most common openings:\n" );
+    for ( j = 0; j < STATS_TOP_OPENINGS && topCount[j] > 0; j++ )
+    {
+        printf( "  %d.", j + 1 );
+        for ( b = 0; b < STATS_OPENING_MOVES; b++ )
+        {
+            printf( " %2d,%-2d", openings[top[j]].cells[b] % settings->width,
+                openings[top[j]].cells[b] / settings->width );
+        }
+        printf( " %10ld %5.1f%%\n", topCount[j], 100.0 * topCount[j] / games );
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _print_heatmaps                                                  *
+ * Imports: settings - the settings of a variant                              *
+ *          stats - the counts of the variant                                 *
+ * Exports: none                                                              *
+ * Purpose: draws where the first move of each game was played and where all  *
+ *          moves were played, two characters per cell, shaded by how close   *
+ *          each count is to the most played cell. The maps are drawn next to *
+ *          each other when both fit on the screen, otherwise one after the   *
+ *          other.                                                            *
+ ******************************************************************************/
+static void _print_heatmaps( Settings *settings, VariantStats *stats )
+{
+    long mostFirst, mostAll, c, area;
+    int x, y;
+    BOOL beside;
+
+    area = (long) settings->width * settings->height;
+    mostFirst = 1;
+    mostAll = 1;
+    for ( c = 0; c < area; c++ )
+    {
+        mostFirst = stats->firstMoves[c] > mostFirst ?
+            stats->firstMoves[c] : mostFirst;
+        mostAll = stats->allMoves[c] > mostAll ? stats->allMoves[c] : mostAll;
+    }
+
+    beside = 4 * settings->width + 8 <= STATS_WIDTH;
+    if ( beside )
+    {
+        printf( "\n  %-*s    All moves:\n", 2 * settings->width,
+            "First moves:" );
+    }
+    else
+    {
+        printf( "\n  First moves:\n" );
+    }
+    for ( y = 0; y < settings->height; y++ )
+    {
+        printf( "  " );
+        for ( x = 0; x < settings->width; x++ )
+        {
+            c = (long) y * settings->width + x;
+            printf( "%c%c", _shade( stats->firstMoves[c], mostFirst ),
+                _shade( stats->firstMoves[c], mostFirst ) );
+        }
+        for ( x = 0; beside && x < settings->width; x++ )
+        {
+            c = (long) y * settings->width + x;
+            printf( "%s%c%c", x == 0 ? "    " : "",
+                _shade( stats->allMoves[c], mostAll ),
+                _shade( stats->allMoves[c], mostAll ) );
+        }
+        printf( "\n" );
+    }
+
+    if ( !beside )
+    {
+        printf( "\n  All moves:\n" );
+        for ( y = 0; y < settings->height; y++ )
+        {
+            printf( "  " );
+            for ( x = 0; x < settings->width; x++ )
+            {
+                c = (long) y * settings->width + x;
+                printf( "%c%c", _shade( stats->allMoves[c], mostAll ),
+                    _shade( stats->allMoves[c], mostAll ) );
+            }
+            printf( "\n" );
+        }
+    }
+}
+
+
+
+/******************************************************************************
+ * Function: _shade                                                           *
+ * Imports: count - the count of a cell, most - the largest count of any cell *
+ * Returns: the character to draw the cell with                               *
+ * Purpose: picks a shade for a count. Only a count of zero is drawn blank,   *
+ *          so a cell that was played even once can be told from one that     *
+ *          never was.                                                        *
+ ******************************************************************************/
+static char _shade( long count, long most )
+{
+    long levels;
+
+    levels = (long) strlen( STATS_SHADES ) - 1;
+
+    return STATS_SHADES[( count * levels + most - 1 ) / most];
+}
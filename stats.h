@@ -0,0 +1,115 @@
+/******************************************************************************
+ * File:---- stats.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines the column store that the games of a set of logs are     *
+ *           loaded into, and the statistics gathered over it for each        *
+ *           variant (M, N and K) of the game.                                *
+ *           Declares the function behind the --stats option.                 *
+ ******************************************************************************/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "game.h"
+
+
+/******************************************************************************
+ * STATS_BATCH: the number of games or moves a thread claims from a shared    *
+ *              counter at a time                                             *
+ * STATS_UNFINISHED: the winner of a game that stopped before it was over or  *
+ *                   broke the rules, next to the values of TicTacTile        *
+ * STATS_RESULTS: the number of different results a game can have             *
+ * STATS_BINS: the number of bars in the game length histogram                *
+ * STATS_OPENING_MOVES: the number of moves that make up an opening           *
+ * STATS_TOP_OPENINGS: the number of openings listed for each variant         *
+ ******************************************************************************/
+#define STATS_BATCH 4096
+#define STATS_UNFINISHED TicTacTotal
+#define STATS_RESULTS ( TicTacTotal + 1 )
+#define STATS_BINS 10
+#define STATS_OPENING_MOVES 3
+#define STATS_TOP_OPENINGS 5
+
+
+
+/******************************************************************************
+ * GameArchive: A struct that holds the games of a set of logs column by      *
+ *              column, so that each pass over the games only reads the       *
+ *              columns it needs, one after another.                          *
+ * Consists of:                                                               *
+ *     numGames - the number of games                                         *
+ *     numMoves - the number of moves, over all games                         *
+ *     gameFirst - for each game, the index of its first move                 *
+ *     gameLength - for each game, its number of moves                        *
+ *     gameVariant - for each game, the index of its settings in variants     *
+ *     gameWinner - for each game, the winner found by replaying it: a        *
+ *                  TicTacTile, TicTacNone for a draw, or STATS_UNFINISHED    *
+ *     moveCell - for each move, the cell it was played on, y * M + x         *
+ *     movePlayer - for each move, the player who made it                     *
+ *     moveGame - for each move, the index of the game it was played in       *
+ *     numVariants - the number of different settings                         *
+ *     variants - the different settings of the games, in the order found     *
+ ******************************************************************************/
+typedef struct
+{
+    long numGames;
+    long numMoves;
+    long *gameFirst;
+    int *gameLength;
+    int *gameVariant;
+    unsigned char *gameWinner;
+    int *moveCell;
+    unsigned char *movePlayer;
+    int *moveGame;
+    int numVariants;
+    Settings *variants;
+} GameArchive;
+
+
+
+/******************************************************************************
+ * VariantStats: A struct that holds the statistics of one variant.           *
+ * Consists of:                                                               *
+ *     games - the number of games                                            *
+ *     moves - the number of moves                                            *
+ *     results - the number of games with each result, indexed by the values  *
+ *               of gameWinner                                                *
+ *     lengths - the number of games in each bar of the length histogram      *
+ *     firstMoves - for each cell, the number of games opened on it           *
+ *     allMoves - for each cell, the number of moves played on it             *
+ *     Both are NULL for a sparse board, which is too big for a count per     *
+ *     cell and gets no heatmaps                                              *
+ ******************************************************************************/
+typedef struct
+{
+    long games;
+    long moves;
+    long results[STATS_RESULTS];
+    long lengths[STATS_BINS];
+    long *firstMoves;
+    long *allMoves;
+} VariantStats;
+
+
+
+/******************************************************************************
+ * Opening: A struct that holds the first moves of a game.                    *
+ * Consists of:                                                               *
+ *     variant - the variant the game was played in                           *
+ *     cells - the cells of the first STATS_OPENING_MOVES moves, -1 for moves *
+ *             the game did not last long enough to make                      *
+ ******************************************************************************/
+typedef struct
+{
+    int variant;
+    int cells[STATS_OPENING_MOVES];
+} Opening;
+
+
+
+/* Function Prototypes */
+BOOL archiveStats( char**, int, int );
+
+#endif
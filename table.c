@@ -0,0 +1,186 @@
+/******************************************************************************
+ * File:---- table.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the transposition table declared in table.h           *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "table.h"
+
+
+/******************************************************************************
+ * Function: createTable                                                      *
+ * Imports: megabytes - the largest size the table may take up                *
+ * Returns: pointer to a new, empty transposition table                       *
+ * Purpose: allocates the largest power of two number of buckets that fits in *
+ *          the given size, so that a bucket is found by masking the key.     *
+ *          The buckets are aligned to a cache line.                          *
+ ******************************************************************************/
+TransTable *createTable( int megabytes )
+{
+    TransTable *table;
+    unsigned long count;
+    void *buckets;
+
+    table = (TransTable*) calloc( sizeof(TransTable), 1 );
+    table->megabytes = megabytes;
+
+    count = 1;
+    while ( count * 2 * sizeof(TableBucket) <= (unsigned long) megabytes << 20 )
+    {
+        count *= 2;
+    }
+
+    buckets = NULL;
+    if ( posix_memalign( &buckets, TABLE_LINE, count * sizeof(TableBucket) ) )
+    {
+        buckets = malloc( count * sizeof(TableBucket) );
+    }
+    table->buckets = (TableBucket*) buckets;
+    table->mask = count - 1;
+    clearTable( table );
+
+    return table;
+}
+
+
+
+/******************************************************************************
+ * Function: deleteTable                                                      *
+ * Imports: pointer to a transposition table                                  *
+ * Exports: none                                                              *
+ * Purpose: frees the memory allocated for the table and its buckets          *
+ ******************************************************************************/
+void deleteTable( TransTable *table )
+{
+    free( table->buckets );
+    free( table );
+}
+
+
+
+/******************************************************************************
+ * Function: clearTable                                                       *
+ * Imports: pointer to a transposition table                                  *
+ * Exports: empties every bucket and resets the counters                      *
+ * Purpose: used when the stored results no longer apply, e.g. when the board *
+ *          size or the value of K changes.                                   *
+ ******************************************************************************/
+void clearTable( TransTable *table )
+{
+    memset( table->buckets, 0, ( table->mask + 1 ) * sizeof(TableBucket) );
+    table->age = 0;
+    table->probes = 0;
+    table->hits = 0;
+}
+
+
+
+/******************************************************************************
+ * Function: tableProbe                                                       *
+ * Imports: pointer to a transposition table, Zobrist key of a position       *
+ * Returns: the entry stored for the key, NULL if there is none               *
+ * Purpose: looks the position up in both entries of its bucket. The caller   *
+ *          decides whether the entry was searched deep enough to be used.    *
+ ******************************************************************************/
+TableEntry *tableProbe( TransTable *table, unsigned long key )
+{
+    TableBucket *bucket;
+    TableEntry *entry;
+    int i;
+
+    bucket = &table->buckets[key & table->mask];
+    entry = NULL;
+    key = TABLE_KEY( key );
+    table->probes++;
+
+    for ( i = 0; i < TABLE_WAYS && entry == NULL; i++ )
+    {
+        if ( bucket->entries[i].key == key )
+        {
+            entry = &bucket->entries[i];
+            table->hits++;
+        }
+    }
+
+    return entry;
+}
+
+
+
+/******************************************************************************
+ * Function: tableStore                                                       *
+ * Imports: pointer to a transposition table, Zobrist key of a position,      *
+ *          depth searched, score, bound of the score, best move              *
+ * Exports: stores the result in the position's bucket                        *
+ * Purpose: depth-preferred replacement. The first entry is only replaced by  *
+ *          the same position, a search at least as deep, or a result from a  *
+ *          newer search; anything else goes into the second entry, which     *
+ *          always takes the newest result. Deep results, which cost the most *
+ *          to work out again, are therefore kept for as long as they are     *
+ *          useful, while shallow ones still get stored.                      *
+ *          A position is never held by both entries: if it moves up from the *
+ *          second entry to the first, the second is emptied.                 *
+ ******************************************************************************/
+void tableStore( TransTable *table, unsigned long key, int depth, long score,
+    TableBound bound, int move )
+{
+    TableBucket *bucket;
+    TableEntry *entry, *second;
+
+    bucket = &table->buckets[key & table->mask];
+    key = TABLE_KEY( key );
+    entry = &bucket->entries[0];
+    second = &bucket->entries[1];
+    if ( entry->key != key && entry->depth > depth &&
+        entry->age == table->age )
+    {
+        entry = second;
+    }
+    else if ( entry->key != key && second->key == key )
+    {
+        if ( move < 0 )
+        {
+            move = second->move;
+        }
+        second->key = 0;
+    }
+
+    /* keep the best move of an earlier search if this one found none */
+    if ( move < 0 && entry->key == key )
+    {
+        move = entry->move;
+    }
+
+    entry->key = key;
+    entry->score = score;
+    entry->move = move;
+    entry->depth = (short) depth;
+    entry->bound = (unsigned char) bound;
+    entry->age = table->age;
+}
+
+
+
+/******************************************************************************
+ * Function: printTableStats                                                  *
+ * Imports: output stream, pointer to a transposition table                   *
+ * Exports: none                                                              *
+ * Purpose: prints the hit rate of the table and the memory it takes up, so   *
+ *          its size can be tuned to the board in the settings file (T=)      *
+ ******************************************************************************/
+void printTableStats( FILE *stream, TransTable *table )
+{
+    fprintf( stream, "Transposition table: %lu entries in %.1f MB, "
+        "%.1f%% of %ld probes hit\n",
+        ( table->mask + 1 ) * TABLE_WAYS,
+        ( table->mask + 1 ) * sizeof(TableBucket) / 1048576.0,
+        table->probes > 0 ? 100.0 * table->hits / table->probes : 0.0,
+        table->probes );
+}
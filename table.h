@@ -0,0 +1,115 @@
+/******************************************************************************
+ * File:---- table.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Defines a transposition table, a fixed-size hash table of        *
+ *           search results keyed on the Zobrist hash of a position, so that  *
+ *           positions reached through different move orders are only         *
+ *           searched once.                                                   *
+ ******************************************************************************/
+
+#ifndef TABLE_H
+#define TABLE_H
+
+#include <stdio.h>
+
+
+/******************************************************************************
+ * TableBound: what the score of an entry tells about the position.           *
+ *     TableExact - the score is exact                                        *
+ *     TableLower - the search failed high, the score is at least this        *
+ *     TableUpper - the search failed low, the score is at most this          *
+ ******************************************************************************/
+typedef enum
+{
+    TableExact,
+    TableLower,
+    TableUpper
+} TableBound;
+
+
+
+/******************************************************************************
+ * TableEntry: A struct that holds the result of searching one position.      *
+ * Consists of:                                                               *
+ *     key - TABLE_KEY of the position's Zobrist hash, 0 if the entry is       *
+ *           empty                                                            *
+ *     score - the score of the position for the player to move               *
+ *     move - the best cell found (y * width + x), -1 if there was none       *
+ *     depth - the depth the position was searched to                         *
+ *     bound - the TableBound of the score                                    *
+ *     age - the search that stored the entry, see TransTable                 *
+ ******************************************************************************/
+typedef struct
+{
+    unsigned long key;
+    long score;
+    int move;
+    short depth;
+    unsigned char bound;
+    unsigned char age;
+} TableEntry;
+
+
+
+/******************************************************************************
+ * TABLE_WAYS: the number of entries in each bucket                           *
+ * TABLE_LINE: the size of a cache line, in bytes                             *
+ * TABLE_KEY: the key stored for a Zobrist hash. The lowest bit is always     *
+ *            set, so that no position, not even the empty board whose hash  *
+ *            is 0, is stored under the key of an empty entry. The bit also   *
+ *            picks the bucket, so entries in one bucket lose nothing by it   *
+ ******************************************************************************/
+#define TABLE_WAYS 2
+#define TABLE_LINE 64
+#define TABLE_KEY( hash ) ( (hash) | 1UL )
+
+
+
+/******************************************************************************
+ * TableBucket: the entries that a key can be stored in, padded to exactly    *
+ *              one cache line so that a probe touches a single line.         *
+ * Consists of:                                                               *
+ *     entries - entries[0] keeps the deepest result, entries[1] the newest   *
+ *     padding - fills the rest of the cache line                             *
+ ******************************************************************************/
+typedef struct
+{
+    TableEntry entries[TABLE_WAYS];
+    char padding[TABLE_LINE - TABLE_WAYS * sizeof(TableEntry)];
+} TableBucket;
+
+
+
+/******************************************************************************
+ * TransTable: A struct that holds a transposition table.                     *
+ * Consists of:                                                               *
+ *     buckets - the buckets of the table, aligned to a cache line            *
+ *     mask - the number of buckets minus one, which is a power of two        *
+ *     megabytes - the size the table was created with                        *
+ *     age - counts up once per search, so that entries left over from older  *
+ *           searches are replaced first                                      *
+ *     probes, hits - the number of lookups and how many found their key      *
+ ******************************************************************************/
+typedef struct
+{
+    TableBucket *buckets;
+    unsigned long mask;
+    int megabytes;
+    unsigned char age;
+    long probes;
+    long hits;
+} TransTable;
+
+
+
+/* Function Prototypes */
+TransTable *createTable( int );
+void deleteTable( TransTable* );
+void clearTable( TransTable* );
+TableEntry *tableProbe( TransTable*, unsigned long );
+void tableStore( TransTable*, unsigned long, int, long, TableBound, int );
+void printTableStats( FILE*, TransTable* );
+
+#endif
@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File:---- timer.c                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the wall-clock timer declared in timer.h              *
+ * Notes:--- clock( ) from the C89 library measures CPU time, which adds up   *
+ *           over all threads, so the POSIX monotonic clock is used instead.  *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <time.h>
+
+#include "timer.h"
+
+
+/******************************************************************************
+ * Function: wallTime                                                         *
+ * Imports: none                                                              *
+ * Returns: the number of seconds elapsed since an arbitrary fixed point      *
+ * Purpose: used to time sections of code by taking the difference between    *
+ *          two calls.                                                        *
+ ******************************************************************************/
+double wallTime( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (double) now.tv_sec + (double) now.tv_nsec / 1.0e9;
+}
@@ -0,0 +1,16 @@
+/******************************************************************************
+ * File:---- timer.h                                                          *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Declares a wall-clock timer used to measure throughput of the    *
+ *           headless game modes.                                             *
+ ******************************************************************************/
+
+#ifndef TIMER_H
+#define TIMER_H
+
+/* Function Prototypes */
+double wallTime( void );
+
+#endif
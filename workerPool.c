@@ -0,0 +1,62 @@
+/******************************************************************************
+ * File:---- workerPool.c                                                     *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Implements the fan-out of a pass over a number of worker         *
+ *           threads, declared in workerPool.h                                *
+ ******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "workerPool.h"
+
+
+/******************************************************************************
+ * Function: runWorkers                                                       *
+ * Imports: workers - an array of one worker struct per thread                *
+ *          workerSize - the size of each worker struct, 0 if every thread    *
+ *                       is given the same one                                *
+ *          numThreads - the number of threads                                *
+ *          body - the function each thread runs                              *
+ * Exports: none                                                              *
+ * Purpose: runs body on every worker at once and waits for all of them. The  *
+ *          first worker runs on the calling thread.                          *
+ *          If a thread cannot be started, its worker is run on the calling   *
+ *          thread once the first one is done. Every worker shares its work   *
+ *          out through a counter or has a fixed share of its own, so the     *
+ *          pass still does all of its work, only with fewer threads.         *
+ ******************************************************************************/
+void runWorkers( void *workers, size_t workerSize, int numThreads,
+    WorkerFunc body )
+{
+    pthread_t *threads;
+    char *started;
+    int i;
+
+    threads = (pthread_t*) malloc( numThreads * sizeof(pthread_t) );
+    started = (char*) malloc( numThreads );
+    for ( i = 1; i < numThreads; i++ )
+    {
+        started[i] = pthread_create( &threads[i], NULL, body,
+            (char*) workers + i * workerSize ) == 0;
+    }
+    body( workers );
+
+    for ( i = 1; i < numThreads; i++ )
+    {
+        if ( started[i] )
+        {
+            pthread_join( threads[i], NULL );
+        }
+        else
+        {
+            body( (char*) workers + i * workerSize );
+        }
+    }
+    free( started );
+    free( threads );
+}
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * File:---- workerPool.h                                                     *
+ * Author:-- Anton R                                                          *
+ * Created:- 16/10/2026                                                       *
+ * Modified: 16/10/2026                                                       *
+ * Purpose:- Declares the function that every multi-threaded pass of the      *
+ *           program (simulations, the mcts search, --verify and --stats)     *
+ *           runs its worker threads with.                                    *
+ ******************************************************************************/
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <stddef.h>
+
+
+/******************************************************************************
+ * WorkerFunc: type definition for the body of a worker thread, which is      *
+ *     given a pointer to its own worker struct.                              *
+ ******************************************************************************/
+typedef void *( *WorkerFunc )( void* );
+
+
+
+/* Function Prototypes */
+void runWorkers( void*, size_t, int, WorkerFunc );
+
+#endif